@@ -32,7 +32,7 @@ extern "C" {
 #endif
 
 #ifdef MODULE_MTD
-#include "mtd_native.h"
+#include "mtd.h"
 #endif
 
 /**
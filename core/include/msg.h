@@ -272,6 +272,49 @@ int msg_send_to_self(msg_t *m);
  */
 int msg_send_int(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Queue a message without waking up the receiver.
+ *
+ * The message is put into the message queue of the target thread, but the
+ * target is only woken up once its queue holds at least @p threshold
+ * messages, or when msg_flush() is called. This saves context switches when
+ * sending many messages to a thread with a lower priority, which can then
+ * handle them in one go using msg_receive_bulk(). If the queue is full, the
+ * target is woken up and the message is not sent.
+ *
+ * Can be called from threads and ISRs.
+ *
+ * @note    A message sent with msg_send() to a thread waiting in
+ *          msg_receive() may overtake messages that are still deferred. Call
+ *          msg_flush() first if the order matters.
+ *
+ * @param[in] m             Pointer to preallocated @ref msg_t structure, must
+ *                          not be NULL.
+ * @param[in] target_pid    PID of target thread, the thread must have a
+ *                          message queue.
+ * @param[in] threshold     Number of queued messages to wake up the target
+ *                          thread at. 1 wakes it up right away.
+ *
+ * @return 1, if the message was queued
+ * @return 0, if the message queue of the target is full (or there is none)
+ * @return -1, on error (invalid PID)
+ */
+int msg_send_deferred(msg_t *m, kernel_pid_t target_pid, unsigned threshold);
+
+/**
+ * @brief Wake up a thread waiting for messages queued by
+ *        msg_send_deferred().
+ *
+ * Does nothing if no message is queued for the target thread or if it isn't
+ * waiting for messages.
+ *
+ * @param[in] target_pid    PID of target thread.
+ *
+ * @return 0, on success
+ * @return -1, on error (invalid PID)
+ */
+int msg_flush(kernel_pid_t target_pid);
+
 /**
  * @brief Test if the message was sent inside an ISR.
  * @see msg_send_int()
@@ -309,6 +352,23 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive up to @p n messages at once.
+ *
+ * Takes all messages that are queued (and the messages of blocked senders),
+ * up to @p n, in one critical section. Like msg_receive(), senders blocked on
+ * the full queue are moved into the freed queue space and unblocked, so the
+ * messages are received in the order they were sent. Blocks like
+ * msg_receive() if there is no message.
+ *
+ * @param[out] m    Array of at least @p n preallocated ``msg_t`` structures,
+ *                  must not be NULL.
+ * @param[in] n     Maximum number of messages to receive, must be > 0.
+ *
+ * @return  Number of messages received, at least 1.
+ */
+int msg_receive_bulk(msg_t *m, unsigned n);
+
 /**
  * @brief Send a message, block until reply received.
  *
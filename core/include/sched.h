@@ -211,6 +211,14 @@ NORETURN void sched_task_exit(void);
  *  @param[in] callback The callback functions the will be called
  */
 void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t));
+
+/**
+ *  @brief  Register a callback that will be called whenever a thread is added
+ *          to a run queue, i.e. becomes ready to run
+ *
+ *  @param[in] callback The callback functions the will be called
+ */
+void sched_register_runnable_cb(void (*callback)(kernel_pid_t));
 #endif /* MODULE_SCHED_CB */
 
 #ifdef __cplusplus
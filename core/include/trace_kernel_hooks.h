@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_internal
+ * @{
+ *
+ * @file
+ * @brief       Hooks of the kernel event tracer
+ *
+ * The kernel and the CPU implementations record events through these hooks.
+ * They compile to nothing unless the module `trace_kernel` is used, see
+ * @ref sys_trace_kernel for the API to control the tracer and to read the
+ * events.
+ */
+#ifndef TRACE_KERNEL_HOOKS_H
+#define TRACE_KERNEL_HOOKS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Event types
+ */
+typedef enum {
+    /**
+     * @brief   Context switch
+     *
+     * trace_kernel_event_t::pid is the thread switched away from,
+     * trace_kernel_event_t::arg the thread switched to.
+     */
+    TRACE_KERNEL_SCHED = 0,
+    /**
+     * @brief   ISR entry, trace_kernel_event_t::arg is the IRQ number
+     */
+    TRACE_KERNEL_ISR_ENTER,
+    /**
+     * @brief   ISR exit, trace_kernel_event_t::arg is the IRQ number
+     */
+    TRACE_KERNEL_ISR_EXIT,
+    /**
+     * @brief   Message sent or replied
+     *
+     * trace_kernel_event_t::arg is the receiver,
+     * trace_kernel_event_t::arg16 the message type.
+     */
+    TRACE_KERNEL_MSG_SEND,
+    /**
+     * @brief   Message received
+     *
+     * trace_kernel_event_t::arg is the sender,
+     * trace_kernel_event_t::arg16 the message type.
+     */
+    TRACE_KERNEL_MSG_RECV,
+    /**
+     * @brief   Thread blocks on a locked mutex, trace_kernel_event_t::arg is
+     *          the address of the mutex
+     */
+    TRACE_KERNEL_MUTEX_WAIT,
+    /**
+     * @brief   Thread acquired a mutex, trace_kernel_event_t::arg is the
+     *          address of the mutex
+     */
+    TRACE_KERNEL_MUTEX_LOCK,
+    /**
+     * @brief   Thread released a mutex, trace_kernel_event_t::arg is the
+     *          address of the mutex
+     */
+    TRACE_KERNEL_MUTEX_UNLOCK,
+    TRACE_KERNEL_NUMOF,             /**< number of event types */
+} trace_kernel_type_t;
+
+#if defined(MODULE_TRACE_KERNEL) || defined(DOXYGEN)
+/**
+ * @brief   Tracing is running
+ *
+ * @internal    Use @ref trace_kernel_start() and @ref trace_kernel_stop()
+ */
+extern volatile bool trace_kernel_running;
+
+/**
+ * @brief   Records an event unconditionally
+ *
+ * @internal    Use @ref trace_kernel_record()
+ */
+void trace_kernel_record_event(trace_kernel_type_t type, uint16_t arg16,
+                               uint32_t arg);
+
+/**
+ * @brief   Records an event if tracing is running
+ *
+ * @param[in] type      Type of the event.
+ * @param[in] arg16     Type-specific argument.
+ * @param[in] arg       Type-specific argument.
+ */
+static inline void trace_kernel_record(trace_kernel_type_t type,
+                                       uint16_t arg16, uint32_t arg)
+{
+    if (trace_kernel_running) {
+        trace_kernel_record_event(type, arg16, arg);
+    }
+}
+#else   /* MODULE_TRACE_KERNEL */
+static inline void trace_kernel_record(trace_kernel_type_t type,
+                                       uint16_t arg16, uint32_t arg)
+{
+    (void)type;
+    (void)arg16;
+    (void)arg;
+}
+#endif  /* MODULE_TRACE_KERNEL */
+
+/**
+ * @brief   Records ISR entry
+ *
+ * To be called by CPU implementations before an interrupt handler is run.
+ *
+ * @param[in] irq   Number of the interrupt.
+ */
+static inline void trace_kernel_isr_enter(unsigned irq)
+{
+    trace_kernel_record(TRACE_KERNEL_ISR_ENTER, 0, irq);
+}
+
+/**
+ * @brief   Records ISR exit
+ *
+ * To be called by CPU implementations after an interrupt handler returned.
+ *
+ * @param[in] irq   Number of the interrupt.
+ */
+static inline void trace_kernel_isr_exit(unsigned irq)
+{
+    trace_kernel_record(TRACE_KERNEL_ISR_EXIT, 0, irq);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_KERNEL_HOOKS_H */
+/** @} */
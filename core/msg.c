@@ -32,6 +32,7 @@
 #endif
 #include "irq.h"
 #include "cib.h"
+#include "trace_kernel_hooks.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -39,7 +40,7 @@
 static int _msg_receive(msg_t *m, int block);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
 
-static int queue_msg(thread_t *target, const msg_t *m)
+static int queue_msg_nowake(thread_t *target, const msg_t *m)
 {
     int n = cib_put(&(target->msg_queue));
     if (n < 0) {
@@ -50,6 +51,14 @@ static int queue_msg(thread_t *target, const msg_t *m)
     DEBUG("queue_msg(): queuing message\n");
     msg_t *dest = &target->msg_array[n];
     *dest = *m;
+    return 1;
+}
+
+static int queue_msg(thread_t *target, const msg_t *m)
+{
+    if (!queue_msg_nowake(target, m)) {
+        return 0;
+    }
 #if MODULE_CORE_THREAD_FLAGS
     target->flags |= THREAD_FLAG_MSG_WAITING;
     thread_flags_wake(target);
@@ -99,6 +108,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
 
     thread_t *me = (thread_t *) sched_active_thread;
 
+    trace_kernel_record(TRACE_KERNEL_MSG_SEND, m->type, target_pid);
+
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
           ". block=%i src->state=%i target->state=%i\n", RIOT_FILE_RELATIVE,
           __LINE__, sched_active_pid, target_pid,
@@ -164,8 +175,11 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         *target_message = *m;
         sched_set_status(target, STATUS_PENDING);
 
+        /* only switch if the receiver has a higher priority or this thread
+         * is waiting for a reply */
+        uint16_t target_prio = target->priority;
         irq_restore(state);
-        thread_yield_higher();
+        sched_switch(target_prio);
     }
 
     return 1;
@@ -198,6 +212,7 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 
     m->sender_pid = KERNEL_PID_ISR;
+    trace_kernel_record(TRACE_KERNEL_MSG_SEND, m->type, target_pid);
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("msg_send_int: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", thread_getpid(), target_pid);
@@ -217,6 +232,81 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 }
 
+/* Wakes up a thread that has messages queued, but is waiting for them.
+ * Must be called with interrupts disabled. Returns the priority to switch
+ * to, THREAD_PRIORITY_IDLE if no thread was woken up. */
+static uint16_t _wake_receiver(thread_t *target)
+{
+    if (target->status == STATUS_RECEIVE_BLOCKED) {
+        int n = cib_get(&(target->msg_queue));
+        if (n >= 0) {
+            /* hand the oldest queued message to the blocked receiver */
+            msg_t *target_message = (msg_t *)target->wait_data;
+            *target_message = target->msg_array[n];
+            sched_set_status(target, STATUS_PENDING);
+            return target->priority;
+        }
+    }
+#if MODULE_CORE_THREAD_FLAGS
+    else if (cib_avail(&(target->msg_queue)) > 0) {
+        target->flags |= THREAD_FLAG_MSG_WAITING;
+        if (thread_flags_wake(target)) {
+            return target->priority;
+        }
+    }
+#endif
+    return THREAD_PRIORITY_IDLE;
+}
+
+int msg_send_deferred(msg_t *m, kernel_pid_t target_pid, unsigned threshold)
+{
+    assert(pid_is_valid(target_pid));
+
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    if (target == NULL) {
+        DEBUG("msg_send_deferred(): target thread does not exist\n");
+        return -1;
+    }
+
+    m->sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    trace_kernel_record(TRACE_KERNEL_MSG_SEND, m->type, target_pid);
+
+    uint16_t prio = THREAD_PRIORITY_IDLE;
+    unsigned state = irq_disable();
+    int res = queue_msg_nowake(target, m);
+    if (!res || (cib_avail(&(target->msg_queue)) >= threshold)) {
+        prio = _wake_receiver(target);
+    }
+    irq_restore(state);
+
+    if (prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(prio);
+    }
+    return res;
+}
+
+int msg_flush(kernel_pid_t target_pid)
+{
+    assert(pid_is_valid(target_pid));
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    if (target == NULL) {
+        irq_restore(state);
+        return -1;
+    }
+
+    uint16_t prio = _wake_receiver(target);
+    irq_restore(state);
+
+    if (prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(prio);
+    }
+    return 0;
+}
+
 int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
 {
     assert(sched_active_pid != target_pid);
@@ -248,6 +338,7 @@ int msg_reply(msg_t *m, msg_t *reply)
 
     DEBUG("msg_reply(): %" PRIkernel_pid ": Direct msg copy.\n",
           sched_active_thread->pid);
+    trace_kernel_record(TRACE_KERNEL_MSG_SEND, reply->type, target->pid);
     /* copy msg to target */
     msg_t *target_message = (msg_t*) target->wait_data;
     *target_message = *reply;
@@ -269,6 +360,7 @@ int msg_reply_int(msg_t *m, msg_t *reply)
         return -1;
     }
 
+    trace_kernel_record(TRACE_KERNEL_MSG_SEND, reply->type, target->pid);
     msg_t *target_message = (msg_t*) target->wait_data;
     *target_message = *reply;
     sched_set_status(target, STATUS_PENDING);
@@ -278,12 +370,89 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    int res = _msg_receive(m, 0);
+
+    if (res > 0) {
+        trace_kernel_record(TRACE_KERNEL_MSG_RECV, m->type, m->sender_pid);
+    }
+    return res;
 }
 
 int msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    int res = _msg_receive(m, 1);
+
+    trace_kernel_record(TRACE_KERNEL_MSG_RECV, m->type, m->sender_pid);
+    return res;
+}
+
+/* takes the message of the first blocked sender and unblocks it, IRQs must
+ * be disabled */
+static int _take_waiter(thread_t *me, msg_t *m, uint16_t *sender_prio)
+{
+    list_node_t *next = list_remove_head(&me->msg_waiters);
+
+    if (next == NULL) {
+        return 0;
+    }
+
+    thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+    *m = *((msg_t *)sender->wait_data);
+    if (sender->status != STATUS_REPLY_BLOCKED) {
+        sender->wait_data = NULL;
+        sched_set_status(sender, STATUS_PENDING);
+        if (sender->priority < *sender_prio) {
+            *sender_prio = sender->priority;
+        }
+    }
+    return 1;
+}
+
+int msg_receive_bulk(msg_t *m, unsigned n)
+{
+    assert(n > 0);
+
+    thread_t *me = (thread_t *) sched_active_thread;
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned count = 0;
+
+    unsigned state = irq_disable();
+    while (count < n) {
+        int queue_index = -1;
+
+        if (thread_has_msg_queue(me)) {
+            queue_index = cib_get(&(me->msg_queue));
+        }
+        if (queue_index >= 0) {
+            m[count++] = me->msg_array[queue_index];
+            /* senders only block if the queue is full, so their messages
+             * are newer than the queued ones: move the first one into the
+             * just freed queue space, like _msg_receive() does */
+            if (me->msg_waiters.next) {
+                int slot = cib_put(&(me->msg_queue));
+                _take_waiter(me, &me->msg_array[slot], &sender_prio);
+            }
+        }
+        else if (_take_waiter(me, &m[count], &sender_prio)) {
+            count++;
+        }
+        else {
+            break;
+        }
+    }
+    irq_restore(state);
+
+    if (count == 0) {
+        return msg_receive(m);
+    }
+
+    for (unsigned i = 0; i < count; i++) {
+        trace_kernel_record(TRACE_KERNEL_MSG_RECV, m[i].type, m[i].sender_pid);
+    }
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return count;
 }
 
 static int _msg_receive(msg_t *m, int block)
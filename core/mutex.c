@@ -28,6 +28,7 @@
 #include "sched.h"
 #include "irq.h"
 #include "list.h"
+#include "trace_kernel_hooks.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -44,12 +45,14 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
+        trace_kernel_record(TRACE_KERNEL_MUTEX_LOCK, 0, (uintptr_t)mutex);
         return 1;
     }
     else if (blocking) {
         thread_t *me = (thread_t*)sched_active_thread;
         DEBUG("PID[%" PRIkernel_pid "]: Adding node to mutex queue: prio: %"
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
+        trace_kernel_record(TRACE_KERNEL_MUTEX_WAIT, 0, (uintptr_t)mutex);
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = (list_node_t*)&me->rq_entry;
@@ -62,6 +65,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
          * We have the mutex now. */
+        trace_kernel_record(TRACE_KERNEL_MUTEX_LOCK, 0, (uintptr_t)mutex);
         return 1;
     }
     else {
@@ -76,6 +80,7 @@ void mutex_unlock(mutex_t *mutex)
 
     DEBUG("mutex_unlock(): queue.next: %p pid: %" PRIkernel_pid "\n",
           (void *)mutex->queue.next, sched_active_pid);
+    trace_kernel_record(TRACE_KERNEL_MUTEX_UNLOCK, 0, (uintptr_t)mutex);
 
     if (mutex->queue.next == NULL) {
         /* the mutex was not locked */
@@ -113,6 +118,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
           "taking a nap\n", sched_active_pid, (void *)mutex->queue.next);
     unsigned irqstate = irq_disable();
 
+    trace_kernel_record(TRACE_KERNEL_MUTEX_UNLOCK, 0, (uintptr_t)mutex);
     if (mutex->queue.next) {
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
@@ -27,6 +27,7 @@
 #include "irq.h"
 #include "thread.h"
 #include "log.h"
+#include "trace_kernel_hooks.h"
 
 #ifdef MODULE_MPU_STACK_GUARD
 #include "mpu.h"
@@ -71,6 +72,7 @@ const uint8_t _tcb_name_offset = offsetof(thread_t, name);
 
 #ifdef MODULE_SCHED_CB
 static void (*sched_cb) (kernel_pid_t active_thread, kernel_pid_t next_thread) = NULL;
+static void (*sched_runnable_cb) (kernel_pid_t pid) = NULL;
 #endif
 
 int __attribute__((used)) sched_run(void)
@@ -115,6 +117,8 @@ int __attribute__((used)) sched_run(void)
     }
 #endif
 
+    trace_kernel_record(TRACE_KERNEL_SCHED, 0, next_thread->pid);
+
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *) next_thread;
@@ -142,6 +146,11 @@ void sched_set_status(thread_t *process, thread_status_t status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHED_CB
+            if (sched_runnable_cb) {
+                sched_runnable_cb(process->pid);
+            }
+#endif
         }
     }
     else {
@@ -203,4 +212,9 @@ void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t))
 {
     sched_cb = callback;
 }
+
+void sched_register_runnable_cb(void (*callback)(kernel_pid_t))
+{
+    sched_runnable_cb = callback;
+}
 #endif
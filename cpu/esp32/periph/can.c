@@ -204,11 +204,18 @@ static void _esp_can_isr(candev_t *candev)
         dev->events &= ~ESP_CAN_EVENT_RX_INDICATION;
 
         while (dev->rx_frames_num) {
+            /* hand over all frames up to the end of the ring buffer at once */
+            candev_rx_batch_t batch = {
+                .frames = &dev->rx_frames[dev->rx_frames_rptr],
+                .count = ESP_CAN_MAX_RX_FRAMES - dev->rx_frames_rptr,
+            };
+            if (batch.count > dev->rx_frames_num) {
+                batch.count = dev->rx_frames_num;
+            }
             dev->candev.event_callback(&dev->candev,
-                                       CANDEV_EVENT_RX_INDICATION,
-                                       &dev->rx_frames[dev->rx_frames_rptr]);
-            dev->rx_frames_num--;
-            dev->rx_frames_rptr++;
+                                       CANDEV_EVENT_RX_BATCH, &batch);
+            dev->rx_frames_num -= batch.count;
+            dev->rx_frames_rptr += batch.count;
             dev->rx_frames_rptr &= ESP_CAN_MAX_RX_FRAMES-1;
         }
     }
@@ -221,10 +221,20 @@ static int _send(candev_t *candev, const struct can_frame *frame)
     return 0;
 }
 
+static void _rx_indication(candev_linux_t *dev, candev_rx_batch_t *batch)
+{
+    if (batch->count && dev->candev.event_callback) {
+        DEBUG("candev_native _isr: calling event callback, %u frames\n",
+              batch->count);
+        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_BATCH, batch);
+    }
+}
+
 static void _isr(candev_t *candev)
 {
-    int nbytes;
-    struct can_frame rcv_frame;
+    int nbytes = -1;
+    struct can_frame frames[CANDEV_LINUX_RX_BATCH];
+    candev_rx_batch_t batch = { .frames = frames, .count = 0 };
     candev_linux_t *dev = (candev_linux_t *)candev;
 
     if (dev == NULL) {
@@ -232,37 +242,50 @@ static void _isr(candev_t *candev)
     }
 
     DEBUG("candev_native _isr: CAN SIGIO interrupt received, sock = %i\n", dev->sock);
-    nbytes = real_read(dev->sock, &rcv_frame, sizeof(struct can_frame));
+    /* a single SIGIO may stand for several frames, so read up to a batch of
+     * them from the non-blocking socket */
+    for (unsigned i = 0; i < CANDEV_LINUX_RX_BATCH; i++) {
+        struct can_frame *rcv_frame = &frames[batch.count];
 
-    if (nbytes < 0) {   /* SIGIO signal was probably due to an error with the socket */
-        DEBUG("candev_native _isr: read: error during read\n");
-        return;
-    }
+        nbytes = real_read(dev->sock, rcv_frame, sizeof(struct can_frame));
 
-    if (nbytes < (int)sizeof(struct can_frame)) {
-        DEBUG("candev_native _isr: read: incomplete CAN frame\n");
-        return;
-    }
+        if (nbytes < 0) {   /* drained, or SIGIO was due to an error with the socket */
+            DEBUG("candev_native _isr: read: no more frames\n");
+            break;
+        }
 
-    if (rcv_frame.can_id & CAN_ERR_FLAG) {
-        DEBUG("candev_native _isr: error frame\n");
-        candev_event_t evt = _can_error_to_can_evt(rcv_frame);
-        if ((evt != CANDEV_EVENT_NOEVENT) && (dev->candev.event_callback)) {
-            dev->candev.event_callback(&dev->candev, evt, NULL);
+        if (nbytes < (int)sizeof(struct can_frame)) {
+            DEBUG("candev_native _isr: read: incomplete CAN frame\n");
+            continue;
         }
-        return;
-    }
 
-    if (rcv_frame.can_id & CAN_RTR_FLAG) {
-        DEBUG("candev_native _isr: rtr frame\n");
-        return;
-    }
+        if (rcv_frame->can_id & CAN_ERR_FLAG) {
+            DEBUG("candev_native _isr: error frame\n");
+            candev_event_t evt = _can_error_to_can_evt(*rcv_frame);
+            if ((evt != CANDEV_EVENT_NOEVENT) && (dev->candev.event_callback)) {
+                /* keep the order of the frames received before the error */
+                _rx_indication(dev, &batch);
+                batch.count = 0;
+                dev->candev.event_callback(&dev->candev, evt, NULL);
+            }
+            continue;
+        }
 
-    if (dev->candev.event_callback) {
-        DEBUG("candev_native _isr: calling event callback\n");
-        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_INDICATION, &rcv_frame);
+        if (rcv_frame->can_id & CAN_RTR_FLAG) {
+            DEBUG("candev_native _isr: rtr frame\n");
+            continue;
+        }
+
+        batch.count++;
     }
 
+    _rx_indication(dev, &batch);
+
+    if ((nbytes >= 0) && dev->candev.event_callback) {
+        /* there may be more frames, come back after the pending messages of
+         * the device thread, e.g. frames to send, have been handled */
+        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_ISR, NULL);
+    }
 }
 
 static int _set_bittiming(candev_linux_t *dev, struct can_bittiming *bittiming)
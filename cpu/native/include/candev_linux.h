@@ -54,6 +54,13 @@ typedef struct candev_linux_conf {
 #define CANDEV_LINUX_MAX_FILTERS_RX  (16)
 #endif
 
+#ifndef CANDEV_LINUX_RX_BATCH
+/**
+ * Max number of frames read from the socket per interrupt
+ */
+#define CANDEV_LINUX_RX_BATCH        (16)
+#endif
+
 #ifndef CANDEV_LINUX_DEFAULT_BITRATE
 /**
  * Default bitrate setup
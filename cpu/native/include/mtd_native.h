@@ -26,10 +26,49 @@ extern "C" {
 
 #include "mtd.h"
 
+/**
+ * @brief   Emulated duration of a page program in µs
+ *
+ * Applied to each write, 0 disables the emulation. Allows testing and
+ * benchmarking code that depends on the flash being slow, e.g. users of
+ * the `mtd_async` API. Only one request can be pending per device at a
+ * time, further requests are rejected with -EBUSY.
+ *
+ * Set it with the make variable of the same name, which also pulls in
+ * `xtimer` for the emulation if needed.
+ */
+#ifndef MTD_NATIVE_WRITE_LATENCY_US
+#define MTD_NATIVE_WRITE_LATENCY_US     (0)
+#endif
+
+/**
+ * @brief   Emulated duration of a sector erase in µs
+ *
+ * Applied to each erased sector, 0 disables the emulation.
+ */
+#ifndef MTD_NATIVE_ERASE_LATENCY_US
+#define MTD_NATIVE_ERASE_LATENCY_US     (0)
+#endif
+
+/**
+ * @brief   The latencies are emulated
+ */
+#define MTD_NATIVE_LATENCY  (MTD_NATIVE_WRITE_LATENCY_US || \
+                             MTD_NATIVE_ERASE_LATENCY_US)
+
+#if MTD_NATIVE_LATENCY || defined(DOXYGEN)
+#include "xtimer.h"
+#endif
+
 /** mtd native descriptor */
 typedef struct mtd_native_dev {
     mtd_dev_t dev;      /**< mtd generic device */
     const char *fname;  /**< filename to use for memory emulation */
+#if (defined(MODULE_MTD_ASYNC) && MTD_NATIVE_LATENCY) || defined(DOXYGEN)
+    xtimer_t timer;         /**< emulates the ready interrupt */
+    mtd_async_t *pending;   /**< request waiting for the timer */
+    int pending_res;        /**< result of the pending request */
+#endif
 } mtd_native_dev_t;
 
 /**
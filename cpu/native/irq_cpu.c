@@ -39,6 +39,10 @@
 #include "periph/pm.h"
 
 #include "native_internal.h"
+#include "trace_kernel_hooks.h"
+#ifdef MODULE_SCHEDSTATISTICS
+#include "schedstatistics.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -260,7 +264,15 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+            trace_kernel_isr_enter(sig);
+#ifdef MODULE_SCHEDSTATISTICS
+            schedstat_isr_enter();
+#endif
             native_irq_handlers[sig]();
+#ifdef MODULE_SCHEDSTATISTICS
+            schedstat_isr_exit();
+#endif
+            trace_kernel_isr_exit(sig);
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
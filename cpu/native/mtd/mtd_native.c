@@ -75,7 +75,8 @@ static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
     return size;
 }
 
-static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+static int _write_file(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                       uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
     size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
@@ -104,7 +105,7 @@ static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size
     return size;
 }
 
-static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+static int _erase_file(mtd_dev_t *dev, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
     size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
@@ -132,6 +133,87 @@ static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
     return 0;
 }
 
+static inline uint32_t _erase_latency(mtd_dev_t *dev, uint32_t size)
+{
+    return MTD_NATIVE_ERASE_LATENCY_US *
+           (size / (dev->pages_per_sector * dev->page_size));
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    int res = _write_file(dev, buff, addr, size);
+
+#if MTD_NATIVE_WRITE_LATENCY_US
+    if (res >= 0) {
+        xtimer_usleep(MTD_NATIVE_WRITE_LATENCY_US);
+    }
+#endif
+    return res;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    int res = _erase_file(dev, addr, size);
+
+#if MTD_NATIVE_ERASE_LATENCY_US
+    if (res == 0) {
+        xtimer_usleep(_erase_latency(dev, size));
+    }
+#endif
+    return res;
+}
+
+#if defined(MODULE_MTD_ASYNC) && MTD_NATIVE_LATENCY
+/* emulates the ready interrupt of the device */
+static void _async_done(void *arg)
+{
+    mtd_native_dev_t *_dev = arg;
+    mtd_async_t *req = _dev->pending;
+
+    _dev->pending = NULL;
+    mtd_async_complete(req, _dev->pending_res);
+}
+
+static int _submit(mtd_dev_t *dev, mtd_async_t *req)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    uint32_t latency = 0;
+    int res;
+
+    if (_dev->pending) {
+        return -EBUSY;
+    }
+
+    /* the file is accessed right away, only the completion is delayed */
+    switch (req->op) {
+        case MTD_ASYNC_READ:
+            res = _read(dev, req->buf, req->addr, req->count);
+            break;
+        case MTD_ASYNC_WRITE:
+            res = _write_file(dev, req->buf, req->addr, req->count);
+            latency = MTD_NATIVE_WRITE_LATENCY_US;
+            break;
+        default:
+            res = _erase_file(dev, req->addr, req->count);
+            latency = _erase_latency(dev, req->count);
+            break;
+    }
+
+    if ((res < 0) || (latency == 0)) {
+        mtd_async_complete(req, res);
+        return 0;
+    }
+
+    _dev->pending = req;
+    _dev->pending_res = res;
+    _dev->timer.callback = _async_done;
+    _dev->timer.arg = _dev;
+    xtimer_set(&_dev->timer, latency);
+
+    return 0;
+}
+#endif
+
 static int _power(mtd_dev_t *dev, enum mtd_power_state power)
 {
     (void) dev;
@@ -147,6 +229,9 @@ const mtd_desc_t native_flash_driver = {
     .write = _write,
     .erase = _erase,
     .init = _init,
+#if defined(MODULE_MTD_ASYNC) && MTD_NATIVE_LATENCY
+    .submit = _submit,
+#endif
 };
 
 /** @} */
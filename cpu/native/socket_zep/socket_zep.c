@@ -26,7 +26,7 @@
 
 #include "async_read.h"
 #include "byteorder.h"
-#include "checksum/ucrc16.h"
+#include "checksum/crc16_ccitt.h"
 #include "native_internal.h"
 #include "random.h"
 
@@ -89,8 +89,9 @@ static size_t _prep_vector(socket_zep_t *dev, const iolist_t *iolist,
         /* discard const qualifier, we won't change anything. Promise! */
         out[i + 1].iov_base = iolist->iol_base;
         out[i + 1].iov_len = iolist->iol_len;
-        dev->chksum_buf = ucrc16_calc_le(out[i + 1].iov_base, out[i + 1].iov_len,
-                                         UCRC16_CCITT_POLY_LE, dev->chksum_buf);
+        dev->chksum_buf = crc16_ccitt_le_update(dev->chksum_buf,
+                                                out[i + 1].iov_base,
+                                                out[i + 1].iov_len);
         iolist = iolist->iol_next;
     }
     dev->chksum_buf = byteorder_btols(byteorder_htons(dev->chksum_buf)).u16;
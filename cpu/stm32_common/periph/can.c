@@ -1091,14 +1091,23 @@ static void rx_isr(can_t *dev)
 
     while (dev->rx_fifo.is_full || dev->rx_fifo.read_idx != dev->rx_fifo.write_idx) {
         int i = dev->rx_fifo.read_idx;
+        int end = dev->rx_fifo.write_idx;
+
+        /* hand over all frames up to the end of the fifo at once */
+        if (end <= i) {
+            end = CAN_STM32_RX_MAIL_FIFO;
+        }
 
         if (dev->candev.event_callback) {
+            candev_rx_batch_t batch = {
+                .frames = &dev->rx_fifo.frame[i],
+                .count = end - i,
+            };
             dev->candev.event_callback(&dev->candev,
-                                       CANDEV_EVENT_RX_INDICATION,
-                                       &dev->rx_fifo.frame[i]);
+                                       CANDEV_EVENT_RX_BATCH, &batch);
         }
 
-        dev->rx_fifo.read_idx++;
+        dev->rx_fifo.read_idx = end;
         if (dev->rx_fifo.read_idx == CAN_STM32_RX_MAIL_FIFO) {
             dev->rx_fifo.read_idx = 0;
         }
@@ -21,6 +21,12 @@ from .utils import test_utils_interactive_sync # noqa, F401 expose to users
 # default value (10)
 TIMEOUT = int(os.environ.get('RIOT_TEST_TIMEOUT') or 10)
 
+# Matches the line printed by benchmark_result_print() of the benchmark
+# module, fill in the name of the benchmark (as a regular expression) with
+# BENCHMARK_REGEXP.format(func=...)
+BENCHMARK_REGEXP = r"{{\"benchmark\": \"{func}\", \"runs\": \d+, " \
+                   r"\"samples\": \d+, \"unit\": \"ns\"(, \"\w+\": \d+){{6}}}}"
+
 
 def run(testfunc, timeout=TIMEOUT, echo=True, traceback=False):
     child = setup_child(timeout, env=os.environ,
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Runs benchmark applications and compares them against a baseline
+
+Each application is built and run (on `native` by default) until it prints
+the end marker or the timeout expires. All lines printed by
+`benchmark_result_print()` are collected and the median time per call is
+compared against the baseline file. The script fails if a benchmark got
+slower than the baseline by more than the threshold.
+
+Usage:
+
+    # record a baseline
+    benchmark.py --update tests/bench_runtime_coreapis tests/bench_msg_pingpong
+    # compare against it
+    benchmark.py tests/bench_runtime_coreapis tests/bench_msg_pingpong
+"""
+
+import argparse
+import json
+import os
+import select
+import signal
+import subprocess
+import sys
+import time
+
+RIOTBASE = os.path.abspath(os.path.join(os.path.dirname(__file__),
+                                        "..", "..", ".."))
+DEFAULT_BASELINE = os.path.join(RIOTBASE, "dist", "tools", "benchmark",
+                                "baseline-{board}.json")
+END_MARKERS = ("SUCCESS", "[SUCCESS]")
+
+
+def run_app(app, board, timeout):
+    """builds and runs app, returns the parsed benchmark results"""
+    env = dict(os.environ, BOARD=board)
+    subprocess.run(["make", "-C", app, "all"], env=env, check=True,
+                   stdout=subprocess.DEVNULL)
+    proc = subprocess.Popen(["make", "-C", app, "term"], env=env,
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            start_new_session=True)
+    results = {}
+    deadline = time.monotonic() + timeout
+    buf = b""
+    try:
+        while time.monotonic() < deadline:
+            ready, _, _ = select.select([proc.stdout], [], [],
+                                        deadline - time.monotonic())
+            if not ready:
+                break
+            data = os.read(proc.stdout.fileno(), 4096)
+            if not data:
+                break
+            buf += data
+            *lines, buf = buf.split(b"\n")
+            for line in lines:
+                line = line.decode(errors="replace").strip()
+                if line.startswith('{"benchmark"'):
+                    result = json.loads(line)
+                    results[result["benchmark"]] = result
+                elif line in END_MARKERS:
+                    return results
+        print("{}: timeout".format(app), file=sys.stderr)
+        return results
+    finally:
+        os.killpg(proc.pid, signal.SIGTERM)
+        proc.wait()
+
+
+def compare(baseline, results, threshold):
+    """prints a comparison and returns the number of regressions"""
+    regressions = 0
+    for app, benchmarks in sorted(results.items()):
+        print(app)
+        for name, result in benchmarks.items():
+            base = baseline.get(app, {}).get(name)
+            median = result.get("median")
+            if median is None:
+                continue
+            if base is None or base["median"] == 0:
+                print("    {:<32} {:>10} ns  (no baseline)".format(name, median))
+                continue
+            change = (median - base["median"]) * 100.0 / base["median"]
+            status = ""
+            if change > threshold:
+                status = "REGRESSION"
+                regressions += 1
+            print("    {:<32} {:>10} ns  {:>10} ns  {:+7.1f}%  {}".format(
+                name, median, base["median"], change, status))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Runs benchmarks and compares them against a baseline")
+    parser.add_argument("apps", nargs="+", help="Application directories")
+    parser.add_argument("--board", default="native")
+    parser.add_argument("--baseline", help="Baseline file (default: {})"
+                        .format(DEFAULT_BASELINE))
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Allowed slow-down of the median in percent")
+    parser.add_argument("--timeout", type=float, default=120.0,
+                        help="Timeout per application in seconds")
+    parser.add_argument("--update", action="store_true",
+                        help="Store the results as new baseline")
+    args = parser.parse_args()
+
+    baseline_file = args.baseline or DEFAULT_BASELINE.format(board=args.board)
+    baseline = {}
+    if os.path.exists(baseline_file):
+        with open(baseline_file) as f:
+            baseline = json.load(f)
+
+    results = {}
+    for app in args.apps:
+        name = os.path.relpath(os.path.abspath(app), RIOTBASE)
+        results[name] = run_app(app, args.board, args.timeout)
+
+    regressions = compare(baseline, results, args.threshold)
+    if args.update:
+        baseline.update(results)
+        with open(baseline_file, "w") as f:
+            json.dump(baseline, f, indent=4, sort_keys=True)
+            f.write("\n")
+        print("baseline written to {}".format(baseline_file))
+        return 0
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Decodes the output of the log_binary module
+
+The format strings are looked up in the ELF file of the application. Output
+in between binary frames is passed through unchanged.
+
+Usage:
+
+    decode.py bin/<board>/<app>.elf < log.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+MAGIC = b"\xa5\x5a"
+HDR_SIZE = 6
+LEVEL_CUT = 0x80
+
+SPEC = re.compile(r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d*)"
+                  r"(?:\.(?P<prec>\*|\d*))?"
+                  r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conv>[diouxXcpsfFeEgGaA%])")
+
+
+class Elf:
+    def __init__(self, path):
+        self.file = open(path, "rb")
+        self.elf = ELFFile(self.file)
+        self.little = self.elf.little_endian
+        self.sections = [s for s in self.elf.iter_sections()
+                         if s["sh_addr"] and s["sh_type"] == "SHT_PROGBITS"]
+
+    def string(self, addr):
+        for section in self.sections:
+            start = section["sh_addr"]
+            if start <= addr < start + section["sh_size"]:
+                data = section.data()[addr - start:]
+                return data[:data.index(b"\0")].decode(errors="replace")
+        return None
+
+
+def arg_format(spec):
+    """returns the struct format of a conversion specification on a 32-bit
+    device"""
+    conv = spec.group("conv")
+    length = spec.group("length") or ""
+    if conv in "fFeEgGaA":
+        return "d"
+    if length in ("ll", "j"):
+        return "q" if conv in "di" else "Q"
+    return "i" if conv in "dic" else "I"
+
+
+def format_record(elf, record):
+    order = "<" if elf.little else ">"
+    level = record[1]
+    addr, = struct.unpack(order + "I", record[2:HDR_SIZE])
+    fmt = elf.string(addr)
+    if fmt is None:
+        return "<unknown format string at 0x%08x>\n" % addr
+    args = record[HDR_SIZE:]
+    out = []
+    pos = 0
+    cut = False
+
+    def take(fmt_char):
+        nonlocal args
+        size = struct.calcsize(fmt_char)
+        if len(args) < size:
+            raise IndexError
+        val, = struct.unpack(order + fmt_char, args[:size])
+        args = args[size:]
+        return val
+
+    for spec in SPEC.finditer(fmt):
+        out.append(fmt[pos:spec.start()])
+        pos = spec.end()
+        if spec.group("conv") == "%":
+            out.append("%")
+            continue
+        try:
+            width = spec.group("width")
+            prec = spec.group("prec")
+            if width == "*":
+                width = str(take("i"))
+            if prec == "*":
+                prec = str(take("i"))
+            pyspec = "%" + spec.group("flags") + (width or "")
+            if prec is not None:
+                pyspec += "." + prec
+            conv = spec.group("conv")
+            if conv == "s":
+                str_len = args[0]
+                val = args[1:1 + str_len].decode(errors="replace")
+                if len(val) < str_len:
+                    raise IndexError
+                args = args[1 + str_len:]
+            else:
+                val = take(arg_format(spec))
+            if conv == "p":
+                pyspec, conv = "0x%", "x"
+            elif conv == "c":
+                val = chr(val & 0xff)
+            elif conv in "iu":
+                conv = "d"
+            out.append((pyspec + conv) % val)
+        except IndexError:
+            cut = True
+            break
+    if cut or (level & LEVEL_CUT):
+        out.append("...\n")
+    else:
+        out.append(fmt[pos:])
+    return "".join(out)
+
+
+def decode(elf, data, out):
+    while data:
+        start = data.find(MAGIC)
+        if start < 0:
+            out.write(data.decode(errors="replace"))
+            return
+        out.write(data[:start].decode(errors="replace"))
+        data = data[start + len(MAGIC):]
+        if not data or len(data) < data[0] or data[0] < HDR_SIZE:
+            continue
+        record = data[:data[0]]
+        data = data[data[0]:]
+        out.write(format_record(elf, record))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decodes the output of the log_binary module")
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("input", nargs="?", type=argparse.FileType("rb"),
+                        default=sys.stdin.buffer,
+                        help="Binary log output (default: stdin)")
+    args = parser.parse_args()
+    decode(Elf(args.elf), args.input.read(), sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
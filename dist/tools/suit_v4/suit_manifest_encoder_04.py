@@ -104,6 +104,8 @@ SUIT_Parameter_Image_Size = 12
 
 SUIT_Compression_Algorithm = 1
 
+SUIT_Unpack_Algorithm = 1
+
 def obj2bytes(o):
     if isinstance(o, int):
         l = []
@@ -137,10 +139,24 @@ def make_SUIT_Compression_Info(info):
         'deflate' : 3,
         'lz4' : 4,
         'lzma' : 7,
+        # private value used by RIOT
+        'heatshrink' : -1,
     }
     cinfo = {
         SUIT_Compression_Algorithm :algorithms[info['algorithm']]
     }
+    return cinfo
+
+def make_SUIT_Unpack_Info(info):
+    algorithms = {
+        'delta' : 1,
+        'hex' : 2,
+        'elf' : 3,
+    }
+    uinfo = {
+        SUIT_Unpack_Algorithm :algorithms[info['algorithm']]
+    }
+    return uinfo
 
 def make_SUIT_Set_Parameters(parameters):
     set_parameters = {}
@@ -159,6 +175,10 @@ def make_SUIT_Set_Parameters(parameters):
             cbor.dumps(make_SUIT_Compression_Info(x))
         ),
         # SUIT_Parameter_Unpack_Info = 9
+        'unpack-info': lambda x : (
+            SUIT_Parameter_Unpack_Info,
+            cbor.dumps(make_SUIT_Unpack_Info(x))
+        ),
         'source-index' : lambda x :(SUIT_Parameter_Source_Component, int(x)),
         'image-digest' : lambda x :(SUIT_Parameter_Image_Digest, cbor.dumps(x, sort_keys=True)),
         'image-size'   : lambda x :(SUIT_Parameter_Image_Size, int(x)),
@@ -316,6 +336,16 @@ def digest_str_to_id(s):
         'sha3-512' : 12,
     }.get(s, 1)
 
+def make_fetch_params(image):
+    params = {
+        "uris" : [[0, str(image['uri'])]]
+    }
+    # the payload may be compressed and/or a delta to the running image
+    for key in ('compression-info', 'unpack-info'):
+        if key in image:
+            params[key] = image[key]
+    return params
+
 def compile_to_suit(suit_info):
     digest_id = digest_str_to_id(suit_info.get('digest-type', 'sha-256'))
     suit_manifest_desc = {
@@ -360,9 +390,7 @@ def compile_to_suit(suit_info):
             common.append(set_comp)
             common.append(set_params)
             set_params = {
-                "directive-set-var" : {
-                    "uris" : [[0, str(comp['images'][0]['uri'])]]
-                }
+                "directive-set-var" : make_fetch_params(comp['images'][0])
             }
             apply_image.append(set_comp)
             apply_image.append(set_params)
@@ -381,9 +409,7 @@ def compile_to_suit(suit_info):
                 }
                 common.append(conditional_set_params)
                 set_params = {
-                    "directive-set-var" : {
-                        "uris" : [[0, str(image['uri'])]]
-                    }
+                    "directive-set-var" : make_fetch_params(image)
                 }
                 conditional_seq = [set_comp] + image.get('conditions',[])[:] + [set_params]
                 conditional_set_params = {
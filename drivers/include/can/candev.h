@@ -52,9 +52,22 @@ typedef enum {
     CANDEV_EVENT_BUS_OFF,          /**< bus-off detected */
     CANDEV_EVENT_ERROR_PASSIVE,    /**< driver switched in error passive */
     CANDEV_EVENT_ERROR_WARNING,    /**< driver reached error warning */
+    CANDEV_EVENT_RX_BATCH,         /**< several packets have been received */
     /* expand this list if needed */
 } candev_event_t;
 
+/**
+ * @brief   Argument of a @ref CANDEV_EVENT_RX_BATCH event
+ *
+ * Drivers which drain several frames per interrupt should hand them to the
+ * upper layer at once instead of raising a @ref CANDEV_EVENT_RX_INDICATION
+ * per frame. The frames only need to stay valid during the event callback.
+ */
+typedef struct {
+    struct can_frame *frames;      /**< received frames */
+    unsigned count;                /**< number of frames in @p frames */
+} candev_rx_batch_t;
+
 /**
  * @brief   Forward declaration for candev struct
  */
@@ -27,6 +27,14 @@
 #if MODULE_VFS
 #include "vfs.h"
 #endif
+#if MODULE_MTD_ASYNC
+#include <errno.h>
+#include <stdbool.h>
+
+#include "event.h"
+#include "mutex.h"
+#include "thread.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +70,11 @@ typedef struct {
     uint32_t page_size;        /**< Size of the pages in the MTD */
 } mtd_dev_t;
 
+/**
+ * @brief   Asynchronous MTD request, see @ref mtd_read_async()
+ */
+typedef struct mtd_async mtd_async_t;
+
 /**
  * @brief   MTD driver interface
  *
@@ -146,6 +159,66 @@ struct mtd_desc {
      * @return < 0 value on error
      */
     int (*power)(mtd_dev_t *dev, enum mtd_power_state power);
+
+    /**
+     * @brief   Read from pages of the Memory Technology Device (MTD)
+     *
+     * Optional, used by mtd_read_page(). The read may span multiple pages and
+     * should be done in a single bulk operation if the device supports it.
+     *
+     * @param[in]  dev      Pointer to the selected driver
+     * @param[out] buff     Pointer to the data buffer to store read data
+     * @param[in]  page     Page number to start reading from
+     * @param[in]  offset   Byte offset from the start of the page
+     * @param[in]  size     Number of bytes
+     *
+     * @return the number of bytes actually read
+     * @return < 0 value on error
+     */
+    int (*read_page)(mtd_dev_t *dev,
+                     void *buff,
+                     uint32_t page,
+                     uint32_t offset,
+                     uint32_t size);
+
+    /**
+     * @brief   Write to pages of the Memory Technology Device (MTD)
+     *
+     * Optional, used by mtd_write_page(). The write may span multiple pages
+     * and should be done in a single bulk operation if the device supports
+     * it.
+     *
+     * @param[in] dev       Pointer to the selected driver
+     * @param[in] buff      Pointer to the data to be written
+     * @param[in] page      Page number to start writing to
+     * @param[in] offset    Byte offset from the start of the page
+     * @param[in] size      Number of bytes
+     *
+     * @return the number of bytes actually written
+     * @return < 0 value on error
+     */
+    int (*write_page)(mtd_dev_t *dev,
+                      const void *buff,
+                      uint32_t page,
+                      uint32_t offset,
+                      uint32_t size);
+
+    /**
+     * @brief   Start an asynchronous operation (module `mtd_async`)
+     *
+     * Optional. The driver starts the operation described by @p req and
+     * returns immediately. Once the operation is done, the driver calls
+     * mtd_async_complete(), which is allowed from interrupt context and
+     * even before this function returns. Drivers without this function are
+     * served by the `mtd_async` worker thread.
+     *
+     * @param[in] dev       Pointer to the selected driver
+     * @param[in] req       Request to start
+     *
+     * @return 0 if the operation was started
+     * @return < 0 value on error, mtd_async_complete() is not called then
+     */
+    int (*submit)(mtd_dev_t *dev, mtd_async_t *req);
 };
 
 /**
@@ -199,6 +272,58 @@ int mtd_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t count);
  */
 int mtd_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t count);
 
+/**
+ * @brief   Read data from multiple pages of a MTD device
+ *
+ * Unlike mtd_read(), the position is given as page number and offset, so
+ * devices larger than 4 GiB can be addressed. Drivers that implement
+ * mtd_desc::read_page transfer all pages in one bulk operation, e.g. a
+ * multiple block read of a SD card.
+ *
+ * @param      mtd    the device to read from
+ * @param[out] dest   the buffer to fill in
+ * @param[in]  page   the page to start reading from
+ * @param[in]  offset offset from the start of @p page, smaller than the page size
+ * @param[in]  count  the number of bytes to read
+ *
+ * @return @p count if all bytes were read
+ * @return < 0 if an error occurred
+ * @return -ENODEV if @p mtd is not a valid device
+ * @return -ENOTSUP if operation is not supported on @p mtd
+ * @return -EOVERFLOW if @p page is outside memory
+ * @return -EINVAL if @p offset is not inside the page
+ * @return -EIO if I/O error occurred
+ */
+int mtd_read_page(mtd_dev_t *mtd, void *dest, uint32_t page, uint32_t offset,
+                  uint32_t count);
+
+/**
+ * @brief   Write data to multiple pages of a MTD device
+ *
+ * Unlike mtd_write(), the data may span multiple pages. Drivers that
+ * implement mtd_desc::write_page transfer all pages in one bulk operation,
+ * e.g. a multiple block write of a SD card, otherwise the data is written
+ * page by page. Some devices might require @p offset to be 0 and @p count to
+ * be a multiple of the page size.
+ *
+ * @param      mtd    the device to write to
+ * @param[in]  src    the buffer to write
+ * @param[in]  page   the page to start writing to
+ * @param[in]  offset offset from the start of @p page, smaller than the page size
+ * @param[in]  count  the number of bytes to write
+ *
+ * @return @p count if all bytes were written
+ * @return < 0 if an error occurred
+ * @return -ENODEV if @p mtd is not a valid device
+ * @return -ENOTSUP if operation is not supported on @p mtd
+ * @return -EOVERFLOW if @p page is outside memory
+ * @return -EINVAL if @p offset is not inside the page or if parameters are
+ *         invalid for the device (invalid alignment for instance)
+ * @return -EIO if I/O error occurred
+ */
+int mtd_write_page(mtd_dev_t *mtd, const void *src, uint32_t page,
+                   uint32_t offset, uint32_t count);
+
 /**
  * @brief   Erase sectors of a MTD device
  *
@@ -231,6 +356,179 @@ int mtd_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t count);
  */
 int mtd_power(mtd_dev_t *mtd, enum mtd_power_state power);
 
+#if defined(MODULE_MTD_ASYNC) || defined(DOXYGEN)
+/**
+ * @name    Asynchronous MTD access (module `mtd_async`)
+ *
+ * The asynchronous functions return as soon as the operation is started,
+ * so the caller can do other work while the device is busy erasing or
+ * programming. Completion is signalled by the optional callback and can
+ * be awaited with mtd_async_wait().
+ *
+ * If the driver implements mtd_desc::submit, the operation is run by the
+ * driver itself, e.g. using DMA and the device's ready interrupt. Otherwise
+ * the synchronous operation is run by a worker thread of priority
+ * @ref MTD_ASYNC_PRIO, which is started with the first request. Requests
+ * for the worker are handled in order of submission.
+ *
+ * While a request is pending, neither the request nor its buffer may be
+ * touched, and the device must not be accessed with the synchronous
+ * functions.
+ * @{
+ */
+
+/**
+ * @brief   Stack size of the worker thread
+ */
+#ifndef MTD_ASYNC_STACKSIZE
+#define MTD_ASYNC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the worker thread
+ *
+ * Higher than the main thread, so the worker gets the CPU back as soon as
+ * the device becomes ready.
+ */
+#ifndef MTD_ASYNC_PRIO
+#define MTD_ASYNC_PRIO          (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Asynchronous operations
+ */
+enum mtd_async_op {
+    MTD_ASYNC_READ,             /**< mtd_read() */
+    MTD_ASYNC_WRITE,            /**< mtd_write() */
+    MTD_ASYNC_ERASE,            /**< mtd_erase() */
+};
+
+/**
+ * @brief   Completion callback
+ *
+ * May be called in interrupt context. The callback must not submit a new
+ * request with @p req.
+ *
+ * @param[in] req   The completed request, mtd_async_t::res holds the result
+ */
+typedef void (*mtd_async_cb_t)(mtd_async_t *req);
+
+/**
+ * @brief   Asynchronous MTD request
+ *
+ * All members are set by the submitting functions.
+ */
+struct mtd_async {
+    event_t event;              /**< used to queue the request for the worker */
+    mtd_dev_t *dev;             /**< device to access */
+    void *buf;                  /**< data buffer, NULL for erase */
+    uint32_t addr;              /**< start address */
+    uint32_t count;             /**< number of bytes */
+    mtd_async_cb_t cb;          /**< completion callback, may be NULL */
+    void *arg;                  /**< argument for the callback */
+    mutex_t done;               /**< locked while the request is pending */
+    volatile int res;           /**< result, -EINPROGRESS while pending */
+    uint8_t op;                 /**< operation, see @ref mtd_async_op */
+};
+
+/**
+ * @brief   Start reading from a MTD device
+ *
+ * Same as mtd_read(), but returns as soon as the read is started.
+ *
+ * @param      mtd   the device to read from
+ * @param[out] req   request to use, must stay valid until completion
+ * @param[out] dest  the buffer to fill in
+ * @param[in]  addr  the start address to read from
+ * @param[in]  count the number of bytes to read
+ * @param[in]  cb    completion callback, may be NULL
+ * @param[in]  arg   argument for @p cb, stored in mtd_async_t::arg
+ *
+ * @return 0 if the read was started, the result is reported on completion
+ * @return -ENODEV if @p mtd is not a valid device
+ * @return < 0 if the driver could not start the read
+ */
+int mtd_read_async(mtd_dev_t *mtd, mtd_async_t *req, void *dest,
+                   uint32_t addr, uint32_t count, mtd_async_cb_t cb,
+                   void *arg);
+
+/**
+ * @brief   Start writing to a MTD device
+ *
+ * Same as mtd_write(), but returns as soon as the write is started.
+ *
+ * @param      mtd   the device to write to
+ * @param[out] req   request to use, must stay valid until completion
+ * @param[in]  src   the buffer to write, must stay valid until completion
+ * @param[in]  addr  the start address to write to
+ * @param[in]  count the number of bytes to write
+ * @param[in]  cb    completion callback, may be NULL
+ * @param[in]  arg   argument for @p cb, stored in mtd_async_t::arg
+ *
+ * @return 0 if the write was started, the result is reported on completion
+ * @return -ENODEV if @p mtd is not a valid device
+ * @return < 0 if the driver could not start the write
+ */
+int mtd_write_async(mtd_dev_t *mtd, mtd_async_t *req, const void *src,
+                    uint32_t addr, uint32_t count, mtd_async_cb_t cb,
+                    void *arg);
+
+/**
+ * @brief   Start erasing sectors of a MTD device
+ *
+ * Same as mtd_erase(), but returns as soon as the erase is started.
+ *
+ * @param      mtd   the device to erase
+ * @param[out] req   request to use, must stay valid until completion
+ * @param[in]  addr  the address of the first sector to erase
+ * @param[in]  count the number of bytes to erase
+ * @param[in]  cb    completion callback, may be NULL
+ * @param[in]  arg   argument for @p cb, stored in mtd_async_t::arg
+ *
+ * @return 0 if the erase was started, the result is reported on completion
+ * @return -ENODEV if @p mtd is not a valid device
+ * @return < 0 if the driver could not start the erase
+ */
+int mtd_erase_async(mtd_dev_t *mtd, mtd_async_t *req, uint32_t addr,
+                    uint32_t count, mtd_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Wait for a request to complete
+ *
+ * Must only be called by one thread per request.
+ *
+ * @param[in] req   a submitted request
+ *
+ * @return the result of the operation, as the synchronous function would
+ *         have returned it
+ */
+int mtd_async_wait(mtd_async_t *req);
+
+/**
+ * @brief   Check if a request is still pending
+ *
+ * @param[in] req   a submitted request
+ *
+ * @return true if the operation has not completed yet
+ */
+static inline bool mtd_async_pending(const mtd_async_t *req)
+{
+    return req->res == -EINPROGRESS;
+}
+
+/**
+ * @brief   Complete a request, for use by drivers
+ *
+ * Stores the result, calls the callback and wakes up mtd_async_wait().
+ * May be called from interrupt context.
+ *
+ * @param[in] req   the request that is done
+ * @param[in] res   result of the operation
+ */
+void mtd_async_complete(mtd_async_t *req, int res);
+/** @} */
+#endif
+
 #if defined(MODULE_VFS) || defined(DOXYGEN)
 /**
  * @brief   MTD driver for VFS
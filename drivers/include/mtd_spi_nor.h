@@ -82,6 +82,19 @@ typedef struct __attribute__((packed)) {
  * @brief   Flag to set when the device support 32KiB block erase (block_erase_32k opcode)
  */
 #define SPI_NOR_F_SECT_32K  (2)
+/**
+ * @brief   Flag to set when the block_erase opcode erases 64KiB blocks
+ *
+ * Without this flag, block_erase is assumed to erase one MTD sector.
+ */
+#define SPI_NOR_F_SECT_64K  (4)
+/**
+ * @brief   Flag to set to read with the read_fast opcode
+ *
+ * The fast read sends a dummy byte after the address and allows higher SPI
+ * clocks than the plain read, see the data sheet of the device.
+ */
+#define SPI_NOR_F_FAST_READ (8)
 
 /**
  * @brief   Device descriptor for serial flash memory devices
@@ -122,6 +135,18 @@ typedef struct {
      * Computed by mtd_spi_nor_init, no need to touch outside the driver.
      */
     uint8_t sec_addr_shift;
+    /**
+     * @brief   Optional write buffer of one page, NULL to program right away
+     *
+     * Consecutive writes within one page are collected in this buffer and
+     * programmed at once when the page is complete, instead of one page
+     * program per write. Buffered data is programmed before a read of its
+     * range, an erase, a power down, a non-consecutive write and by
+     * mtd_spi_nor_flush().
+     */
+    uint8_t *wbuf;
+    uint32_t wbuf_addr;      /**< address of the buffered data */
+    uint32_t wbuf_len;       /**< number of buffered bytes */
 } mtd_spi_nor_t;
 
 /**
@@ -129,6 +154,16 @@ typedef struct {
  */
 extern const mtd_desc_t mtd_spi_nor_driver;
 
+/**
+ * @brief   Program the data held in the write buffer of a device
+ *
+ * Must be called when the data written with mtd_write() has to be on the
+ * flash, e.g. when a file system syncs, if mtd_spi_nor_t::wbuf is used.
+ *
+ * @param[in] dev   device to flush
+ */
+void mtd_spi_nor_flush(mtd_spi_nor_t *dev);
+
 /* Available opcode tables for known devices */
 /* Defined in mtd_spi_nor_configs.c */
 /**
@@ -213,6 +213,9 @@ int sdcard_spi_init(sdcard_spi_t *card, const sdcard_spi_params_t *params);
 /**
  * @brief                 Reads data blocks (usually multiples of 512 Bytes) from card to buffer.
  *
+ * Multiple blocks are read with a single multiple block read command (CMD18), which is
+ * considerably faster than reading them one by one.
+ *
  * @param[in] card        Initialized sd-card struct
  * @param[in] blockaddr   Start address to read from. Independent of the actual addressing scheme of
  *                        the used card the address needs to be given as block address
@@ -236,6 +239,10 @@ int sdcard_spi_read_blocks(sdcard_spi_t *card, int blockaddr, uint8_t *data, int
 /**
  * @brief                 Writes data blocks (usually multiples of 512 Bytes) from buffer to card.
  *
+ * Multiple blocks are written with a single multiple block write command (CMD25), preceded by
+ * the number of blocks to pre-erase (ACMD23). This is considerably faster than writing them one
+ * by one.
+ *
  * @param[in] card        Initialized sd-card struct
  * @param[in] blockaddr   Start address to read from. Independent of the actual addressing scheme of
  *                        the used card the address needs to be given as block address
@@ -64,6 +64,93 @@ int mtd_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t count)
     }
 }
 
+static int _check_page(mtd_dev_t *mtd, uint32_t page, uint32_t offset)
+{
+    if (!mtd || !mtd->driver) {
+        return -ENODEV;
+    }
+    if (page >= mtd->sector_count * mtd->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+    if (offset >= mtd->page_size) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+int mtd_read_page(mtd_dev_t *mtd, void *dest, uint32_t page, uint32_t offset,
+                  uint32_t count)
+{
+    int res = _check_page(mtd, page, offset);
+    if (res < 0) {
+        return res;
+    }
+
+    uint8_t *buf = dest;
+    uint32_t left = count;
+    while (left) {
+        if (mtd->driver->read_page) {
+            res = mtd->driver->read_page(mtd, buf, page, offset, left);
+        }
+        else if (mtd->driver->read) {
+            res = mtd->driver->read(mtd, buf, page * mtd->page_size + offset,
+                                    left);
+        }
+        else {
+            return -ENOTSUP;
+        }
+        if (res <= 0) {
+            return (res < 0) ? res : -EIO;
+        }
+        buf += res;
+        left -= res;
+        offset += res;
+        page += offset / mtd->page_size;
+        offset %= mtd->page_size;
+    }
+
+    return count;
+}
+
+int mtd_write_page(mtd_dev_t *mtd, const void *src, uint32_t page,
+                   uint32_t offset, uint32_t count)
+{
+    int res = _check_page(mtd, page, offset);
+    if (res < 0) {
+        return res;
+    }
+
+    const uint8_t *buf = src;
+    uint32_t left = count;
+    while (left) {
+        if (mtd->driver->write_page) {
+            res = mtd->driver->write_page(mtd, buf, page, offset, left);
+        }
+        else if (mtd->driver->write) {
+            /* mtd_desc::write must not cross a page boundary */
+            uint32_t chunk = mtd->page_size - offset;
+            if (chunk > left) {
+                chunk = left;
+            }
+            res = mtd->driver->write(mtd, buf, page * mtd->page_size + offset,
+                                     chunk);
+        }
+        else {
+            return -ENOTSUP;
+        }
+        if (res <= 0) {
+            return (res < 0) ? res : -EIO;
+        }
+        buf += res;
+        left -= res;
+        offset += res;
+        page += offset / mtd->page_size;
+        offset %= mtd->page_size;
+    }
+
+    return count;
+}
+
 int mtd_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t count)
 {
     if (!mtd || !mtd->driver) {
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#if MODULE_MTD_ASYNC
+
+/**
+ * @ingroup     drivers_mtd
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous MTD access
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "irq.h"
+#include "kernel_defines.h"
+#include "mtd.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* stack of the worker thread for drivers without mtd_desc::submit */
+static char _stack[MTD_ASYNC_STACKSIZE];
+
+/* PID of the worker thread, KERNEL_PID_UNDEF if not created yet */
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
+static event_queue_t _queue = EVENT_QUEUE_INIT_DETACHED;
+
+static void *_worker(void *arg)
+{
+    (void)arg;
+
+    event_queue_claim(&_queue);
+    event_loop(&_queue);
+
+    return NULL;
+}
+
+static void _handler(event_t *event)
+{
+    mtd_async_t *req = container_of(event, mtd_async_t, event);
+    int res;
+
+    DEBUG("mtd_async: op %u addr 0x%" PRIx32 " count %" PRIu32 "\n",
+          req->op, req->addr, req->count);
+
+    switch (req->op) {
+        case MTD_ASYNC_READ:
+            res = mtd_read(req->dev, req->buf, req->addr, req->count);
+            break;
+        case MTD_ASYNC_WRITE:
+            res = mtd_write(req->dev, req->buf, req->addr, req->count);
+            break;
+        default:
+            res = mtd_erase(req->dev, req->addr, req->count);
+            break;
+    }
+
+    mtd_async_complete(req, res);
+}
+
+static void _post(mtd_async_t *req)
+{
+    unsigned state = irq_disable();
+
+    if (_pid == KERNEL_PID_UNDEF) {
+        DEBUG("mtd_async: create worker thread\n");
+        _pid = thread_create(_stack, sizeof(_stack), MTD_ASYNC_PRIO,
+                             THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                             _worker, NULL, "mtd_async");
+        assert(_pid != KERNEL_PID_UNDEF);
+    }
+
+    irq_restore(state);
+
+    req->event.handler = _handler;
+    event_post(&_queue, &req->event);
+}
+
+static int _submit(mtd_dev_t *mtd, mtd_async_t *req, uint8_t op, void *buf,
+                   uint32_t addr, uint32_t count, mtd_async_cb_t cb, void *arg)
+{
+    if (!mtd || !mtd->driver) {
+        return -ENODEV;
+    }
+
+    req->dev = mtd;
+    req->buf = buf;
+    req->addr = addr;
+    req->count = count;
+    req->cb = cb;
+    req->arg = arg;
+    req->op = op;
+    req->res = -EINPROGRESS;
+    /* event_post() ignores events that look queued already */
+    memset(&req->event, 0, sizeof(req->event));
+    mutex_init(&req->done);
+    mutex_lock(&req->done);
+
+    if (!mtd->driver->submit) {
+        _post(req);
+        return 0;
+    }
+
+    int res = mtd->driver->submit(mtd, req);
+    if (res < 0) {
+        req->res = res;
+        mutex_unlock(&req->done);
+    }
+    return res;
+}
+
+int mtd_read_async(mtd_dev_t *mtd, mtd_async_t *req, void *dest,
+                   uint32_t addr, uint32_t count, mtd_async_cb_t cb,
+                   void *arg)
+{
+    return _submit(mtd, req, MTD_ASYNC_READ, dest, addr, count, cb, arg);
+}
+
+int mtd_write_async(mtd_dev_t *mtd, mtd_async_t *req, const void *src,
+                    uint32_t addr, uint32_t count, mtd_async_cb_t cb,
+                    void *arg)
+{
+    return _submit(mtd, req, MTD_ASYNC_WRITE, (void *)src, addr, count, cb,
+                   arg);
+}
+
+int mtd_erase_async(mtd_dev_t *mtd, mtd_async_t *req, uint32_t addr,
+                    uint32_t count, mtd_async_cb_t cb, void *arg)
+{
+    return _submit(mtd, req, MTD_ASYNC_ERASE, NULL, addr, count, cb, arg);
+}
+
+int mtd_async_wait(mtd_async_t *req)
+{
+    mutex_lock(&req->done);
+    /* keep it unlocked, so waiting again returns right away */
+    mutex_unlock(&req->done);
+
+    return req->res;
+}
+
+void mtd_async_complete(mtd_async_t *req, int res)
+{
+    assert(res != -EINPROGRESS);
+
+    req->res = res;
+    if (req->cb) {
+        req->cb(req);
+    }
+    mutex_unlock(&req->done);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_MTD_ASYNC */
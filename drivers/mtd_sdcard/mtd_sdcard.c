@@ -35,6 +35,10 @@ static int mtd_sdcard_write(mtd_dev_t *mtd, const void *src, uint32_t addr,
                             uint32_t size);
 static int mtd_sdcard_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size);
 static int mtd_sdcard_power(mtd_dev_t *mtd, enum mtd_power_state power);
+static int mtd_sdcard_read_page(mtd_dev_t *mtd, void *dest, uint32_t page,
+                                uint32_t offset, uint32_t size);
+static int mtd_sdcard_write_page(mtd_dev_t *mtd, const void *src, uint32_t page,
+                                 uint32_t offset, uint32_t size);
 
 const mtd_desc_t mtd_sdcard_driver = {
     .init = mtd_sdcard_init,
@@ -42,6 +46,8 @@ const mtd_desc_t mtd_sdcard_driver = {
     .write = mtd_sdcard_write,
     .erase = mtd_sdcard_erase,
     .power = mtd_sdcard_power,
+    .read_page = mtd_sdcard_read_page,
+    .write_page = mtd_sdcard_write_page,
 };
 
 static int mtd_sdcard_init(mtd_dev_t *dev)
@@ -94,6 +100,52 @@ static int mtd_sdcard_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
     return -EIO;
 }
 
+static int mtd_sdcard_read_page(mtd_dev_t *dev, void *buff, uint32_t page,
+                                uint32_t offset, uint32_t size)
+{
+    DEBUG("mtd_sdcard_read_page: page:%" PRIu32 " offset:%" PRIu32 " size:%"
+          PRIu32 "\n", page, offset, size);
+    mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
+    sd_rw_response_t err;
+
+    /* the card can only transfer whole blocks */
+    if ((offset != 0) || (size % SD_HC_BLOCK_SIZE) || (size == 0)) {
+        return -EINVAL;
+    }
+
+    int res = sdcard_spi_read_blocks(mtd_sd->sd_card, page, buff,
+                                     SD_HC_BLOCK_SIZE, size / SD_HC_BLOCK_SIZE,
+                                     &err);
+
+    if (err == SD_RW_OK) {
+        return res * SD_HC_BLOCK_SIZE;
+    }
+    return -EIO;
+}
+
+static int mtd_sdcard_write_page(mtd_dev_t *dev, const void *buff,
+                                 uint32_t page, uint32_t offset, uint32_t size)
+{
+    DEBUG("mtd_sdcard_write_page: page:%" PRIu32 " offset:%" PRIu32 " size:%"
+          PRIu32 "\n", page, offset, size);
+    mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
+    sd_rw_response_t err;
+
+    /* the card can only transfer whole blocks */
+    if ((offset != 0) || (size % SD_HC_BLOCK_SIZE) || (size == 0)) {
+        return -EINVAL;
+    }
+
+    int res = sdcard_spi_write_blocks(mtd_sd->sd_card, page, buff,
+                                      SD_HC_BLOCK_SIZE, size / SD_HC_BLOCK_SIZE,
+                                      &err);
+
+    if (err == SD_RW_OK) {
+        return res * SD_HC_BLOCK_SIZE;
+    }
+    return -EIO;
+}
+
 static int mtd_sdcard_erase(mtd_dev_t *dev,
                             uint32_t addr,
                             uint32_t size)
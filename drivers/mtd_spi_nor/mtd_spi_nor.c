@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <errno.h>
+#include <string.h>
 
 #include "mtd.h"
 #if MODULE_XTIMER
@@ -44,10 +45,18 @@
 #define TRACE(...)
 #endif
 
+/* a page program takes about 1 ms, poll often to not waste throughput */
 #ifndef MTD_SPI_NOR_WRITE_WAIT_US
-#define MTD_SPI_NOR_WRITE_WAIT_US (50 * US_PER_MS)
+#define MTD_SPI_NOR_WRITE_WAIT_US (100)
 #endif
 
+/* sector and block erases take tens to hundreds of milliseconds */
+#ifndef MTD_SPI_NOR_ERASE_WAIT_US
+#define MTD_SPI_NOR_ERASE_WAIT_US (1000)
+#endif
+
+#define MTD_64K             (65536ul)
+#define MTD_64K_ADDR_MASK   (0xFFFF)
 #define MTD_32K             (32768ul)
 #define MTD_32K_ADDR_MASK   (0x7FFF)
 #define MTD_4K              (4096ul)
@@ -74,11 +83,13 @@ const mtd_desc_t mtd_spi_nor_driver = {
  * @param[in]  dev    pointer to device descriptor
  * @param[in]  opcode command opcode
  * @param[in]  addr   address (big endian)
+ * @param[in]  dummy  number of dummy bytes to send after the address
  * @param[out] dest   read buffer
  * @param[in]  count  number of bytes to read after the address has been sent
  */
 static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
-                                  be_uint32_t addr, void *dest, uint32_t count)
+                                  be_uint32_t addr, unsigned dummy,
+                                  void *dest, uint32_t count)
 {
     TRACE("mtd_spi_cmd_addr_read: %p, %02x, (%02x %02x %02x %02x), %p, %" PRIu32 "\n",
           (void *)dev, (unsigned int)opcode, addr.u8[0], addr.u8[1], addr.u8[2],
@@ -97,6 +108,10 @@ static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
         /* Send opcode followed by address */
         spi_transfer_byte(dev->spi, dev->cs, true, opcode);
         spi_transfer_bytes(dev->spi, dev->cs, true, (char *)addr_buf, NULL, dev->addr_width);
+        /* Clock out the dummy bytes, spi_transfer_bytes() needs a buffer */
+        for (unsigned i = 0; i < dummy; i++) {
+            spi_transfer_byte(dev->spi, dev->cs, true, 0);
+        }
 
         /* Read data */
         spi_transfer_bytes(dev->spi, dev->cs, false, NULL, dest, count);
@@ -256,7 +271,8 @@ static int mtd_spi_read_jedec_id(const mtd_spi_nor_t *dev, mtd_jedec_id_t *out)
     return status;
 }
 
-static inline void wait_for_write_complete(const mtd_spi_nor_t *dev)
+static inline void wait_for_write_complete(const mtd_spi_nor_t *dev,
+                                           uint32_t us)
 {
     do {
         uint8_t status;
@@ -267,13 +283,45 @@ static inline void wait_for_write_complete(const mtd_spi_nor_t *dev)
             break;
         }
 #if MODULE_XTIMER
-        xtimer_usleep(MTD_SPI_NOR_WRITE_WAIT_US);
+        xtimer_usleep(us);
 #else
+        (void)us;
         thread_yield();
 #endif
     } while (1);
 }
 
+/**
+ * @internal
+ * @brief Program data within one page, the bus must be acquired
+ */
+static void _program(const mtd_spi_nor_t *dev, uint32_t addr,
+                     const void *src, uint32_t size)
+{
+    be_uint32_t addr_be = byteorder_htonl(addr);
+
+    /* write enable */
+    mtd_spi_cmd(dev, dev->opcode->wren);
+
+    /* Page program */
+    mtd_spi_cmd_addr_write(dev, dev->opcode->page_program, addr_be, src, size);
+
+    /* waiting for the command to complete before returning */
+    wait_for_write_complete(dev, MTD_SPI_NOR_WRITE_WAIT_US);
+}
+
+/**
+ * @internal
+ * @brief Program the content of the write buffer, the bus must be acquired
+ */
+static void _flush(mtd_spi_nor_t *dev)
+{
+    if (dev->wbuf_len) {
+        _program(dev, dev->wbuf_addr, dev->wbuf, dev->wbuf_len);
+        dev->wbuf_len = 0;
+    }
+}
+
 static int mtd_spi_nor_init(mtd_dev_t *mtd)
 {
     DEBUG("mtd_spi_nor_init: %p\n", (void *)mtd);
@@ -295,6 +343,7 @@ static int mtd_spi_nor_init(mtd_dev_t *mtd)
     if (dev->addr_width == 0) {
         return -EINVAL;
     }
+    dev->wbuf_len = 0;
 
     /* CS */
     DEBUG("mtd_spi_nor_init: CS init\n");
@@ -354,29 +403,33 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
 {
     DEBUG("mtd_spi_nor_read: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
           (void *)mtd, dest, addr, size);
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     size_t chipsize = mtd->page_size * mtd->pages_per_sector * mtd->sector_count;
     if (addr > chipsize) {
         return -EOVERFLOW;
     }
-    if (size > mtd->page_size) {
-        size = mtd->page_size;
-    }
+    /* the read command continues over page and sector boundaries, so the
+     * whole range is read at once */
     if ((addr + size) > chipsize) {
         size = chipsize - addr;
     }
-    uint32_t page_addr_mask = dev->page_addr_mask;
-    if ((addr & page_addr_mask) != ((addr + size - 1) & page_addr_mask)) {
-        /* Reads across page boundaries must be split */
-        size = mtd->page_size - (addr & ~(page_addr_mask));
-    }
     if (size == 0) {
         return 0;
     }
     be_uint32_t addr_be = byteorder_htonl(addr);
 
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
-    mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, dest, size);
+    if (dev->wbuf_len && (addr < dev->wbuf_addr + dev->wbuf_len) &&
+        (addr + size > dev->wbuf_addr)) {
+        _flush(dev);
+    }
+    if (dev->flag & SPI_NOR_F_FAST_READ) {
+        mtd_spi_cmd_addr_read(dev, dev->opcode->read_fast, addr_be, 1,
+                              dest, size);
+    }
+    else {
+        mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, 0, dest, size);
+    }
     spi_release(dev->spi);
 
     return size;
@@ -391,7 +444,7 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     if (size == 0) {
         return 0;
     }
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     if (size > mtd->page_size) {
         DEBUG("mtd_spi_nor_write: ERR: page program >1 page (%" PRIu32 ")!\n", mtd->page_size);
         return -EOVERFLOW;
@@ -404,22 +457,49 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     if (addr + size > total_size) {
         return -EOVERFLOW;
     }
-    be_uint32_t addr_be = byteorder_htonl(addr);
 
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
-    /* write enable */
-    mtd_spi_cmd(dev, dev->opcode->wren);
-
-    /* Page program */
-    mtd_spi_cmd_addr_write(dev, dev->opcode->page_program, addr_be, src, size);
-
-    /* waiting for the command to complete before returning */
-    wait_for_write_complete(dev);
+    if (!dev->wbuf) {
+        _program(dev, addr, src, size);
+        spi_release(dev->spi);
+        return size;
+    }
 
+    /* the buffer only holds data of a single page */
+    bool crosses_page = ((addr % mtd->page_size) + size) > mtd->page_size;
+    if (dev->wbuf_len &&
+        ((addr != dev->wbuf_addr + dev->wbuf_len) || crosses_page)) {
+        _flush(dev);
+    }
+    if (crosses_page || ((dev->wbuf_len == 0) && (size == mtd->page_size))) {
+        /* nothing to collect for a full page, and data crossing a page
+         * boundary is programmed as before, without the buffer */
+        _program(dev, addr, src, size);
+    }
+    else {
+        if (dev->wbuf_len == 0) {
+            dev->wbuf_addr = addr;
+        }
+        memcpy(dev->wbuf + dev->wbuf_len, src, size);
+        dev->wbuf_len += size;
+        if (((dev->wbuf_addr + dev->wbuf_len) % mtd->page_size) == 0) {
+            _flush(dev);
+        }
+    }
     spi_release(dev->spi);
+
     return size;
 }
 
+void mtd_spi_nor_flush(mtd_spi_nor_t *dev)
+{
+    if (dev->wbuf_len) {
+        spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+        _flush(dev);
+        spi_release(dev->spi);
+    }
+}
+
 static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
 {
     DEBUG("mtd_spi_nor_erase: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
@@ -445,6 +525,8 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
     }
 
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+    _flush(dev);
+    /* always use the largest erase command that fits the remaining range */
     while (size) {
         be_uint32_t addr_be = byteorder_htonl(addr);
         /* write enable */
@@ -454,6 +536,13 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
             mtd_spi_cmd(dev, dev->opcode->chip_erase);
             size -= total_size;
         }
+        else if ((dev->flag & SPI_NOR_F_SECT_64K) && (size >= MTD_64K) &&
+                 ((addr & MTD_64K_ADDR_MASK) == 0)) {
+            /* 64 KiB blocks can be erased with block erase command */
+            mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase, addr_be, NULL, 0);
+            addr += MTD_64K;
+            size -= MTD_64K;
+        }
         else if ((dev->flag & SPI_NOR_F_SECT_32K) && (size >= MTD_32K) &&
                  ((addr & MTD_32K_ADDR_MASK) == 0)) {
             /* 32 KiB blocks can be erased with block erase command */
@@ -475,7 +564,7 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
         }
 
         /* waiting for the command to complete before continuing */
-        wait_for_write_complete(dev);
+        wait_for_write_complete(dev, MTD_SPI_NOR_ERASE_WAIT_US);
     }
     spi_release(dev->spi);
 
@@ -492,6 +581,7 @@ static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
             mtd_spi_cmd(dev, dev->opcode->wake);
             break;
         case MTD_POWER_DOWN:
+            _flush(dev);
             mtd_spi_cmd(dev, dev->opcode->sleep);
             break;
     }
@@ -24,7 +24,7 @@
 #include "sdcard_spi_params.h"
 #include "periph/spi.h"
 #include "periph/gpio.h"
-#include "checksum/ucrc16.h"
+#include "checksum/crc16_ccitt.h"
 #include "xtimer.h"
 
 #include <stdio.h>
@@ -59,6 +59,14 @@ static inline int _hw_spi_rxtx_byte(sdcard_spi_t *card, uint8_t out, uint8_t *in
 /* function pointer to switch to hw spi mode after init sequence */
 static int (*_dyn_spi_rxtx_byte)(sdcard_spi_t *card, uint8_t out, uint8_t *in);
 
+/* clocked out while receiving data, the card expects MOSI to be high */
+static const uint8_t _dummy_bytes[SD_CARD_DUMMY_BUF_SIZE] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
 int sdcard_spi_init(sdcard_spi_t *card, const sdcard_spi_params_t *params)
 {
     sd_init_fsm_state_t state = SD_INIT_START;
@@ -567,6 +575,24 @@ static inline int _transfer_bytes(sdcard_spi_t *card, const uint8_t *out, uint8_
     unsigned trans_bytes = 0;
     uint8_t in_temp;
 
+    if (_dyn_spi_rxtx_byte == &_hw_spi_rxtx_byte) {
+        /* transfer blocks at once instead of calling the driver per byte */
+        if (out != NULL) {
+            spi_transfer_bytes(card->params.spi_dev, SPI_CS_UNDEF, true, out, in, length);
+            return length;
+        }
+        while (trans_bytes < length) {
+            unsigned chunk = length - trans_bytes;
+            if (chunk > sizeof(_dummy_bytes)) {
+                chunk = sizeof(_dummy_bytes);
+            }
+            spi_transfer_bytes(card->params.spi_dev, SPI_CS_UNDEF, true, _dummy_bytes,
+                               (in != NULL) ? &in[trans_bytes] : NULL, chunk);
+            trans_bytes += chunk;
+        }
+        return trans_bytes;
+    }
+
     for (trans_bytes = 0; trans_bytes < length; trans_bytes++) {
         if (out != NULL) {
             trans_ret = _dyn_spi_rxtx_byte(card, out[trans_bytes], &in_temp);
@@ -608,7 +634,7 @@ static sd_rw_response_t _read_data_packet(sdcard_spi_t *card, uint8_t token, uin
         if (_transfer_bytes(card, 0, crc_bytes, sizeof(crc_bytes)) == sizeof(crc_bytes)) {
             uint16_t data_crc16 = (crc_bytes[0] << 8) | crc_bytes[1];
 
-            if (ucrc16_calc_be((uint8_t *)data, size, UCRC16_CCITT_POLY_BE, 0) == data_crc16) {
+            if (crc16_ccitt_update(0, data, size) == data_crc16) {
                 DEBUG("_read_data_packet: [OK]\n");
                 return SD_RW_OK;
             }
@@ -696,7 +722,7 @@ static sd_rw_response_t _write_data_packet(sdcard_spi_t *card, uint8_t token, co
 
     if (_transfer_bytes(card, data, 0, size) == size) {
 
-        uint16_t data_crc16 = ucrc16_calc_be((uint8_t *)data, size, UCRC16_CCITT_POLY_BE, 0);
+        uint16_t data_crc16 = crc16_ccitt_update(0, data, size);
         uint8_t crc[sizeof(uint16_t)] = { data_crc16 >> 8, data_crc16 & 0xFF };
 
         if (_transfer_bytes(card, crc, 0, sizeof(crc)) == sizeof(crc)) {
@@ -748,6 +774,15 @@ static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr,
     _select_card_spi(card);
     int written = 0;
 
+    /* let the card pre-erase the blocks, this is only a hint so errors are
+       ignored */
+    if (cmd_idx == SD_CMD_25) {
+        uint8_t acmd_r1_resu = sdcard_spi_send_acmd(card, SD_CMD_23, nbl, 0);
+        if (!R1_VALID(acmd_r1_resu) || R1_ERROR(acmd_r1_resu)) {
+            DEBUG("_write_blocks: send ACMD23: [FAILED]\n");
+        }
+    }
+
     uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
     uint8_t cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, SD_BLOCK_WRITE_CMD_RETRIES);
 
@@ -790,9 +825,11 @@ static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr,
                state */
             _send_dummy_byte(card);
             if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
-                _unselect_card_spi(card);
                 *state = SD_RW_TIMEOUT;
             }
+            else {
+                *state = SD_RW_OK;
+            }
         }
         else {
             DEBUG("_write_blocks: write single block: [OK]\n");
@@ -95,9 +95,9 @@ DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
         return RES_PARERR;
     }
 
-    int res = mtd_read(fatfs_mtd_devs[pdrv], buff,
-                       sector * fatfs_mtd_devs[pdrv]->page_size,
-                       count * fatfs_mtd_devs[pdrv]->page_size);
+    /* read all sectors at once, allowing for bulk transfers */
+    int res = mtd_read_page(fatfs_mtd_devs[pdrv], buff, sector, 0,
+                            count * fatfs_mtd_devs[pdrv]->page_size);
 
     if (res >= 0) {
         uint32_t r_sect = ((unsigned)res) / fatfs_mtd_devs[pdrv]->page_size;
@@ -135,9 +135,9 @@ DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
         return RES_ERROR; /* erase failed! */
     }
 
-    res = mtd_write(fatfs_mtd_devs[pdrv], buff,
-                    sector * fatfs_mtd_devs[pdrv]->page_size,
-                    count * fatfs_mtd_devs[pdrv]->page_size);
+    /* write all sectors at once, allowing for bulk transfers */
+    res = mtd_write_page(fatfs_mtd_devs[pdrv], buff, sector, 0,
+                         count * fatfs_mtd_devs[pdrv]->page_size);
 
     if (res >= 0) {
         uint32_t w_sect = ((unsigned)res) / fatfs_mtd_devs[pdrv]->page_size;
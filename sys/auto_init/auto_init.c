@@ -96,6 +96,14 @@
 #include "schedstatistics.h"
 #endif
 
+#ifdef MODULE_TRACE_KERNEL
+#include "trace_kernel.h"
+#endif
+
+#ifdef MODULE_LOG_BINARY
+#include "log.h"
+#endif
+
 #ifdef MODULE_TEST_UTILS_INTERACTIVE_SYNC
 #if !defined(MODULE_SHELL_COMMANDS) || !defined(MODULE_SHELL)
 #include "test_utils/interactive_sync.h"
@@ -118,6 +126,12 @@ void auto_init(void)
 #ifdef MODULE_SCHEDSTATISTICS
     init_schedstatistics();
 #endif
+#ifdef MODULE_TRACE_KERNEL
+    trace_kernel_init();
+#endif
+#if defined(MODULE_LOG_BINARY) && LOG_BINARY_THREAD
+    log_binary_init();
+#endif
 #ifdef MODULE_MCI
     DEBUG("Auto init mci module.\n");
     mci_initialize();
@@ -21,6 +21,7 @@
 #include <stdio.h>
 
 #include "benchmark.h"
+#include "matstat.h"
 
 void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
 {
@@ -34,3 +35,111 @@ void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
            "  ---  %9" PRIu32 " calls per sec\n",
            name, time, full, div, per_sec);
 }
+
+void benchmark_result_init(benchmark_result_t *res, const char *name,
+                           unsigned long runs)
+{
+    res->name = name;
+    res->runs = runs;
+    res->samples = 0;
+    benchmark_clock_init();
+}
+
+void benchmark_result_add(benchmark_result_t *res, uint32_t ticks)
+{
+    if (res->samples < BENCHMARK_SAMPLES_MAX) {
+        res->ticks[res->samples++] = ticks;
+    }
+}
+
+int benchmark_run(benchmark_result_t *res, unsigned samples,
+                  benchmark_sample_t sample, void *arg)
+{
+    for (unsigned s = 0; s < (BENCHMARK_WARMUP_SAMPLES + samples); s++) {
+        uint32_t time = benchmark_clock();
+        int err = sample(arg);
+
+        time = benchmark_clock() - time;
+        if (err < 0) {
+            return err;
+        }
+        if (s >= BENCHMARK_WARMUP_SAMPLES) {
+            benchmark_result_add(res, time);
+        }
+    }
+    benchmark_result_print(res);
+    return 0;
+}
+
+uint32_t benchmark_result_mean(const benchmark_result_t *res)
+{
+    uint64_t sum = 0;
+
+    if (res->samples == 0) {
+        return 0;
+    }
+    for (unsigned i = 0; i < res->samples; i++) {
+        sum += res->ticks[i];
+    }
+    return sum / res->samples;
+}
+
+static int32_t _ns_per_call(const benchmark_result_t *res, uint32_t ticks)
+{
+    uint64_t ns = ((uint64_t)ticks * 1000000000ULL) /
+                  ((uint64_t)BENCHMARK_CLOCK_HZ * res->runs);
+
+    return (ns > INT32_MAX) ? INT32_MAX : (int32_t)ns;
+}
+
+static uint32_t _isqrt(uint64_t val)
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > val) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (val >= res + bit) {
+            val -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+void benchmark_result_print(const benchmark_result_t *res)
+{
+    int32_t ns[BENCHMARK_SAMPLES_MAX];
+    matstat_state_t stat = MATSTAT_STATE_INIT;
+    unsigned num = res->samples;
+
+    if ((num == 0) || (res->runs == 0)) {
+        printf("{\"benchmark\": \"%s\", \"samples\": 0}\n", res->name);
+        return;
+    }
+    /* insertion sort, there are only a few samples */
+    for (unsigned i = 0; i < num; i++) {
+        int32_t val = _ns_per_call(res, res->ticks[i]);
+        unsigned j = i;
+
+        matstat_add(&stat, val);
+        for (; (j > 0) && (ns[j - 1] > val); j--) {
+            ns[j] = ns[j - 1];
+        }
+        ns[j] = val;
+    }
+    printf("{\"benchmark\": \"%s\", \"runs\": %lu, \"samples\": %u, "
+           "\"unit\": \"ns\", \"min\": %" PRId32 ", \"median\": %" PRId32 ", "
+           "\"p99\": %" PRId32 ", \"max\": %" PRId32 ", \"mean\": %" PRId32 ", "
+           "\"stddev\": %" PRIu32 "}\n",
+           res->name, res->runs, num, stat.min,
+           (num & 1) ? ns[num / 2] : (ns[num / 2 - 1] + ns[num / 2]) / 2,
+           ns[(num * 99 + 99) / 100 - 1], stat.max, matstat_mean(&stat),
+           _isqrt(matstat_variance(&stat)));
+}
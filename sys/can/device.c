@@ -51,6 +51,7 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
 {
     msg_t msg;
     struct can_frame *frame;
+    candev_rx_batch_t *batch;
     can_pkt_t *pkt;
     candev_dev_t *candev_dev = dev->isr_arg;
 
@@ -94,6 +95,16 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
         frame = (struct can_frame *) arg;
         can_dll_dispatch_rx_frame(frame, candev_dev->pid);
         break;
+    case CANDEV_EVENT_RX_BATCH:
+        DEBUG("_can_event: CANDEV_EVENT_RX_BATCH\n");
+#ifdef MODULE_CAN_PM
+        pm_reset(candev_dev, candev_dev->rx_inactivity_timeout);
+#endif
+        /* received frames in arg */
+        batch = (candev_rx_batch_t *)arg;
+        can_dll_dispatch_rx_batch(batch->frames, batch->count,
+                                  candev_dev->pid);
+        break;
     case CANDEV_EVENT_RX_ERROR:
         DEBUG("_can_event: CANDEV_EVENT_RX_ERROR\n");
         break;
@@ -357,6 +357,34 @@ int can_dll_dispatch_rx_frame(struct can_frame *frame, kernel_pid_t pid)
     return can_router_dispatch_rx_indic(pkt);
 }
 
+int can_dll_dispatch_rx_batch(struct can_frame *frames, unsigned count,
+                              kernel_pid_t pid)
+{
+    can_pkt_t *pkts[CAN_DLL_RX_BATCH_SIZE];
+    int ifnum = _get_ifnum(pid);
+    int res = 0;
+
+    while (count) {
+        unsigned n = 0;
+
+        while (count && (n < CAN_DLL_RX_BATCH_SIZE)) {
+            pkts[n] = can_pkt_alloc_rx(ifnum, frames++);
+            count--;
+            if (!pkts[n]) {
+                DEBUG("can_dll_dispatch_rx_batch: out of pkts\n");
+                res = -ENOMEM;
+                continue;
+            }
+            n++;
+        }
+        if (can_router_dispatch_rx_batch(pkts, n) < 0) {
+            res = -ENOMEM;
+        }
+    }
+
+    return res;
+}
+
 static int _remove_entry_from_list(can_reg_entry_t **list, can_reg_entry_t *entry)
 {
     assert(list);
@@ -91,6 +91,7 @@ static mutex_t lock = MUTEX_INIT;
 static void _rx_timeout(void *arg);
 static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status);
 static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame);
+static void _isotp_next_cf(struct isotp *isotp);
 
 static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 {
@@ -141,8 +142,11 @@ static int _isotp_dispatch_tx(struct isotp *isotp, int err)
 {
     msg_t msg;
 
-    gnrc_pktbuf_release(isotp->tx.snip);
-    isotp->tx.snip = NULL;
+    if (isotp->tx.snip) {
+        gnrc_pktbuf_release(isotp->tx.snip);
+        isotp->tx.snip = NULL;
+    }
+    isotp->tx.iol = NULL;
 
     if (isotp->opt.flags & CAN_ISOTP_TX_DONT_WAIT) {
         return 0;
@@ -228,8 +232,7 @@ static int _isotp_rcv_fc(struct isotp *isotp, struct can_frame *frame, int ae)
     case ISOTP_FC_CTS:
         isotp->tx_wft = 0;
         isotp->tx.bs = 0;
-        isotp->tx.state = ISOTP_SENDING_NEXT_CF;
-        xtimer_set(&isotp->tx_timer, isotp->tx_gap);
+        _isotp_next_cf(isotp);
         break;
 
     case ISOTP_FC_WT:
@@ -468,6 +471,31 @@ static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status)
     }
 }
 
+/* copy the next @p len bytes to send to @p dst */
+static void _isotp_tx_read(struct isotp *isotp, uint8_t *dst, size_t len)
+{
+    if (isotp->tx.snip) {
+        memcpy(dst, (uint8_t *)isotp->tx.snip->data + isotp->tx.idx, len);
+        isotp->tx.idx += len;
+        return;
+    }
+
+    while (len) {
+        const iolist_t *iol = isotp->tx.iol;
+        size_t num = MIN(len, iol->iol_len - isotp->tx.iol_off);
+
+        memcpy(dst, (uint8_t *)iol->iol_base + isotp->tx.iol_off, num);
+        dst += num;
+        len -= num;
+        isotp->tx.idx += num;
+        isotp->tx.iol_off += num;
+        if (isotp->tx.iol_off == iol->iol_len) {
+            isotp->tx.iol = iol->iol_next;
+            isotp->tx.iol_off = 0;
+        }
+    }
+}
+
 static void _isotp_create_ff(struct isotp *isotp, struct can_frame *frame, int ae)
 {
 
@@ -478,12 +506,11 @@ static void _isotp_create_ff(struct isotp *isotp, struct can_frame *frame, int a
         frame->data[0] = isotp->opt.ext_address;
     }
 
-    frame->data[ae] = (uint8_t)(isotp->tx.snip->size >> 8) | N_PCI_FF;
-    frame->data[ae + 1] = (uint8_t) isotp->tx.snip->size & 0xFFU;
+    frame->data[ae] = (uint8_t)(isotp->tx.len >> 8) | N_PCI_FF;
+    frame->data[ae + 1] = (uint8_t) isotp->tx.len & 0xFFU;
 
-    for (int i = ae + FF_PCI_SZ; i < CAN_MAX_DLEN; i++) {
-        frame->data[i] = ((uint8_t *)isotp->tx.snip->data)[isotp->tx.idx++];
-    }
+    _isotp_tx_read(isotp, &frame->data[ae + FF_PCI_SZ],
+                   CAN_MAX_DLEN - (ae + FF_PCI_SZ));
 
     isotp->tx.sn = 1;
 }
@@ -492,7 +519,7 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 {
     size_t pci_len = N_PCI_SZ + ae;
     size_t space = CAN_MAX_DLEN - pci_len;
-    size_t num_bytes = MIN(space, isotp->tx.snip->size - isotp->tx.idx);
+    size_t num_bytes = MIN(space, isotp->tx.len - isotp->tx.idx);
 
     frame->can_id = isotp->opt.tx_id;
     frame->can_dlc = num_bytes + pci_len;
@@ -506,9 +533,7 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
         }
     }
 
-    for (size_t i = 0; i < num_bytes; i++) {
-        frame->data[pci_len + i] = ((uint8_t *)isotp->tx.snip->data)[isotp->tx.idx++];
-    }
+    _isotp_tx_read(isotp, &frame->data[pci_len], num_bytes);
 
     if (ae) {
         frame->data[0] = isotp->opt.ext_address;
@@ -516,11 +541,43 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 
 }
 
-static void _isotp_tx_timeout_task(struct isotp *isotp)
+static void _isotp_send_cf(struct isotp *isotp)
 {
     int ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
-    struct can_frame frame;
+    /* without STmin several CFs of the block are handed to the DLL at once,
+     * only the confirmation of the last one is waited for */
+    unsigned num = isotp->tx_gap ? 1 : CAN_ISOTP_TX_PIPELINE;
+
+    do {
+        struct can_frame frame;
+
+        _isotp_fill_dataframe(isotp, &frame, ae);
+        frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
+        isotp->tx.sn %= 16;
+        isotp->tx.bs++;
 
+        isotp->tx.state = ISOTP_SENDING_CF;
+        _isotp_tx_send(isotp, &frame);
+    } while ((isotp->tx.state == ISOTP_SENDING_CF) && --num &&
+             (isotp->tx.idx < isotp->tx.len) &&
+             (!isotp->txfc.bs || (isotp->tx.bs < isotp->txfc.bs)));
+}
+
+static void _isotp_next_cf(struct isotp *isotp)
+{
+    isotp->tx.state = ISOTP_SENDING_NEXT_CF;
+
+    if (isotp->tx_gap) {
+        xtimer_set(&isotp->tx_timer, isotp->tx_gap);
+    }
+    else {
+        /* no need to go through the timer */
+        _isotp_send_cf(isotp);
+    }
+}
+
+static void _isotp_tx_timeout_task(struct isotp *isotp)
+{
     DEBUG("_isotp_tx_timeout_task: state=%d\n", isotp->tx.state);
 
     switch (isotp->tx.state) {
@@ -532,13 +589,7 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
 
     case ISOTP_SENDING_NEXT_CF:
         DEBUG("_isotp_tx_timeout_task: sending next CF\n");
-        _isotp_fill_dataframe(isotp, &frame, ae);
-        frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
-        isotp->tx.sn %= 16;
-        isotp->tx.bs++;
-
-        isotp->tx.state = ISOTP_SENDING_CF;
-        _isotp_tx_send(isotp, &frame);
+        _isotp_send_cf(isotp);
         break;
 
     case ISOTP_SENDING_CF:
@@ -571,7 +622,7 @@ static void _isotp_tx_tx_conf(struct isotp *isotp)
         break;
 
     case ISOTP_SENDING_CF:
-        if (isotp->tx.idx >= isotp->tx.snip->size) {
+        if (isotp->tx.idx >= isotp->tx.len) {
             /* Finished */
             isotp->tx.state = ISOTP_IDLE;
             _isotp_dispatch_tx(isotp, 0);
@@ -585,8 +636,7 @@ static void _isotp_tx_tx_conf(struct isotp *isotp)
             break;
         }
 
-        isotp->tx.state = ISOTP_SENDING_NEXT_CF;
-        xtimer_set(&isotp->tx_timer, isotp->tx_gap);
+        _isotp_next_cf(isotp);
         break;
     }
 }
@@ -642,12 +692,12 @@ static int _isotp_send_sf_ff(struct isotp *isotp)
     struct can_frame frame;
     unsigned ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
 
-    if (isotp->tx.snip->size <= CAN_MAX_DLEN - SF_PCI_SZ - ae) {
+    if (isotp->tx.len <= CAN_MAX_DLEN - SF_PCI_SZ - ae) {
         /* Fits into a single frame */
         _isotp_fill_dataframe(isotp, &frame, ae);
 
         frame.data[ae] = N_PCI_SF;
-        frame.data[ae] |= isotp->tx.snip->size;
+        frame.data[ae] |= isotp->tx.len;
 
         isotp->tx.state = ISOTP_SENDING_SF;
     }
@@ -740,6 +790,24 @@ kernel_pid_t isotp_init(char *stack, int stacksize, char priority, const char *n
     return res;
 }
 
+static void _isotp_start_tx(struct isotp *isotp, unsigned len, int flags)
+{
+    if (flags) {
+        isotp->opt.flags &= CAN_ISOTP_RX_FLAGS_MASK;
+        isotp->opt.flags |= (flags & CAN_ISOTP_TX_FLAGS_MASK);
+    }
+
+    isotp->tx.len = len;
+    isotp->tx.idx = 0;
+
+    isotp->tx_wft = 0;
+
+    msg_t msg;
+    msg.type = CAN_MSG_SEND_FRAME;
+    msg.content.ptr = isotp;
+    msg_send(&msg, isotp_pid);
+}
+
 int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
 {
     assert(isotp != NULL);
@@ -755,11 +823,6 @@ int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
         return -EBUSY;
     }
 
-    if (flags) {
-        isotp->opt.flags &= CAN_ISOTP_RX_FLAGS_MASK;
-        isotp->opt.flags |= (flags & CAN_ISOTP_TX_FLAGS_MASK);
-    }
-
     gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
     if (!snip) {
         return -ENOMEM;
@@ -768,14 +831,36 @@ int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
 
     memcpy(isotp->tx.snip->data, buf, len);
 
-    isotp->tx.idx = 0;
+    _isotp_start_tx(isotp, len, flags);
 
-    isotp->tx_wft = 0;
+    return len;
+}
 
-    msg_t msg;
-    msg.type = CAN_MSG_SEND_FRAME;
-    msg.content.ptr = isotp;
-    msg_send(&msg, isotp_pid);
+int isotp_send_iolist(struct isotp *isotp, const iolist_t *iolist, int flags)
+{
+    assert(isotp != NULL);
+#ifdef MODULE_CAN_MBOX
+    assert((isotp->entry.type == CAN_TYPE_DEFAULT && pid_is_valid(isotp->entry.target.pid)) ||
+           (isotp->entry.type == CAN_TYPE_MBOX && isotp->entry.target.mbox != NULL));
+#else
+    assert(isotp->entry.target.pid != KERNEL_PID_UNDEF);
+#endif
+
+    size_t len = iolist_size(iolist);
+
+    if (!len || (len > MAX_MSG_LENGTH) || (flags & CAN_ISOTP_TX_DONT_WAIT)) {
+        return -EINVAL;
+    }
+
+    if (isotp->tx.state != ISOTP_IDLE) {
+        return -EBUSY;
+    }
+
+    isotp->tx.snip = NULL;
+    isotp->tx.iol = iolist;
+    isotp->tx.iol_off = 0;
+
+    _isotp_start_tx(isotp, len, flags);
 
     return len;
 }
@@ -843,6 +928,19 @@ int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg,
     return 0;
 }
 
+void isotp_set_fc(struct isotp *isotp, const struct isotp_fc_options *fc_options)
+{
+    assert(isotp != NULL);
+    assert(fc_options != NULL);
+
+    DEBUG("isotp_set_fc: bs=%" PRIu8 ", stmin=0x%" PRIx8 ", wftmax=%" PRIu8 "\n",
+          fc_options->bs, fc_options->stmin, fc_options->wftmax);
+
+    isotp->rxfc.bs = fc_options->bs;
+    isotp->rxfc.stmin = fc_options->stmin;
+    isotp->txfc.wftmax = fc_options->wftmax;
+}
+
 void isotp_free_rx(can_rx_data_t *rx)
 {
     DEBUG("isotp_free_rx: rx=%p\n", (void *)rx);
@@ -888,6 +986,7 @@ int isotp_release(struct isotp *isotp)
         gnrc_pktbuf_release(isotp->tx.snip);
         isotp->tx.snip = NULL;
     }
+    isotp->tx.iol = NULL;
     isotp->tx.state = ISOTP_IDLE;
 
     return 0;
@@ -21,6 +21,7 @@
 #include <limits.h>
 #include <errno.h>
 
+#include "irq.h"
 #include "memarray.h"
 #include "can/pkt.h"
 #include "mutex.h"
@@ -37,25 +38,48 @@ static mutex_t _mutex = MUTEX_INIT;
 #define CAN_PKT_BUF_SIZE    128
 #endif
 
+/* one rx data per packet and receiver */
+#ifndef CAN_PKT_RX_DATA_BUF_SIZE
+#define CAN_PKT_RX_DATA_BUF_SIZE    CAN_PKT_BUF_SIZE
+#endif
+
 static can_pkt_t _pkt_buf[CAN_PKT_BUF_SIZE];
 static memarray_t _pkt_array;
 
+static can_rx_data_t _rx_data_buf[CAN_PKT_RX_DATA_BUF_SIZE];
+static memarray_t _rx_data_array;
+
 void can_pkt_init(void)
 {
-    static_assert(sizeof(can_pkt_t) >= sizeof(can_rx_data_t), "sizeof(can_rx_data_t) must be at most sizeof(can_pkt_t)");
     mutex_lock(&_mutex);
     handle = 1;
     memarray_init(&_pkt_array, _pkt_buf, sizeof(can_pkt_t), CAN_PKT_BUF_SIZE);
+    memarray_init(&_rx_data_array, _rx_data_buf, sizeof(can_rx_data_t),
+                  CAN_PKT_RX_DATA_BUF_SIZE);
     mutex_unlock(&_mutex);
 }
 
-static can_pkt_t *_pkt_alloc(int ifnum, const struct can_frame *frame)
+/* the pools are used by the router in interrupt context, so they are
+ * protected by disabling interrupts instead of by the mutex */
+static void *_pool_alloc(memarray_t *pool)
 {
-    can_pkt_t *pkt;
+    unsigned state = irq_disable();
+    void *ptr = memarray_alloc(pool);
+    irq_restore(state);
 
-    mutex_lock(&_mutex);
-    pkt = memarray_alloc(&_pkt_array);
-    mutex_unlock(&_mutex);
+    return ptr;
+}
+
+static void _pool_free(memarray_t *pool, void *ptr)
+{
+    unsigned state = irq_disable();
+    memarray_free(pool, ptr);
+    irq_restore(state);
+}
+
+static can_pkt_t *_pkt_alloc(int ifnum, const struct can_frame *frame)
+{
+    can_pkt_t *pkt = _pool_alloc(&_pkt_array);
 
     if (!pkt) {
         return NULL;
@@ -139,18 +163,12 @@ void can_pkt_free(can_pkt_t *pkt)
 
     DEBUG("can_pkt_free: free pkt=%p\n", (void*)pkt);
 
-    mutex_lock(&_mutex);
-    memarray_free(&_pkt_array, pkt);
-    mutex_unlock(&_mutex);
+    _pool_free(&_pkt_array, pkt);
 }
 
 can_rx_data_t *can_pkt_alloc_rx_data(void *data, size_t len, void *arg)
 {
-    can_rx_data_t *rx;
-
-    mutex_lock(&_mutex);
-    rx = memarray_alloc(&_pkt_array);
-    mutex_unlock(&_mutex);
+    can_rx_data_t *rx = _pool_alloc(&_rx_data_array);
 
     DEBUG("can_pkt_alloc_rx_data: rx=%p\n", (void *)rx);
 
@@ -173,7 +191,5 @@ void can_pkt_free_rx_data(can_rx_data_t *data)
 
     DEBUG("can_pkt_free_rx_data: rx=%p\n", (void *)data);
 
-    mutex_lock(&_mutex);
-    memarray_free(&_pkt_array, data);
-    mutex_unlock(&_mutex);
+    _pool_free(&_rx_data_array, data);
 }
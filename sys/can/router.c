@@ -28,6 +28,7 @@
 #include "utlist.h"
 #include "mutex.h"
 #include "assert.h"
+#include "irq.h"
 #include "memarray.h"
 
 #ifdef MODULE_CAN_MBOX
@@ -49,17 +50,50 @@ typedef struct filter_el {
     canid_t can_id;          /**< CAN ID of the element */
     canid_t mask;            /**< Mask of the element */
     void *data;              /**< Private data */
+    struct filter_el *unused_next; /**< next unregistered element to free */
 } filter_el_t;
 
-/**
- * This table contains @p CAN_ROUTER_APP_MAX lists of CAN IDs per interface
- */
-static can_reg_entry_t *table[CAN_DLL_NUMOF];
-
 #ifndef CAN_ROUTER_MAX_FILTER
 #define CAN_ROUTER_MAX_FILTER   64
 #endif
 
+/* number of hash buckets per interface, must be a power of two */
+#ifndef CAN_ROUTER_HASH_SIZE
+#define CAN_ROUTER_HASH_SIZE    32
+#endif
+
+/* number of distinct masks per interface whose filters are hashed */
+#ifndef CAN_ROUTER_MASK_GROUPS
+#define CAN_ROUTER_MASK_GROUPS  4
+#endif
+
+/**
+ * Filters of an interface
+ *
+ * Filters whose mask is one of the group masks (e.g. CAN_SFF_MASK for all
+ * standard IDs) are stored in the hash bucket of their CAN ID, so a frame is
+ * matched with one bucket look-up per group. Filters registered while all
+ * groups were in use by other masks are kept in the masked list, which is
+ * walked for every frame.
+ */
+typedef struct {
+    can_reg_entry_t *buckets[CAN_ROUTER_HASH_SIZE]; /**< hashed filters */
+    can_reg_entry_t *masked;                        /**< other filters */
+    canid_t group_mask[CAN_ROUTER_MASK_GROUPS];     /**< hashed masks */
+    uint16_t group_users[CAN_ROUTER_MASK_GROUPS];   /**< filters per group */
+} filter_table_t;
+
+/**
+ * Filters per interface
+ *
+ * Changed with interrupts disabled, so they can be read, also in interrupt
+ * context, without taking @p lock, which only serializes the writers.
+ * Unregistered elements are freed by the last reader.
+ */
+static filter_table_t table[CAN_DLL_NUMOF];
+static unsigned _readers;
+static filter_el_t *_unused;
+
 static filter_el_t _filter_buf[CAN_ROUTER_MAX_FILTER];
 static memarray_t _filter_array;
 static mutex_t lock = MUTEX_INIT;
@@ -70,17 +104,48 @@ static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el);
 static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data);
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask);
 
+static inline unsigned _hash(canid_t can_id)
+{
+    return (can_id ^ (can_id >> 8) ^ (can_id >> 16)) & (CAN_ROUTER_HASH_SIZE - 1);
+}
+
+static int _find_group(const filter_table_t *t, canid_t mask)
+{
+    for (unsigned g = 0; g < CAN_ROUTER_MASK_GROUPS; g++) {
+        if (t->group_users[g] && (t->group_mask[g] == mask)) {
+            return g;
+        }
+    }
+    return -1;
+}
+
+/* returns the lists a filter with @p can_id and @p mask can be in */
+static void _lists_of(filter_table_t *t, canid_t can_id, canid_t mask,
+                      can_reg_entry_t ***lists)
+{
+    lists[0] = (_find_group(t, mask) >= 0) ? &t->buckets[_hash(can_id)] : NULL;
+    lists[1] = &t->masked;
+}
+
 #if ENABLE_DEBUG
+static void _print_list(can_reg_entry_t *list)
+{
+    can_reg_entry_t *entry;
+    LL_FOREACH(list, entry) {
+        filter_el_t *el = container_of(entry, filter_el_t, entry);
+        DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
+              el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+    }
+}
+
 static void _print_filters(void)
 {
     for (int i = 0; i < (int)CAN_DLL_NUMOF; i++) {
         DEBUG("--- Ifnum: %d ---\n", i);
-        can_reg_entry_t *entry;
-        LL_FOREACH(table[i], entry) {
-            filter_el_t *el = container_of(entry, filter_el_t, entry);
-            DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
-                  el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+        for (unsigned b = 0; b < CAN_ROUTER_HASH_SIZE; b++) {
+            _print_list(table[i].buckets[b]);
         }
+        _print_list(table[i].masked);
     }
 }
 
@@ -98,7 +163,9 @@ void can_router_init(void)
 static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data)
 {
     filter_el_t *el;
+    unsigned state = irq_disable();
     el = memarray_alloc(&_filter_array);
+    irq_restore(state);
     if (!el) {
         DEBUG("can_router: _alloc_canid_el: out of memory\n");
         return NULL;
@@ -120,7 +187,16 @@ static void _free_filter_el(filter_el_t *el)
     DEBUG("_free_canid_el: el freed with can_id=0x%" PRIx32 ", mask=0x%" PRIx32
           ", data=%p\n", el->can_id, el->mask, el->data);
 
-    memarray_free(&_filter_array, el);
+    unsigned state = irq_disable();
+    if (_readers) {
+        /* still in use by can_router_dispatch_rx_indic() */
+        el->unused_next = _unused;
+        _unused = el;
+    }
+    else {
+        memarray_free(&_filter_array, el);
+    }
+    irq_restore(state);
 }
 
 /* Insert to the list in a sorted way
@@ -188,19 +264,23 @@ static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entr
 
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
 {
-    filter_el_t *el = container_of(table[ifnum], filter_el_t, entry);
-    if (!el) {
-        DEBUG("_filter_is_used: empty list\n");
-        return 0;
-    }
-    do {
-        if ((el->can_id == can_id) && (el->mask == mask)) {
-            DEBUG("_filter_is_used: found el=%p, can_id=%" PRIx32 ", mask=%" PRIx32 ", data=%p\n",
-                  (void *)el, el->can_id, el->mask, el->data);
-            return 1;
+    can_reg_entry_t **lists[2];
+
+    _lists_of(&table[ifnum], can_id, mask, lists);
+    for (unsigned i = 0; i < ARRAY_SIZE(lists); i++) {
+        if (!lists[i]) {
+            continue;
         }
-        el = container_of(el->entry.next, filter_el_t, entry);
-    }  while (el);
+        filter_el_t *el = container_of(*lists[i], filter_el_t, entry);
+        while (el) {
+            if ((el->can_id == can_id) && (el->mask == mask)) {
+                DEBUG("_filter_is_used: found el=%p, can_id=%" PRIx32 ", mask=%" PRIx32 ", data=%p\n",
+                      (void *)el, el->can_id, el->mask, el->data);
+                return 1;
+            }
+            el = container_of(el->entry.next, filter_el_t, entry);
+        }
+    }
 
     DEBUG("_filter_is_used: filter not found\n");
 
@@ -247,7 +327,26 @@ int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, vo
     filter->entry.target.pid = entry->target.pid;
 #endif
     filter->entry.ifnum = entry->ifnum;
-    _insert_to_list(&table[entry->ifnum], filter);
+
+    filter_table_t *t = &table[entry->ifnum];
+    unsigned state = irq_disable();
+    int g = _find_group(t, mask);
+    for (unsigned i = 0; (g < 0) && (i < CAN_ROUTER_MASK_GROUPS); i++) {
+        /* hash the filter if a group is free, filters with the same mask that
+         * are already in the masked list stay there */
+        if (t->group_users[i] == 0) {
+            g = i;
+            t->group_mask[g] = mask;
+        }
+    }
+    if (g >= 0) {
+        t->group_users[g]++;
+        _insert_to_list(&t->buckets[_hash(can_id)], filter);
+    }
+    else {
+        _insert_to_list(&t->masked, filter);
+    }
+    irq_restore(state);
     mutex_unlock(&lock);
 
     PRINT_FILTERS();
@@ -273,12 +372,28 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
 #endif
 
     mutex_lock(&lock);
-    el = _find_filter_el(table[entry->ifnum], entry, can_id, mask, param);
+    filter_table_t *t = &table[entry->ifnum];
+    can_reg_entry_t **lists[2];
+    unsigned i;
+    el = NULL;
+    _lists_of(t, can_id, mask, lists);
+    for (i = 0; !el && (i < ARRAY_SIZE(lists)); i++) {
+        if (lists[i]) {
+            el = _find_filter_el(*lists[i], entry, can_id, mask, param);
+        }
+    }
     if (!el) {
         mutex_unlock(&lock);
         return -EINVAL;
     }
-    LL_DELETE(table[entry->ifnum], &el->entry);
+    /* readers keep working on an unlinked element, as its next pointer stays
+     * valid until it is freed */
+    unsigned state = irq_disable();
+    LL_DELETE(*lists[i - 1], &el->entry);
+    if (lists[i - 1] != &t->masked) {
+        t->group_users[_find_group(t, mask)]--;
+    }
+    irq_restore(state);
     _free_filter_el(el);
     ret = _filter_is_used(entry->ifnum, can_id, mask);
     mutex_unlock(&lock);
@@ -305,14 +420,50 @@ static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 #endif
 }
 
-/* send received pkt to all interested users */
-int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+static int _deliver(can_pkt_t *pkt, msg_t *msg, filter_el_t *el)
 {
-    if (!pkt) {
-        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
-        return -EINVAL;
+    DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
+          (void *)el, (void *)el->data);
+    DEBUG("can_router_dispatch_rx_indic: rx_ind to pid: %"
+          PRIkernel_pid "\n", el->entry.target.pid);
+    atomic_fetch_add(&pkt->ref_count, 1);
+    msg->content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
+    if (!msg->content.ptr || (_send_msg(msg, &el->entry) <= 0)) {
+        can_pkt_free_rx_data(msg->content.ptr);
+        atomic_fetch_sub(&pkt->ref_count, 1);
+        DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
+              "pid=%" PRIkernel_pid "\n", el->entry.target.pid);
+        return -EBUSY;
     }
+    return 0;
+}
+
+static void _reader_enter(void)
+{
+    unsigned state = irq_disable();
+    _readers++;
+    irq_restore(state);
+}
 
+static void _reader_leave(void)
+{
+    unsigned state = irq_disable();
+    filter_el_t *unused = NULL;
+    if (--_readers == 0) {
+        unused = _unused;
+        _unused = NULL;
+    }
+    while (unused) {
+        filter_el_t *el = unused;
+        unused = el->unused_next;
+        memarray_free(&_filter_array, el);
+    }
+    irq_restore(state);
+}
+
+/* send received pkt to all interested users, the caller is a reader */
+static int _dispatch_rx(can_pkt_t *pkt)
+{
     int res = 0;
     msg_t msg;
     msg.type = CAN_MSG_RX_INDICATION;
@@ -322,42 +473,88 @@ int can_router_dispatch_rx_indic(can_pkt_t *pkt)
     DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
           (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
 
-    mutex_lock(&lock);
+    filter_table_t *t = &table[pkt->entry.ifnum];
     can_reg_entry_t *entry = NULL;
     filter_el_t *el;
-    LL_FOREACH(table[pkt->entry.ifnum], entry) {
+    /* subscribers preempting the dispatch may free their reference before
+     * the frame is delivered to the others */
+    atomic_fetch_add(&pkt->ref_count, 1);
+    for (unsigned g = 0; g < CAN_ROUTER_MASK_GROUPS; g++) {
+        if (!t->group_users[g]) {
+            continue;
+        }
+        canid_t mask = t->group_mask[g];
+        canid_t can_id = pkt->frame.can_id & mask;
+        LL_FOREACH(t->buckets[_hash(can_id)], entry) {
+            el = container_of(entry, filter_el_t, entry);
+            if ((el->mask == mask) && (el->can_id == can_id)) {
+#if ENABLE_DEBUG
+                msg_cnt++;
+#endif
+                if (_deliver(pkt, &msg, el) < 0) {
+                    res = -EBUSY;
+                    goto out;
+                }
+            }
+        }
+    }
+    LL_FOREACH(t->masked, entry) {
         el = container_of(entry, filter_el_t, entry);
         if ((pkt->frame.can_id & el->mask) == el->can_id) {
-            DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
-                  (void *)el, (void *)el->data);
-            DEBUG("can_router_dispatch_rx_indic: rx_ind to pid: %"
-                  PRIkernel_pid "\n", entry->target.pid);
-            atomic_fetch_add(&pkt->ref_count, 1);
-            msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
 #if ENABLE_DEBUG
             msg_cnt++;
 #endif
-            if (!msg.content.ptr || (_send_msg(&msg, entry) <= 0)) {
-                can_pkt_free_rx_data(msg.content.ptr);
-                atomic_fetch_sub(&pkt->ref_count, 1);
-                DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
-                      "pid=%" PRIkernel_pid "\n", entry->target.pid);
+            if (_deliver(pkt, &msg, el) < 0) {
                 res = -EBUSY;
                 break;
             }
         }
     }
-    mutex_unlock(&lock);
+out:
 #if ENABLE_DEBUG
     DEBUG("can_router_dispatch_rx: msg send to %d threads\n", msg_cnt);
 #endif
-    if (atomic_load(&pkt->ref_count) == 0) {
+    if (atomic_fetch_sub(&pkt->ref_count, 1) == 1) {
         can_pkt_free(pkt);
     }
 
     return res;
 }
 
+int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+{
+    if (!pkt) {
+        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
+        return -EINVAL;
+    }
+
+    _reader_enter();
+    int res = _dispatch_rx(pkt);
+    _reader_leave();
+
+    return res;
+}
+
+int can_router_dispatch_rx_batch(can_pkt_t **pkts, unsigned count)
+{
+    int res = 0;
+
+    DEBUG("can_router_dispatch_rx_batch: %u pkts\n", count);
+
+    _reader_enter();
+    for (unsigned i = 0; i < count; i++) {
+        if (!pkts[i]) {
+            res = -EINVAL;
+        }
+        else if (_dispatch_rx(pkts[i]) < 0) {
+            res = -EBUSY;
+        }
+    }
+    _reader_leave();
+
+    return res;
+}
+
 int can_router_dispatch_tx_conf(can_pkt_t *pkt)
 {
     msg_t msg;
@@ -400,9 +597,7 @@ int can_router_free_frame(struct can_frame *frame)
         return -1;
     }
 
-    atomic_fetch_sub(&pkt->ref_count, 1);
-
-    if (atomic_load(&pkt->ref_count) == 0) {
+    if (atomic_fetch_sub(&pkt->ref_count, 1) == 1) {
         can_pkt_free(pkt);
     }
     return 0;
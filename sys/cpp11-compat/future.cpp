@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Shared state pool of the C++11 future and promise replacement
+ *
+ * @}
+ */
+
+#include <cstdint>
+
+#include "bitarithm.h"
+#include "irq.h"
+
+#include "riot/future.hpp"
+
+static_assert(RIOT_FUTURE_POOL_SIZE <= 32,
+              "RIOT_FUTURE_POOL_SIZE must not be larger than 32");
+
+namespace riot {
+namespace detail {
+
+namespace {
+using slot = std::aligned_storage<RIOT_FUTURE_STATE_SIZE,
+                                  alignof(std::max_align_t)>::type;
+
+slot states[RIOT_FUTURE_POOL_SIZE];
+uint32_t free_slots = UINT32_MAX >> (32 - RIOT_FUTURE_POOL_SIZE);
+} // namespace
+
+void* future_state_alloc() noexcept {
+  void* res = nullptr;
+  unsigned state = irq_disable();
+  if (free_slots != 0) {
+    unsigned idx = bitarithm_lsb(free_slots);
+    free_slots &= ~(1UL << idx);
+    res = &states[idx];
+  }
+  irq_restore(state);
+  return res;
+}
+
+void future_state_free(void* ptr) noexcept {
+  unsigned idx = static_cast<slot*>(ptr) - states;
+  unsigned state = irq_disable();
+  free_slots |= (1UL << idx);
+  irq_restore(state);
+}
+
+} // namespace detail
+} // namespace riot
@@ -0,0 +1,627 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++20 coroutines running on an event queue
+ *
+ * A @ref riot::task is a coroutine that is started with
+ * @ref riot::spawn() on an @ref event_queue_t. Whenever it waits, e.g. for a
+ * timeout, a mutex or a UDP packet, it is suspended and the thread running
+ * the event loop is free to handle other events. When the awaited event
+ * happens, the coroutine is resumed from the event loop. That way many
+ * protocol flows can run on a single thread stack, while still being written
+ * as sequential code:
+ *
+ * ~~~~~~~~~~~~~~~~ {.cpp}
+ * riot::task<> flow(event_queue_t& queue, riot::udp_socket& sock)
+ * {
+ *     uint8_t buf[64];
+ *     ssize_t res = co_await sock.recv(buf, sizeof(buf), 1000000);
+ *     if (res < 0) {
+ *         co_return;
+ *     }
+ *     co_await riot::sleep_for(queue, 10000);
+ *     ...
+ * }
+ *
+ * riot::spawn(queue, flow(queue, sock));
+ * event_loop(&queue);
+ * ~~~~~~~~~~~~~~~~
+ *
+ * Tasks can also await other tasks and get their result. The frame of a
+ * coroutine is allocated with `operator new` when the coroutine is called.
+ *
+ * Awaitables are available for:
+ * - rescheduling on an event queue (@ref riot::resume_on()),
+ * - timeouts (@ref riot::sleep_for(), needs `USEMODULE += event_timeout`),
+ * - a mutex for coroutines (@ref riot::async_mutex), as blocking on a
+ *   @ref mutex_t would block all coroutines of the event loop,
+ * - receiving on a UDP sock (@ref riot::udp_socket, needs
+ *   `USEMODULE += sock_async_event`).
+ *
+ * Requires a compiler with C++20 coroutine support, e.g.
+ * `CXXEXFLAGS += -std=c++20` with GCC 11 or later (GCC 10 also needs
+ * `-fcoroutines`).
+ *
+ * @}
+ */
+
+#ifndef RIOT_COROUTINE_HPP
+#define RIOT_COROUTINE_HPP
+
+#if !defined(__cpp_impl_coroutine) && !defined(__cpp_coroutines)
+#error "riot/coroutine.hpp requires C++20 coroutines, e.g. CXXEXFLAGS += -std=c++20"
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "event.h"
+#include "irq.h"
+
+#ifdef MODULE_EVENT_TIMEOUT
+#include "event/timeout.h"
+#endif
+
+#if defined(MODULE_SOCK_UDP) && defined(MODULE_SOCK_ASYNC_EVENT)
+#include "net/sock/udp.h"
+#include "net/sock/async/event.h"
+#endif
+
+namespace riot {
+
+template <class T = void>
+class task;
+
+/** @cond INTERNAL */
+namespace detail {
+
+/**
+ * @brief Event that resumes a coroutine when it is handled
+ */
+struct resume_event {
+  event_t super; /* must be the first member */
+  std::coroutine_handle<> handle;
+
+  resume_event() noexcept : super{}, handle{} { super.handler = &handle_event; }
+
+  void post(event_queue_t* queue, std::coroutine_handle<> h) noexcept {
+    handle = h;
+    event_post(queue, &super);
+  }
+
+  static void handle_event(event_t* ev) {
+    reinterpret_cast<resume_event*>(ev)->handle.resume();
+  }
+};
+
+class task_promise_base {
+public:
+  struct final_awaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <class P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+      task_promise_base& p = h.promise();
+      if (p.m_continuation) {
+        return p.m_continuation;
+      }
+      if (p.m_detached) {
+        h.destroy();
+      }
+      return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  final_awaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept { m_exc = std::current_exception(); }
+
+  std::coroutine_handle<> m_continuation;
+  std::exception_ptr m_exc;
+  resume_event m_start;
+  bool m_detached = false;
+};
+
+template <class T>
+class task_promise : public task_promise_base {
+public:
+  task<T> get_return_object() noexcept;
+
+  template <class U>
+  void return_value(U&& value) {
+    m_value.emplace(std::forward<U>(value));
+  }
+
+  T take() {
+    if (m_exc) {
+      std::rethrow_exception(m_exc);
+    }
+    return std::move(*m_value);
+  }
+
+private:
+  std::optional<T> m_value;
+};
+
+template <>
+class task_promise<void> : public task_promise_base {
+public:
+  task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void take() {
+    if (m_exc) {
+      std::rethrow_exception(m_exc);
+    }
+  }
+};
+
+} // namespace detail
+/** @endcond */
+
+/**
+ * @brief A lazily started coroutine with a result of type `T`
+ *
+ * A task does nothing until it is either awaited by another coroutine or
+ * started with @ref riot::spawn().
+ */
+template <class T>
+class [[nodiscard]] task {
+public:
+  /**
+   * @brief The promise type of the coroutine.
+   */
+  using promise_type = detail::task_promise<T>;
+
+  /**
+   * @brief Creates a task without coroutine.
+   */
+  task() noexcept : m_handle{} {}
+  task(task&& other) noexcept : m_handle{std::exchange(other.m_handle, {})} {}
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+  task& operator=(task&& other) noexcept {
+    if (this != &other) {
+      if (m_handle) {
+        m_handle.destroy();
+      }
+      m_handle = std::exchange(other.m_handle, {});
+    }
+    return *this;
+  }
+  ~task() {
+    if (m_handle) {
+      m_handle.destroy();
+    }
+  }
+
+  /**
+   * @brief Checks if the coroutine has finished.
+   */
+  bool done() const noexcept { return !m_handle || m_handle.done(); }
+
+  /** @cond INTERNAL */
+  bool await_ready() const noexcept { return done(); }
+
+  std::coroutine_handle<> await_suspend(
+    std::coroutine_handle<> awaiting) noexcept {
+    m_handle.promise().m_continuation = awaiting;
+    return m_handle;
+  }
+
+  T await_resume() { return m_handle.promise().take(); }
+  /** @endcond */
+
+private:
+  friend promise_type;
+  friend void spawn(event_queue_t& queue, task<void>&& t);
+
+  explicit task(std::coroutine_handle<promise_type> h) noexcept
+      : m_handle{h} {}
+
+  std::coroutine_handle<promise_type> m_handle;
+};
+
+/** @cond INTERNAL */
+namespace detail {
+
+template <class T>
+inline task<T> task_promise<T>::get_return_object() noexcept {
+  return task<T>{std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+  return task<void>{
+    std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+}
+
+} // namespace detail
+/** @endcond */
+
+/**
+ * @brief Starts a task on an event queue
+ *
+ * The task runs until its first suspension when the event loop of @p queue
+ * handles the start event. Its frame is freed when it finishes. Exceptions
+ * that leave the task are dropped.
+ *
+ * @param[in] queue The event queue.
+ * @param[in] t     The task.
+ */
+inline void spawn(event_queue_t& queue, task<void>&& t) {
+  auto h = std::exchange(t.m_handle, {});
+  h.promise().m_detached = true;
+  h.promise().m_start.post(&queue, h);
+}
+
+/**
+ * @brief Awaitable returned by @ref riot::resume_on()
+ */
+class resume_on_awaiter {
+public:
+  /** @cond INTERNAL */
+  explicit resume_on_awaiter(event_queue_t& queue) noexcept
+      : m_queue{&queue} {}
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> h) noexcept {
+    m_ev.post(m_queue, h);
+  }
+  void await_resume() const noexcept {}
+  /** @endcond */
+
+private:
+  event_queue_t* m_queue;
+  detail::resume_event m_ev;
+};
+
+/**
+ * @brief Suspends the coroutine and resumes it from @p queue
+ *
+ * Lets other events of @p queue run first, or moves the coroutine to the
+ * thread handling @p queue.
+ */
+inline resume_on_awaiter resume_on(event_queue_t& queue) noexcept {
+  return resume_on_awaiter{queue};
+}
+
+#if defined(MODULE_EVENT_TIMEOUT) || defined(DOXYGEN)
+/**
+ * @brief Awaitable returned by @ref riot::sleep_for()
+ */
+class sleep_awaiter {
+public:
+  /** @cond INTERNAL */
+  sleep_awaiter(event_queue_t& queue, uint32_t usec) noexcept
+      : m_queue{&queue}, m_usec{usec} {}
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> h) noexcept {
+    m_ev.handle = h;
+    event_timeout_init(&m_timeout, m_queue, &m_ev.super);
+    event_timeout_set(&m_timeout, m_usec);
+  }
+  void await_resume() const noexcept {}
+  /** @endcond */
+
+private:
+  event_queue_t* m_queue;
+  uint32_t m_usec;
+  detail::resume_event m_ev;
+  event_timeout_t m_timeout;
+};
+
+/**
+ * @brief Suspends the coroutine for @p usec microseconds
+ *
+ * @param[in] queue The queue to resume the coroutine from.
+ * @param[in] usec  Time to sleep in microseconds.
+ */
+inline sleep_awaiter sleep_for(event_queue_t& queue, uint32_t usec) noexcept {
+  return sleep_awaiter{queue, usec};
+}
+
+/**
+ * @brief Suspends the coroutine for @p duration
+ */
+template <class Rep, class Period>
+inline sleep_awaiter sleep_for(
+  event_queue_t& queue, const std::chrono::duration<Rep, Period>& duration) {
+  return sleep_awaiter{
+    queue,
+    static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count())};
+}
+#endif
+
+/**
+ * @brief Mutex for coroutines
+ *
+ * Waiting for the mutex suspends the coroutine instead of blocking the
+ * thread. Ownership is handed directly to the first waiting coroutine on
+ * unlock, which is then resumed from its event queue. May be shared by
+ * coroutines running on different event queues.
+ */
+class async_mutex {
+public:
+  /**
+   * @brief Awaitable returned by @ref lock()
+   */
+  class lock_awaiter {
+  public:
+    /** @cond INTERNAL */
+    lock_awaiter(async_mutex& mtx, event_queue_t& queue) noexcept
+        : m_mutex{&mtx}, m_queue{&queue}, m_next{nullptr} {}
+    bool await_ready() noexcept { return m_mutex->try_lock(); }
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+      m_ev.handle = h;
+      unsigned state = irq_disable();
+      if (!m_mutex->m_locked) {
+        /* unlocked since await_ready() */
+        m_mutex->m_locked = true;
+        irq_restore(state);
+        return false;
+      }
+      if (m_mutex->m_tail) {
+        m_mutex->m_tail->m_next = this;
+      }
+      else {
+        m_mutex->m_head = this;
+      }
+      m_mutex->m_tail = this;
+      irq_restore(state);
+      return true;
+    }
+    void await_resume() const noexcept {}
+    /** @endcond */
+
+  private:
+    friend class async_mutex;
+
+    async_mutex* m_mutex;
+    event_queue_t* m_queue;
+    lock_awaiter* m_next;
+    detail::resume_event m_ev;
+  };
+
+  async_mutex() noexcept : m_locked{false}, m_head{nullptr}, m_tail{nullptr} {}
+  async_mutex(const async_mutex&) = delete;
+  async_mutex& operator=(const async_mutex&) = delete;
+
+  /**
+   * @brief Locks the mutex, to be used with `co_await`
+   * @param[in] queue The queue to resume the coroutine from, if it has to
+   *                  wait.
+   */
+  lock_awaiter lock(event_queue_t& queue) noexcept {
+    return lock_awaiter{*this, queue};
+  }
+
+  /**
+   * @brief Locks the mutex, if it is unlocked.
+   * @return `true` if the mutex was locked.
+   */
+  bool try_lock() noexcept {
+    unsigned state = irq_disable();
+    bool res = !m_locked;
+    m_locked = true;
+    irq_restore(state);
+    return res;
+  }
+
+  /**
+   * @brief Unlocks the mutex or hands it to the next waiting coroutine.
+   */
+  void unlock() noexcept {
+    unsigned state = irq_disable();
+    lock_awaiter* next = m_head;
+    if (next) {
+      m_head = next->m_next;
+      if (!m_head) {
+        m_tail = nullptr;
+      }
+    }
+    else {
+      m_locked = false;
+    }
+    irq_restore(state);
+    if (next) {
+      event_post(next->m_queue, &next->m_ev.super);
+    }
+  }
+
+private:
+  bool m_locked;
+  lock_awaiter* m_head;
+  lock_awaiter* m_tail;
+};
+
+#if (defined(MODULE_SOCK_UDP) && defined(MODULE_SOCK_ASYNC_EVENT)) || \
+    defined(DOXYGEN)
+/**
+ * @brief UDP sock with a coroutine receive function
+ *
+ * All coroutines using a socket must run on the event queue of the socket.
+ */
+class udp_socket {
+public:
+  /**
+   * @brief Awaitable returned by @ref recv()
+   */
+  class recv_awaiter {
+  public:
+    /** @cond INTERNAL */
+    recv_awaiter(udp_socket& sock, void* buf, size_t len, uint32_t timeout,
+                 sock_udp_ep_t* remote) noexcept
+        : m_sock{&sock}, m_buf{buf}, m_len{len}, m_timeout{timeout},
+          m_remote{remote}, m_res{0} {}
+
+    bool await_ready() noexcept {
+      m_res = sock_udp_recv(&m_sock->m_sock, m_buf, m_len, 0, m_remote);
+      return m_res != -EAGAIN || m_timeout == 0;
+    }
+
+    void await_suspend(std::coroutine_handle<> h) noexcept {
+      m_handle = h;
+      m_sock->m_waiter = this;
+#ifdef MODULE_EVENT_TIMEOUT
+      if (m_timeout != SOCK_NO_TIMEOUT) {
+        m_timeout_ev.owner = this;
+        m_timeout_ev.super.handler = &on_timeout;
+        event_timeout_init(&m_timeout_event, m_sock->m_queue,
+                           &m_timeout_ev.super);
+        event_timeout_set(&m_timeout_event, m_timeout);
+      }
+#endif
+    }
+
+    ssize_t await_resume() const noexcept { return m_res; }
+    /** @endcond */
+
+  private:
+    friend class udp_socket;
+
+    /* called from the event loop if the sock received something */
+    void on_recv() {
+      m_res = sock_udp_recv(&m_sock->m_sock, m_buf, m_len, 0, m_remote);
+      if (m_res == -EAGAIN) {
+        return;
+      }
+      m_sock->m_waiter = nullptr;
+#ifdef MODULE_EVENT_TIMEOUT
+      if (m_timeout != SOCK_NO_TIMEOUT) {
+        event_timeout_clear(&m_timeout_event);
+        event_cancel(m_sock->m_queue, &m_timeout_ev.super);
+      }
+#endif
+      m_handle.resume();
+    }
+
+#ifdef MODULE_EVENT_TIMEOUT
+    struct timeout_event {
+      event_t super; /* must be the first member */
+      recv_awaiter* owner;
+    };
+
+    static void on_timeout(event_t* ev) {
+      recv_awaiter* self = reinterpret_cast<timeout_event*>(ev)->owner;
+      if (self->m_sock->m_waiter == self) {
+        self->m_sock->m_waiter = nullptr;
+        self->m_res = -ETIMEDOUT;
+        self->m_handle.resume();
+      }
+    }
+
+    timeout_event m_timeout_ev{};
+    event_timeout_t m_timeout_event;
+#endif
+    udp_socket* m_sock;
+    void* m_buf;
+    size_t m_len;
+    uint32_t m_timeout;
+    sock_udp_ep_t* m_remote;
+    ssize_t m_res;
+    std::coroutine_handle<> m_handle;
+  };
+
+  /**
+   * @brief Creates an unopened socket.
+   * @param[in] queue The event queue of all coroutines using the socket.
+   */
+  explicit udp_socket(event_queue_t& queue) noexcept
+      : m_sock{}, m_queue{&queue}, m_waiter{nullptr}, m_open{false} {}
+  udp_socket(const udp_socket&) = delete;
+  udp_socket& operator=(const udp_socket&) = delete;
+  ~udp_socket() { close(); }
+
+  /**
+   * @brief Opens the socket, see @ref sock_udp_create().
+   */
+  int create(const sock_udp_ep_t* local, const sock_udp_ep_t* remote = nullptr,
+             uint16_t flags = 0) noexcept {
+    int res = sock_udp_create(&m_sock, local, remote, flags);
+    if (res == 0) {
+      m_open = true;
+      sock_udp_event_init(&m_sock, m_queue, &on_event);
+    }
+    return res;
+  }
+
+  /**
+   * @brief Closes the socket.
+   */
+  void close() noexcept {
+    if (m_open) {
+      sock_udp_close(&m_sock);
+      m_open = false;
+    }
+  }
+
+  /**
+   * @brief Receives a datagram, to be used with `co_await`
+   *
+   * Only one coroutine may receive on a socket at a time.
+   *
+   * @param[out] buf      Buffer for the payload.
+   * @param[in] len       Size of @p buf.
+   * @param[in] timeout   Timeout in microseconds, @ref SOCK_NO_TIMEOUT to
+   *                      wait forever. Other values than 0 and
+   *                      @ref SOCK_NO_TIMEOUT need the `event_timeout`
+   *                      module.
+   * @param[out] remote   Remote end point of the datagram, may be nullptr.
+   *
+   * @return  The result of @ref sock_udp_recv(), -ETIMEDOUT on timeout.
+   */
+  recv_awaiter recv(void* buf, size_t len, uint32_t timeout = SOCK_NO_TIMEOUT,
+                    sock_udp_ep_t* remote = nullptr) noexcept {
+    return recv_awaiter{*this, buf, len, timeout, remote};
+  }
+
+  /**
+   * @brief Sends a datagram, see @ref sock_udp_send().
+   */
+  ssize_t send(const void* data, size_t len,
+               const sock_udp_ep_t* remote = nullptr) noexcept {
+    return sock_udp_send(&m_sock, data, len, remote);
+  }
+
+  /**
+   * @brief Provides access to the sock.
+   */
+  sock_udp_t* native_handle() noexcept { return &m_sock; }
+
+private:
+  static void on_event(sock_udp_t* sock, sock_async_flags_t flags) {
+    /* m_sock is the first member of the standard layout class */
+    udp_socket* self = reinterpret_cast<udp_socket*>(sock);
+    if ((flags & SOCK_ASYNC_MSG_RECV) && self->m_waiter) {
+      self->m_waiter->on_recv();
+    }
+  }
+
+  sock_udp_t m_sock;
+  event_queue_t* m_queue;
+  recv_awaiter* m_waiter;
+  bool m_open;
+};
+#endif
+
+} // namespace riot
+
+#endif // RIOT_COROUTINE_HPP
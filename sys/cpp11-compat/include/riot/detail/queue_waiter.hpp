@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Blocking wait of a single thread on a lock-free queue
+ *
+ * @}
+ */
+
+#ifndef RIOT_DETAIL_QUEUE_WAITER_HPP
+#define RIOT_DETAIL_QUEUE_WAITER_HPP
+
+#include <atomic>
+
+#include "sched.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifndef MODULE_CORE_THREAD_FLAGS
+#error "riot::spsc_queue and riot::mpsc_queue require USEMODULE += core_thread_flags"
+#endif
+
+/**
+ * @brief Thread flag used to wake up threads blocked on a queue
+ *
+ * Threads must not use this flag for anything else while they are blocked on
+ * a @ref riot::spsc_queue or @ref riot::mpsc_queue.
+ */
+#ifndef RIOT_QUEUE_THREAD_FLAG
+#define RIOT_QUEUE_THREAD_FLAG (1u << 13)
+#endif
+
+namespace riot {
+namespace detail {
+
+/**
+ * @brief Lets one thread sleep until another thread or an ISR changed the
+ *        state of a queue.
+ *
+ * The waiting thread calls `prepare()`, checks the state of the queue again
+ * and calls `wait()` only if it still has to wait. The other side calls
+ * `notify()` after changing the state. As thread flags are sticky, a
+ * notification between checking and `wait()` is not lost.
+ */
+class queue_waiter {
+public:
+  inline constexpr queue_waiter() noexcept : m_thread{nullptr} {}
+
+  /**
+   * @brief Registers the calling thread for the next notification.
+   */
+  inline void prepare() noexcept {
+    m_thread.store(const_cast<thread_t*>(sched_active_thread));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  /**
+   * @brief Blocks until notified, then unregisters the calling thread.
+   */
+  inline void wait() noexcept {
+    thread_flags_wait_any(RIOT_QUEUE_THREAD_FLAG);
+    m_thread.store(nullptr, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Unregisters the calling thread without blocking.
+   */
+  inline void cancel() noexcept {
+    m_thread.store(nullptr, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Wakes up the registered thread, if any.
+   */
+  inline void notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    thread_t* thread = m_thread.load(std::memory_order_relaxed);
+    if (thread != nullptr) {
+      thread_flags_set(thread, RIOT_QUEUE_THREAD_FLAG);
+    }
+  }
+
+private:
+  std::atomic<thread_t*> m_thread;
+};
+
+} // namespace detail
+} // namespace riot
+
+#endif // RIOT_DETAIL_QUEUE_WAITER_HPP
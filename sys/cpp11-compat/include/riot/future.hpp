@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++11 future and promise replacement without heap allocation
+ * @see     <a href="http://en.cppreference.com/w/cpp/thread/future">
+ *            std::future and std::promise
+ *          </a>
+ *
+ * The state shared by a promise and its future is taken from a static pool of
+ * @ref RIOT_FUTURE_POOL_SIZE slots of @ref RIOT_FUTURE_STATE_SIZE bytes each.
+ * A thread waiting for a future sleeps on a thread flag (see
+ * @ref RIOT_QUEUE_THREAD_FLAG), so `USEMODULE += core_thread_flags` is
+ * required. Values can be set from ISRs.
+ *
+ * @}
+ */
+
+#ifndef RIOT_FUTURE_HPP
+#define RIOT_FUTURE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "irq.h"
+
+#include "riot/detail/queue_waiter.hpp"
+
+/**
+ * @brief Number of promise/future pairs that can exist at the same time
+ *
+ * At most 32.
+ */
+#ifndef RIOT_FUTURE_POOL_SIZE
+#define RIOT_FUTURE_POOL_SIZE (8U)
+#endif
+
+/**
+ * @brief Size of a slot for the shared state of a promise/future pair
+ *
+ * Must be large enough for the value type plus some bookkeeping, which is
+ * checked at compile time.
+ */
+#ifndef RIOT_FUTURE_STATE_SIZE
+#define RIOT_FUTURE_STATE_SIZE (48U)
+#endif
+
+namespace riot {
+
+/** @cond INTERNAL */
+namespace detail {
+
+/**
+ * @brief Takes a slot from the shared state pool.
+ * @return  The slot or `nullptr`, if all slots are in use.
+ */
+void* future_state_alloc() noexcept;
+
+/**
+ * @brief Returns a slot to the shared state pool.
+ */
+void future_state_free(void* slot) noexcept;
+
+class shared_state_base {
+public:
+  shared_state_base() noexcept : m_refs{2}, m_ready{false} {}
+
+  inline bool is_ready() const noexcept {
+    return m_ready.load(std::memory_order_acquire);
+  }
+
+  void wait() noexcept {
+    while (!is_ready()) {
+      m_waiter.prepare();
+      if (is_ready()) {
+        m_waiter.cancel();
+        break;
+      }
+      m_waiter.wait();
+    }
+  }
+
+  void set_exception(std::exception_ptr exc) {
+    if (is_ready()) {
+      throw std::logic_error("promise already satisfied");
+    }
+    m_exc = exc;
+    make_ready();
+  }
+
+  /* returns true, if this was the last reference */
+  inline bool unref() noexcept {
+    unsigned state = irq_disable();
+    bool last = (--m_refs == 0);
+    irq_restore(state);
+    return last;
+  }
+
+  std::exception_ptr m_exc;
+
+protected:
+  inline void make_ready() noexcept {
+    m_ready.store(true, std::memory_order_release);
+    m_waiter.notify();
+  }
+
+private:
+  unsigned char m_refs;
+  std::atomic<bool> m_ready;
+  queue_waiter m_waiter;
+};
+
+template <class T>
+class shared_state : public shared_state_base {
+public:
+  ~shared_state() {
+    if (is_ready() && !m_exc) {
+      value().~T();
+    }
+  }
+
+  template <class U>
+  void set_value(U&& value) {
+    if (is_ready()) {
+      throw std::logic_error("promise already satisfied");
+    }
+    new (&m_value) T(std::forward<U>(value));
+    make_ready();
+  }
+
+  inline T& value() noexcept { return *reinterpret_cast<T*>(&m_value); }
+
+private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_value;
+};
+
+template <>
+class shared_state<void> : public shared_state_base {
+public:
+  void set_value() {
+    if (is_ready()) {
+      throw std::logic_error("promise already satisfied");
+    }
+    make_ready();
+  }
+};
+
+template <class T>
+shared_state<T>* make_shared_state() {
+  static_assert(sizeof(shared_state<T>) <= RIOT_FUTURE_STATE_SIZE,
+                "value type too large, increase RIOT_FUTURE_STATE_SIZE");
+  static_assert(alignof(shared_state<T>) <= alignof(std::max_align_t),
+                "value type alignment not supported");
+  void* slot = future_state_alloc();
+  if (slot == nullptr) {
+    throw std::system_error(
+      std::make_error_code(std::errc::resource_unavailable_try_again),
+      "No free future state, increase RIOT_FUTURE_POOL_SIZE.");
+  }
+  return new (slot) shared_state<T>;
+}
+
+template <class T>
+void release_shared_state(shared_state<T>* state) noexcept {
+  if (state != nullptr && state->unref()) {
+    state->~shared_state<T>();
+    future_state_free(state);
+  }
+}
+
+} // namespace detail
+/** @endcond */
+
+template <class T>
+class promise_base;
+
+/**
+ * @brief Common part of future<T> and future<void>
+ */
+template <class T>
+class future_base {
+public:
+  /**
+   * @brief Checks if the future refers to a shared state.
+   */
+  inline bool valid() const noexcept { return m_state != nullptr; }
+
+  /**
+   * @brief Checks if the value or an exception is available. Not part of
+   *        std::future.
+   */
+  inline bool is_ready() const noexcept { return m_state->is_ready(); }
+
+  /**
+   * @brief Blocks until the value or an exception is available.
+   */
+  inline void wait() const noexcept { m_state->wait(); }
+
+protected:
+  inline future_base() noexcept : m_state{nullptr} {}
+  inline explicit future_base(detail::shared_state<T>* state) noexcept
+      : m_state{state} {}
+  inline future_base(future_base&& other) noexcept : m_state{other.m_state} {
+    other.m_state = nullptr;
+  }
+  inline ~future_base() { detail::release_shared_state(m_state); }
+
+  inline void move_assign(future_base&& other) noexcept {
+    if (this != &other) {
+      detail::release_shared_state(m_state);
+      m_state = other.m_state;
+      other.m_state = nullptr;
+    }
+  }
+
+  /* waits, rethrows a stored exception and gives up the shared state */
+  detail::shared_state<T>* take() {
+    if (m_state == nullptr) {
+      throw std::logic_error("future has no state");
+    }
+    m_state->wait();
+    detail::shared_state<T>* state = m_state;
+    m_state = nullptr;
+    if (state->m_exc) {
+      std::exception_ptr exc = state->m_exc;
+      detail::release_shared_state(state);
+      std::rethrow_exception(exc);
+    }
+    return state;
+  }
+
+  detail::shared_state<T>* m_state;
+};
+
+/**
+ * @brief C++11 compliant implementation of future, without shared_future
+ *        support and timed waits
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/future">
+ *          std::future
+ *        </a>
+ */
+template <class T>
+class future : public future_base<T> {
+  friend class promise_base<T>;
+
+public:
+  inline future() noexcept = default;
+  inline future(future&& other) noexcept = default;
+  future(const future&) = delete;
+  future& operator=(const future&) = delete;
+
+  /**
+   * @brief Move assignment operator.
+   */
+  inline future& operator=(future&& other) noexcept {
+    this->move_assign(std::move(other));
+    return *this;
+  }
+
+  /**
+   * @brief Waits for the value and returns it.
+   *
+   * Rethrows the exception stored in the promise, if any. The future is not
+   * valid afterwards.
+   */
+  T get() {
+    detail::shared_state<T>* state = this->take();
+    T res = std::move(state->value());
+    detail::release_shared_state(state);
+    return res;
+  }
+
+private:
+  inline explicit future(detail::shared_state<T>* state) noexcept
+      : future_base<T>{state} {}
+};
+
+/**
+ * @brief Specialization of future for void.
+ */
+template <>
+class future<void> : public future_base<void> {
+  friend class promise_base<void>;
+
+public:
+  inline future() noexcept = default;
+  inline future(future&& other) noexcept = default;
+  future(const future&) = delete;
+  future& operator=(const future&) = delete;
+
+  /**
+   * @brief Move assignment operator.
+   */
+  inline future& operator=(future&& other) noexcept {
+    this->move_assign(std::move(other));
+    return *this;
+  }
+
+  /**
+   * @brief Waits until the promise is satisfied.
+   *
+   * Rethrows the exception stored in the promise, if any. The future is not
+   * valid afterwards.
+   */
+  inline void get() { detail::release_shared_state(this->take()); }
+
+private:
+  inline explicit future(detail::shared_state<void>* state) noexcept
+      : future_base<void>{state} {}
+};
+
+/**
+ * @brief Common part of promise<T> and promise<void>
+ */
+template <class T>
+class promise_base {
+public:
+  /**
+   * @brief Returns the future of the promise, can only be called once.
+   */
+  future<T> get_future() {
+    if (m_retrieved || m_state == nullptr) {
+      throw std::logic_error("future already retrieved");
+    }
+    m_retrieved = true;
+    return future<T>{m_state};
+  }
+
+  /**
+   * @brief Stores an exception to be rethrown by future<T>::get().
+   */
+  inline void set_exception(std::exception_ptr exc) {
+    m_state->set_exception(exc);
+  }
+
+protected:
+  inline promise_base()
+      : m_state{detail::make_shared_state<T>()}, m_retrieved{false} {}
+  inline promise_base(promise_base&& other) noexcept
+      : m_state{other.m_state}, m_retrieved{other.m_retrieved} {
+    other.m_state = nullptr;
+  }
+  ~promise_base() {
+    if (m_state == nullptr) {
+      return;
+    }
+    if (!m_state->is_ready()) {
+      m_state->set_exception(
+        std::make_exception_ptr(std::runtime_error("broken promise")));
+    }
+    if (!m_retrieved) {
+      /* the reference of the future */
+      m_state->unref();
+    }
+    detail::release_shared_state(m_state);
+  }
+
+  inline void move_assign(promise_base&& other) noexcept {
+    std::swap(m_state, other.m_state);
+    std::swap(m_retrieved, other.m_retrieved);
+  }
+
+  detail::shared_state<T>* m_state;
+  bool m_retrieved;
+};
+
+/**
+ * @brief C++11 compliant implementation of promise, the shared state is
+ *        taken from a static pool
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/promise">
+ *          std::promise
+ *        </a>
+ */
+template <class T>
+class promise : public promise_base<T> {
+public:
+  inline promise() = default;
+  inline promise(promise&& other) noexcept = default;
+  promise(const promise&) = delete;
+  promise& operator=(const promise&) = delete;
+
+  /**
+   * @brief Move assignment operator.
+   */
+  inline promise& operator=(promise&& other) noexcept {
+    this->move_assign(std::move(other));
+    return *this;
+  }
+
+  /**
+   * @brief Stores the value and wakes up a thread waiting for the future.
+   */
+  inline void set_value(const T& value) { this->m_state->set_value(value); }
+
+  /**
+   * @brief Stores the value and wakes up a thread waiting for the future.
+   */
+  inline void set_value(T&& value) {
+    this->m_state->set_value(std::move(value));
+  }
+};
+
+/**
+ * @brief Specialization of promise for void.
+ */
+template <>
+class promise<void> : public promise_base<void> {
+public:
+  inline promise() = default;
+  inline promise(promise&& other) noexcept = default;
+  promise(const promise&) = delete;
+  promise& operator=(const promise&) = delete;
+
+  /**
+   * @brief Move assignment operator.
+   */
+  inline promise& operator=(promise&& other) noexcept {
+    this->move_assign(std::move(other));
+    return *this;
+  }
+
+  /**
+   * @brief Marks the promise as satisfied and wakes up a thread waiting for
+   *        the future.
+   */
+  inline void set_value() { this->m_state->set_value(); }
+};
+
+} // namespace riot
+
+#endif // RIOT_FUTURE_HPP
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Lock-free multi-producer/single-consumer queue
+ *
+ * The queue stores up to `N` elements in the queue object itself, so no
+ * memory is allocated. Elements are moved in and out of the queue. Any
+ * number of threads and ISRs may push while one thread pops. Producers
+ * reserve a slot with a compare-and-swap and mark it as filled with a
+ * per-slot sequence number, so no lock is taken and interrupts stay
+ * enabled. On CPUs without atomic compare-and-swap instructions this needs
+ * the `atomic_c11` module. Blocking calls sleep on a thread flag (see
+ * @ref RIOT_QUEUE_THREAD_FLAG), so `USEMODULE += core_thread_flags` is
+ * required.
+ *
+ * @}
+ */
+
+#ifndef RIOT_MPSC_QUEUE_HPP
+#define RIOT_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "riot/detail/queue_waiter.hpp"
+
+namespace riot {
+
+/**
+ * @brief Bounded lock-free queue for multiple producers and one consumer
+ *
+ * Producers can't block, as there is no way to tell which of them should be
+ * woken up first. They have to handle a full queue, e.g. by dropping the
+ * element.
+ *
+ * @tparam T  Type of the elements.
+ * @tparam N  Capacity of the queue, must be a power of 2.
+ */
+template <class T, std::size_t N>
+class mpsc_queue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of 2");
+
+public:
+  /**
+   * @brief The type of the elements.
+   */
+  using value_type = T;
+
+  mpsc_queue() noexcept : m_head{0}, m_tail{0} {
+    for (std::size_t i = 0; i < N; ++i) {
+      m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  ~mpsc_queue() {
+    for (; m_cells[m_head & (N - 1)].seq.load() == m_head + 1; ++m_head) {
+      reinterpret_cast<T*>(&m_cells[m_head & (N - 1)].storage)->~T();
+    }
+  }
+
+  mpsc_queue(const mpsc_queue&) = delete;
+  mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+  /**
+   * @brief Constructs an element at the end of the queue, if there is space.
+   *
+   * May be called by any thread or ISR.
+   *
+   * @return `true` if the element was added, `false` if the queue is full.
+   */
+  template <class... Args>
+  bool try_emplace(Args&&... args) {
+    std::size_t pos = m_tail.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+      c = &m_cells[pos & (N - 1)];
+      std::size_t seq = c->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        /* slot is free, try to reserve it */
+        if (m_tail.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      else if (diff < 0) {
+        /* slot still holds the element of the previous round */
+        return false;
+      }
+      else {
+        pos = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+    new (&c->storage) T(std::forward<Args>(args)...);
+    c->seq.store(pos + 1, std::memory_order_release);
+    m_consumer.notify();
+    return true;
+  }
+
+  /**
+   * @brief Adds an element to the end of the queue, if there is space.
+   * @see   try_emplace()
+   */
+  inline bool try_push(const T& value) { return try_emplace(value); }
+
+  /**
+   * @brief Moves an element to the end of the queue, if there is space.
+   * @see   try_emplace()
+   */
+  inline bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  /**
+   * @brief Moves the first element out of the queue, if there is one.
+   *
+   * Must only be called by the consumer thread. An element whose producer
+   * was preempted while filling its slot is not available yet, even if later
+   * elements are.
+   *
+   * @param[out] value  Destination of the element.
+   *
+   * @return `true` if an element was taken, `false` if the queue is empty.
+   */
+  bool try_pop(T& value) {
+    cell* c = &m_cells[m_head & (N - 1)];
+    if (c->seq.load(std::memory_order_acquire) != m_head + 1) {
+      return false;
+    }
+    T* elem = reinterpret_cast<T*>(&c->storage);
+    value = std::move(*elem);
+    elem->~T();
+    c->seq.store(m_head + N, std::memory_order_release);
+    ++m_head;
+    return true;
+  }
+
+  /**
+   * @brief Moves the first element out of the queue, blocks while the queue
+   *        is empty.
+   *
+   * Must only be called by the consumer thread.
+   */
+  T pop() {
+    T value;
+    while (!try_pop(value)) {
+      m_consumer.prepare();
+      if (m_cells[m_head & (N - 1)].seq.load() == m_head + 1) {
+        m_consumer.cancel();
+        continue;
+      }
+      m_consumer.wait();
+    }
+    return value;
+  }
+
+  /**
+   * @brief Checks if the queue is empty.
+   *
+   * Must only be called by the consumer thread.
+   */
+  inline bool empty() const noexcept {
+    return m_tail.load(std::memory_order_acquire) == m_head;
+  }
+
+  /**
+   * @brief Maximum number of elements in the queue.
+   */
+  static constexpr std::size_t capacity() noexcept { return N; }
+
+private:
+  struct cell {
+    std::atomic<std::size_t> seq;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  cell m_cells[N];
+  std::size_t m_head; /* accessed by the consumer only */
+  std::atomic<std::size_t> m_tail;
+  detail::queue_waiter m_consumer;
+};
+
+} // namespace riot
+
+#endif // RIOT_MPSC_QUEUE_HPP
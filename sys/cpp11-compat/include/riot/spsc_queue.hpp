@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Lock-free single-producer/single-consumer queue
+ *
+ * The queue stores up to `N` elements in the queue object itself, so no
+ * memory is allocated. Elements are moved in and out of the queue. One
+ * thread or ISR may push while one thread pops, without locking and without
+ * disabling interrupts. Blocking calls sleep on a thread flag (see
+ * @ref RIOT_QUEUE_THREAD_FLAG), so `USEMODULE += core_thread_flags` is
+ * required.
+ *
+ * @}
+ */
+
+#ifndef RIOT_SPSC_QUEUE_HPP
+#define RIOT_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "riot/detail/queue_waiter.hpp"
+
+namespace riot {
+
+/**
+ * @brief Bounded lock-free queue for one producer and one consumer
+ *
+ * @tparam T  Type of the elements.
+ * @tparam N  Capacity of the queue, must be a power of 2.
+ */
+template <class T, std::size_t N>
+class spsc_queue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of 2");
+
+public:
+  /**
+   * @brief The type of the elements.
+   */
+  using value_type = T;
+
+  inline spsc_queue() noexcept : m_head{0}, m_tail{0} {}
+  ~spsc_queue() {
+    for (std::size_t i = m_head.load(); i != m_tail.load(); ++i) {
+      reinterpret_cast<T*>(&m_storage[i & (N - 1)])->~T();
+    }
+  }
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  /**
+   * @brief Constructs an element at the end of the queue, if there is space.
+   *
+   * Must only be called by the producer. May be called from an ISR.
+   *
+   * @return `true` if the element was added, `false` if the queue is full.
+   */
+  template <class... Args>
+  bool try_emplace(Args&&... args) {
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+    new (&m_storage[tail & (N - 1)]) T(std::forward<Args>(args)...);
+    m_tail.store(tail + 1, std::memory_order_release);
+    m_consumer.notify();
+    return true;
+  }
+
+  /**
+   * @brief Adds an element to the end of the queue, if there is space.
+   * @see   try_emplace()
+   */
+  inline bool try_push(const T& value) { return try_emplace(value); }
+
+  /**
+   * @brief Moves an element to the end of the queue, if there is space.
+   * @see   try_emplace()
+   */
+  inline bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  /**
+   * @brief Moves an element to the end of the queue, blocks while the queue
+   *        is full.
+   *
+   * Must only be called by the producer thread.
+   */
+  void push(T value) {
+    while (!try_emplace(std::move(value))) {
+      m_producer.prepare();
+      if (!full()) {
+        m_producer.cancel();
+        continue;
+      }
+      m_producer.wait();
+    }
+  }
+
+  /**
+   * @brief Moves the first element out of the queue, if there is one.
+   *
+   * Must only be called by the consumer thread.
+   *
+   * @param[out] value  Destination of the element.
+   *
+   * @return `true` if an element was taken, `false` if the queue is empty.
+   */
+  bool try_pop(T& value) {
+    std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    T* elem = reinterpret_cast<T*>(&m_storage[head & (N - 1)]);
+    value = std::move(*elem);
+    elem->~T();
+    m_head.store(head + 1, std::memory_order_release);
+    m_producer.notify();
+    return true;
+  }
+
+  /**
+   * @brief Moves the first element out of the queue, blocks while the queue
+   *        is empty.
+   *
+   * Must only be called by the consumer thread.
+   */
+  T pop() {
+    T value;
+    while (!try_pop(value)) {
+      m_consumer.prepare();
+      if (!empty()) {
+        m_consumer.cancel();
+        continue;
+      }
+      m_consumer.wait();
+    }
+    return value;
+  }
+
+  /**
+   * @brief Checks if the queue is empty.
+   */
+  inline bool empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Checks if the queue is full.
+   */
+  inline bool full() const noexcept { return size() == N; }
+
+  /**
+   * @brief Number of elements in the queue.
+   */
+  inline std::size_t size() const noexcept {
+    return m_tail.load(std::memory_order_acquire)
+           - m_head.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Maximum number of elements in the queue.
+   */
+  static constexpr std::size_t capacity() noexcept { return N; }
+
+private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage[N];
+  std::atomic<std::size_t> m_head; /* written by the consumer only */
+  std::atomic<std::size_t> m_tail; /* written by the producer only */
+  detail::queue_waiter m_consumer;
+  detail::queue_waiter m_producer;
+};
+
+} // namespace riot
+
+#endif // RIOT_SPSC_QUEUE_HPP
@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Fixed-size worker thread pool and async() replacement
+ *
+ * A @ref riot::thread_pool holds the stacks of its worker threads and a queue
+ * of pending jobs in the pool object itself. Jobs are stored in the queue
+ * in place, so submitting a job allocates no memory, as long as the job fits
+ * into @ref RIOT_THREAD_POOL_JOB_SIZE bytes. Idle workers sleep on
+ * @ref RIOT_THREAD_POOL_THREAD_FLAG, so `USEMODULE += core_thread_flags` is
+ * required.
+ *
+ * @ref riot::async() runs a function on a pool and returns a
+ * @ref riot::future for its result.
+ *
+ * @}
+ */
+
+#ifndef RIOT_THREAD_POOL_HPP
+#define RIOT_THREAD_POOL_HPP
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "thread.h"
+#include "thread_flags.h"
+
+#include "riot/chrono.hpp"
+#include "riot/future.hpp"
+#include "riot/mutex.hpp"
+#include "riot/thread.hpp"
+#include "riot/detail/thread_util.hpp"
+
+/**
+ * @brief Maximum size of a job in bytes
+ *
+ * A job is the function object passed to @ref riot::thread_pool::submit(),
+ * including its captures. Jobs created by @ref riot::async() need a pointer
+ * plus the function and its arguments.
+ */
+#ifndef RIOT_THREAD_POOL_JOB_SIZE
+#define RIOT_THREAD_POOL_JOB_SIZE (6 * sizeof(void*))
+#endif
+
+/**
+ * @brief Thread flag used to wake up idle workers
+ */
+#ifndef RIOT_THREAD_POOL_THREAD_FLAG
+#define RIOT_THREAD_POOL_THREAD_FLAG (1u << 12)
+#endif
+
+namespace riot {
+
+/** @cond INTERNAL */
+namespace detail {
+
+/**
+ * @brief Type-erased function object with in-place storage
+ */
+class job {
+public:
+  inline job() noexcept : m_ops{nullptr} {}
+  job(const job&) = delete;
+  job& operator=(const job&) = delete;
+  inline ~job() { reset(); }
+
+  template <class F>
+  void emplace(F&& f) {
+    using fn = typename std::decay<F>::type;
+    static_assert(sizeof(fn) <= RIOT_THREAD_POOL_JOB_SIZE,
+                  "job too large, increase RIOT_THREAD_POOL_JOB_SIZE");
+    static_assert(alignof(fn) <= alignof(std::max_align_t),
+                  "job alignment not supported");
+    reset();
+    new (&m_storage) fn(std::forward<F>(f));
+    m_ops = &ops_for<fn>::ops;
+  }
+
+  /* moves the job of other into this one, other is empty afterwards */
+  inline void take(job& other) noexcept {
+    reset();
+    if (other.m_ops != nullptr) {
+      other.m_ops->move(&m_storage, &other.m_storage);
+      m_ops = other.m_ops;
+      other.reset();
+    }
+  }
+
+  inline void reset() noexcept {
+    if (m_ops != nullptr) {
+      m_ops->destroy(&m_storage);
+      m_ops = nullptr;
+    }
+  }
+
+  inline void operator()() { m_ops->invoke(&m_storage); }
+
+private:
+  struct operations {
+    void (*invoke)(void*);
+    void (*move)(void*, void*);
+    void (*destroy)(void*);
+  };
+
+  template <class F>
+  struct ops_for {
+    static void invoke(void* f) { (*static_cast<F*>(f))(); }
+    static void move(void* dst, void* src) {
+      new (dst) F(std::move(*static_cast<F*>(src)));
+    }
+    static void destroy(void* f) { static_cast<F*>(f)->~F(); }
+    static constexpr operations ops = { invoke, move, destroy };
+  };
+
+  typename std::aligned_storage<RIOT_THREAD_POOL_JOB_SIZE,
+                                alignof(std::max_align_t)>::type m_storage;
+  const operations* m_ops;
+};
+
+template <class F>
+constexpr job::operations job::ops_for<F>::ops;
+
+} // namespace detail
+/** @endcond */
+
+/**
+ * @brief Fixed-size pool of worker threads
+ *
+ * The pool is meant to be placed in static storage. As static constructors
+ * run before the scheduler is up, the constructor does not create any thread;
+ * the workers are started by @ref start(), which must be called from a
+ * thread, e.g. at the beginning of `main()`. Jobs submitted before are queued
+ * and run once the workers are started. The pool must only be used from
+ * threads, not from ISRs.
+ *
+ * @tparam Workers    Number of worker threads.
+ * @tparam QueueSize  Maximum number of pending jobs.
+ * @tparam StackSize  Stack size of each worker thread.
+ */
+template <unsigned Workers, unsigned QueueSize = 8,
+          std::size_t StackSize = THREAD_STACKSIZE_MAIN>
+class thread_pool {
+  static_assert(Workers > 0, "a thread pool needs at least one worker");
+  static_assert(QueueSize > 0, "a thread pool needs a queue");
+
+public:
+  /**
+   * @brief Creates a pool without any running worker.
+   */
+  thread_pool() noexcept
+      : m_head{0}, m_count{0}, m_idle{}, m_idle_count{0}, m_stop{false},
+        m_pids{} {}
+
+  /**
+   * @brief Starts the worker threads.
+   *
+   * Must be called once, from a thread.
+   *
+   * @param[in] prio  Priority of the workers.
+   * @param[in] name  Name of the workers.
+   */
+  void start(uint8_t prio = THREAD_PRIORITY_MAIN - 1,
+             const char* name = "riot_cpp_pool") {
+    for (unsigned i = 0; i < Workers; ++i) {
+      m_pids[i] = thread_create(m_stacks[i], StackSize, prio,
+                                THREAD_CREATE_STACKTEST, &worker, this, name);
+      if (m_pids[i] < 0) {
+        m_pids[i] = KERNEL_PID_UNDEF;
+        throw std::system_error(
+          std::make_error_code(std::errc::resource_unavailable_try_again),
+          "Failed to create thread.");
+      }
+    }
+  }
+
+  /**
+   * @brief Finishes all pending jobs and stops the worker threads.
+   */
+  ~thread_pool() {
+    m_lock.lock();
+    m_stop = true;
+    while (m_idle_count > 0) {
+      thread_flags_set(m_idle[--m_idle_count], RIOT_THREAD_POOL_THREAD_FLAG);
+    }
+    m_lock.unlock();
+    for (unsigned i = 0; i < Workers; ++i) {
+      /* the thread might have a lower priority, so give it time to exit */
+      while (is_running(i)) {
+        this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * @brief Queues a function object to be called by a worker.
+   * @param[in] f   Function object without arguments.
+   * @return  `true` if @p f was queued, `false` if the queue is full.
+   */
+  template <class F>
+  bool submit(F&& f) {
+    lock_guard<mutex> lk{m_lock};
+    if (m_count == QueueSize || m_stop) {
+      return false;
+    }
+    m_jobs[(m_head + m_count) % QueueSize].emplace(std::forward<F>(f));
+    ++m_count;
+    if (m_idle_count > 0) {
+      thread_flags_set(m_idle[--m_idle_count], RIOT_THREAD_POOL_THREAD_FLAG);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Number of worker threads.
+   */
+  static constexpr unsigned size() noexcept { return Workers; }
+
+private:
+  static void* worker(void* arg) {
+    auto self = static_cast<thread_pool*>(arg);
+    detail::job current;
+    for (;;) {
+      self->m_lock.lock();
+      while (self->m_count == 0 && !self->m_stop) {
+        self->park();
+        self->m_lock.unlock();
+        thread_flags_wait_any(RIOT_THREAD_POOL_THREAD_FLAG);
+        self->m_lock.lock();
+      }
+      if (self->m_count == 0) {
+        self->m_lock.unlock();
+        return nullptr;
+      }
+      current.take(self->m_jobs[self->m_head]);
+      self->m_head = (self->m_head + 1) % QueueSize;
+      --self->m_count;
+      self->m_lock.unlock();
+      try {
+        current();
+      }
+      catch (...) {
+        // nop
+      }
+      current.reset();
+    }
+  }
+
+  /* adds the calling thread to the idle workers, called with the lock held */
+  void park() noexcept {
+    thread_t* me = const_cast<thread_t*>(sched_active_thread);
+    for (unsigned i = 0; i < m_idle_count; ++i) {
+      if (m_idle[i] == me) {
+        /* woken up by a stale flag */
+        return;
+      }
+    }
+    m_idle[m_idle_count++] = me;
+  }
+
+  bool is_running(unsigned i) const noexcept {
+    /* the thread control block is placed on the stack of the thread */
+    auto t = reinterpret_cast<const char*>(
+      const_cast<thread_t*>(thread_get(m_pids[i])));
+    return t >= m_stacks[i] && t < m_stacks[i] + StackSize;
+  }
+
+  mutex m_lock;
+  detail::job m_jobs[QueueSize];
+  unsigned m_head;
+  unsigned m_count;
+  thread_t* m_idle[Workers];
+  unsigned m_idle_count;
+  bool m_stop;
+  kernel_pid_t m_pids[Workers];
+  char m_stacks[Workers][StackSize];
+};
+
+/** @cond INTERNAL */
+namespace detail {
+
+template <class R>
+struct async_call {
+  template <class F, class Tuple, long... Is>
+  static void run(promise<R>& p, F& f, Tuple& args, int_list<Is...>) {
+    p.set_value(f(std::move(std::get<Is>(args))...));
+  }
+};
+
+template <>
+struct async_call<void> {
+  template <class F, class Tuple, long... Is>
+  static void run(promise<void>& p, F& f, Tuple& args, int_list<Is...>) {
+    f(std::move(std::get<Is>(args))...);
+    p.set_value();
+  }
+};
+
+template <class R, class F, class... Args>
+class async_job {
+public:
+  async_job(promise<R>&& p, F&& f, Args&&... args)
+      : m_promise{std::move(p)}, m_func{std::move(f)},
+        m_args{std::move(args)...} {}
+  async_job(async_job&&) = default;
+
+  void operator()() {
+    try {
+      async_call<R>::run(m_promise, m_func, m_args,
+                         typename il_indices<sizeof...(Args)>::type{});
+    }
+    catch (...) {
+      m_promise.set_exception(std::current_exception());
+    }
+  }
+
+private:
+  promise<R> m_promise;
+  F m_func;
+  std::tuple<Args...> m_args;
+};
+
+} // namespace detail
+/** @endcond */
+
+/**
+ * @brief Runs a function on a thread pool
+ *
+ * If the queue of @p pool is full, @p f is called by the calling thread
+ * before returning, like std::async() with `std::launch::deferred` would do
+ * on the first call to get().
+ *
+ * @param[in] pool  The thread pool.
+ * @param[in] f     The function.
+ * @param[in] args  Arguments of @p f, they are moved or copied into the job.
+ *
+ * @return  A future for the return value of @p f.
+ */
+template <class Pool, class F, class... Args>
+future<typename std::result_of<typename std::decay<F>::type(
+  typename std::decay<Args>::type...)>::type>
+async(Pool& pool, F&& f, Args&&... args) {
+  using result = typename std::result_of<typename std::decay<F>::type(
+    typename std::decay<Args>::type...)>::type;
+  using job_type = detail::async_job<result, typename std::decay<F>::type,
+                                     typename std::decay<Args>::type...>;
+  promise<result> p;
+  future<result> res = p.get_future();
+  job_type job{std::move(p), typename std::decay<F>::type(std::forward<F>(f)),
+               typename std::decay<Args>::type(std::forward<Args>(args))...};
+  if (!pool.submit(std::move(job))) {
+    job();
+  }
+  return res;
+}
+
+} // namespace riot
+
+#endif // RIOT_THREAD_POOL_HPP
@@ -22,7 +22,8 @@
  */
 
 #include <assert.h>
-
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "event.h"
@@ -41,9 +42,16 @@ void event_queue_init_detached(event_queue_t *queue)
 
 void event_queue_init(event_queue_t *queue)
 {
-    assert(queue);
-    memset(queue, '\0', sizeof(*queue));
-    queue->waiter = (thread_t *)sched_active_thread;
+    event_queues_init(queue, 1);
+}
+
+void event_queues_init(event_queue_t *queues, size_t n_queues)
+{
+    assert(queues && n_queues);
+    memset(queues, '\0', sizeof(*queues) * n_queues);
+    for (size_t i = 0; i < n_queues; i++) {
+        queues[i].waiter = (thread_t *)sched_active_thread;
+    }
 }
 
 void event_queue_claim(event_queue_t *queue)
@@ -52,21 +60,135 @@ void event_queue_claim(event_queue_t *queue)
     queue->waiter = (thread_t *)sched_active_thread;
 }
 
-void event_post(event_queue_t *queue, event_t *event)
+#ifdef MODULE_EVENT_LOCKFREE
+/* marks an event as queued while it is posted and ends the pending list */
+static clist_node_t _claimed;
+
+/* set by event_cancel() in the link of an event whose event_post() was
+ * interrupted, the event is then dropped instead of queued */
+#define CANCELLED       ((uintptr_t)1)
+
+static inline bool _is_cancelled(clist_node_t *link)
 {
-    assert(queue && event);
+    return (uintptr_t)link & CANCELLED;
+}
+
+static inline clist_node_t *_untag(clist_node_t *link)
+{
+    return (clist_node_t *)((uintptr_t)link & ~CANCELLED);
+}
 
+static void _enqueue(event_queue_t *queue, event_t *event)
+{
+    clist_node_t *link = NULL;
+
+    while (!__atomic_compare_exchange_n(&event->list_node.next, &link,
+                                        &_claimed, false, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+        if (!_is_cancelled(link)) {
+            /* already queued */
+            return;
+        }
+        /* posted again after a cancel: the interrupted post queues it */
+        if (__atomic_compare_exchange_n(&event->list_node.next, &link,
+                                        _untag(link), false, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+            return;
+        }
+        link = NULL;
+    }
+
+    link = &_claimed;
+    event_t *head = __atomic_load_n(&queue->pending, __ATOMIC_RELAXED);
+    do {
+        clist_node_t *next = head ? &head->list_node : &_claimed;
+
+        while (!__atomic_compare_exchange_n(&event->list_node.next, &link,
+                                            next, false, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+            /* cancelled while being posted, unless posted again meanwhile */
+            if (__atomic_compare_exchange_n(&event->list_node.next, &link,
+                                            NULL, false, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                return;
+            }
+        }
+        link = next;
+    } while (!__atomic_compare_exchange_n(&queue->pending, &head, event, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/* moves the lock-free posted events to the queue, IRQs must be disabled */
+static void _drain(event_queue_t *queue)
+{
+    event_t *event = __atomic_exchange_n(&queue->pending, NULL,
+                                         __ATOMIC_ACQUIRE);
+    clist_node_t *fifo = &_claimed;
+
+    /* the pending list is newest first, reverse it to keep the order */
+    while (event) {
+        clist_node_t *next = event->list_node.next;
+
+        if (_is_cancelled(next)) {
+            /* cancelled before its post completed */
+            event->list_node.next = NULL;
+            next = _untag(next);
+        }
+        else {
+            event->list_node.next = fifo;
+            fifo = &event->list_node;
+        }
+        event = (next == &_claimed) ? NULL : (event_t *)next;
+    }
+    while (fifo != &_claimed) {
+        clist_node_t *next = fifo->next;
+        clist_rpush(&queue->event_list, fifo);
+        fifo = next;
+    }
+}
+
+/* an event that is neither in the list nor unqueued is being posted by an
+ * interrupted event_post(), IRQs must be disabled */
+static void _cancel_post(event_t *event)
+{
+    clist_node_t *link = event->list_node.next;
+
+    if (link) {
+        event->list_node.next = (clist_node_t *)((uintptr_t)link | CANCELLED);
+    }
+}
+#else
+static void _enqueue(event_queue_t *queue, event_t *event)
+{
     unsigned state = irq_disable();
     if (!event->list_node.next) {
         clist_rpush(&queue->event_list, &event->list_node);
     }
-    thread_t *waiter = queue->waiter;
     irq_restore(state);
+}
+
+static inline void _drain(event_queue_t *queue)
+{
+    (void)queue;
+}
+
+static inline void _cancel_post(event_t *event)
+{
+    (void)event;
+}
+#endif
+
+void event_post(event_queue_t *queue, event_t *event)
+{
+    assert(queue && event);
+
+    _enqueue(queue, event);
+    thread_t *waiter = queue->waiter;
 
     /* WARNING: there is a minimal chance, that a waiter claims a formerly
-     *          detached queue between the end of the critical section above and
-     *          the block below. In that case, the new waiter will not be woken
-     *          up. This should be fixed at some point once it is safe to call
+     *          detached queue between reading the waiter above and the block
+     *          below. In that case, the new waiter will not be woken up. This
+     *          should be fixed at some point once it is safe to call
      *          thread_flags_set() inside a critical section on all platforms. */
     if (waiter) {
         thread_flags_set(waiter, THREAD_FLAG_EVENT);
@@ -79,15 +201,25 @@ void event_cancel(event_queue_t *queue, event_t *event)
     assert(event);
 
     unsigned state = irq_disable();
-    clist_remove(&queue->event_list, &event->list_node);
-    event->list_node.next = NULL;
+    _drain(queue);
+    if (clist_remove(&queue->event_list, &event->list_node)) {
+        event->list_node.next = NULL;
+    }
+    else {
+        _cancel_post(event);
+    }
     irq_restore(state);
 }
 
-event_t *event_get(event_queue_t *queue)
+event_t *event_get_multi(event_queue_t *queues, size_t n_queues)
 {
+    event_t *result = NULL;
+
     unsigned state = irq_disable();
-    event_t *result = (event_t *) clist_lpop(&queue->event_list);
+    for (size_t i = 0; (result == NULL) && (i < n_queues); i++) {
+        _drain(&queues[i]);
+        result = (event_t *)clist_lpop(&queues[i].event_list);
+    }
     irq_restore(state);
 
     if (result) {
@@ -96,24 +228,28 @@ event_t *event_get(event_queue_t *queue)
     return result;
 }
 
-event_t *event_wait(event_queue_t *queue)
+event_t *event_get(event_queue_t *queue)
 {
-    assert(queue);
+    return event_get_multi(queue, 1);
+}
+
+event_t *event_wait_multi(event_queue_t *queues, size_t n_queues)
+{
+    assert(queues && n_queues);
     event_t *result;
 
-    do {
-        unsigned state = irq_disable();
-        result = (event_t *)clist_lpop(&queue->event_list);
-        irq_restore(state);
-        if (result == NULL) {
-            thread_flags_wait_any(THREAD_FLAG_EVENT);
-        }
-    } while (result == NULL);
+    while ((result = event_get_multi(queues, n_queues)) == NULL) {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
 
-    result->list_node.next = NULL;
     return result;
 }
 
+event_t *event_wait(event_queue_t *queue)
+{
+    return event_wait_multi(queue, 1);
+}
+
 #ifdef MODULE_XTIMER
 event_t *event_wait_timeout(event_queue_t *queue, uint32_t timeout)
 {
@@ -146,3 +282,12 @@ void event_loop(event_queue_t *queue)
         event->handler(event);
     }
 }
+
+void event_loop_multi(event_queue_t *queues, size_t n_queues)
+{
+    event_t *event;
+
+    while ((event = event_wait_multi(queues, n_queues))) {
+        event->handler(event);
+    }
+}
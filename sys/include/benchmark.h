@@ -10,6 +10,28 @@
  * @defgroup    sys_benchmark Benchmark
  * @ingroup     sys
  * @brief       Framework for running simple runtime benchmarks
+ *
+ * @ref BENCHMARK_SAMPLES() runs a function call in a loop for a number of
+ * samples, after discarding @ref BENCHMARK_WARMUP_SAMPLES warm-up samples.
+ * The minimum, median, 99th percentile, maximum, mean and standard deviation
+ * of the time per call are printed as one JSON object per line, e.g.:
+ *
+ *     {"benchmark": "mutex lock/unlock", "runs": 10000, "samples": 16,
+ *      "unit": "ns", "min": 212, "median": 215, "p99": 240, "max": 240,
+ *      "mean": 217, "stddev": 7}
+ *
+ * (printed as a single line). `dist/tools/benchmark/benchmark.py` collects
+ * these lines from test applications on `native` and compares them against
+ * a stored baseline.
+ *
+ * The time is taken with the DWT cycle counter on Cortex-M CPUs that have
+ * one and with @ref sys_xtimer otherwise (see @ref benchmark_clock()).
+ *
+ * Benchmarks that need interrupts, e.g. because they involve multiple threads
+ * or wait for peripherals, use @ref benchmark_run() instead, which takes the
+ * samples with interrupts enabled. Code that does not fit in a function
+ * taking one sample can use @ref benchmark_result_init(),
+ * @ref benchmark_result_add() and @ref benchmark_result_print() directly.
  * @{
  *
  * @file
@@ -23,16 +45,130 @@
 
 #include <stdint.h>
 
+#include "cpu.h"
 #include "irq.h"
+#include "periph_conf.h"
 #include "xtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of samples taken and discarded before the measured ones
+ */
+#ifndef BENCHMARK_WARMUP_SAMPLES
+#define BENCHMARK_WARMUP_SAMPLES    (1U)
+#endif
+
+/**
+ * @brief   Maximum number of samples of a benchmark
+ */
+#ifndef BENCHMARK_SAMPLES_MAX
+#define BENCHMARK_SAMPLES_MAX       (32U)
+#endif
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CLOCK_CORECLOCK) || \
+    defined(DOXYGEN)
+/**
+ * @brief   Frequency of @ref benchmark_clock() in Hz
+ */
+#define BENCHMARK_CLOCK_HZ          (CLOCK_CORECLOCK)
+
+/**
+ * @brief   Starts the clock used for benchmarks
+ */
+static inline void benchmark_clock_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief   Reads the clock used for benchmarks
+ *
+ * @return  The current clock value in ticks of @ref BENCHMARK_CLOCK_HZ.
+ */
+static inline uint32_t benchmark_clock(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+#define BENCHMARK_CLOCK_HZ          (1000000UL)
+
+static inline void benchmark_clock_init(void)
+{
+}
+
+static inline uint32_t benchmark_clock(void)
+{
+    return xtimer_now_usec();
+}
+#endif
+
+/**
+ * @brief   Results of a benchmark
+ */
+typedef struct {
+    const char *name;           /**< name of the benchmark */
+    unsigned long runs;         /**< number of calls per sample */
+    unsigned samples;           /**< number of samples taken */
+    /**
+     * @brief   Duration of each sample in ticks of @ref BENCHMARK_CLOCK_HZ
+     */
+    uint32_t ticks[BENCHMARK_SAMPLES_MAX];
+} benchmark_result_t;
+
+/**
+ * @brief   Function taking one sample of a benchmark run by
+ *          @ref benchmark_run()
+ *
+ * @param[in] arg       argument given to @ref benchmark_run()
+ *
+ * @return  0 on success
+ * @return  negative value on error
+ */
+typedef int (*benchmark_sample_t)(void *arg);
+
+/**
+ * @brief   Measure the runtime of a given function call for multiple samples
+ *          and print the statistics
+ *
+ * Interrupts are disabled while a sample is taken.
+ *
+ * @param[in] name      name for labeling the output
+ * @param[in] samples   number of samples to take, at most
+ *                      @ref BENCHMARK_SAMPLES_MAX
+ * @param[in] runs      number of times to run @p func per sample
+ * @param[in] func      function call to benchmark
+ */
+#define BENCHMARK_SAMPLES(name, samples, runs, func)                        \
+    {                                                                       \
+        benchmark_result_t _benchmark_res;                                  \
+        benchmark_result_init(&_benchmark_res, name, runs);                 \
+        for (unsigned _benchmark_s = 0;                                     \
+             _benchmark_s < (BENCHMARK_WARMUP_SAMPLES + (samples));         \
+             _benchmark_s++) {                                              \
+            unsigned _benchmark_irqstate = irq_disable();                   \
+            uint32_t _benchmark_time = benchmark_clock();                   \
+            for (unsigned long i = 0; i < (runs); i++) {                    \
+                func;                                                       \
+            }                                                               \
+            _benchmark_time = benchmark_clock() - _benchmark_time;          \
+            irq_restore(_benchmark_irqstate);                               \
+            if (_benchmark_s >= BENCHMARK_WARMUP_SAMPLES) {                 \
+                benchmark_result_add(&_benchmark_res, _benchmark_time);     \
+            }                                                               \
+        }                                                                   \
+        benchmark_result_print(&_benchmark_res);                            \
+    }
+
 /**
  * @brief   Measure the runtime of a given function call
  *
+ * @deprecated  Use @ref BENCHMARK_SAMPLES() instead, which gives statistics
+ *              over multiple samples and machine-readable output.
+ *
  * As we are doing a time sensitive measurement here, there is no way around
  * using a preprocessor function, as going with a function pointer or similar
  * would influence the measured runtime...
@@ -62,6 +198,67 @@ extern "C" {
  */
 void benchmark_print_time(uint32_t time, unsigned long runs, const char *name);
 
+/**
+ * @brief   Initializes a benchmark result and starts the benchmark clock
+ *
+ * @param[out] res      result to initialize
+ * @param[in] name      name to label the output
+ * @param[in] runs      number of calls per sample
+ */
+void benchmark_result_init(benchmark_result_t *res, const char *name,
+                           unsigned long runs);
+
+/**
+ * @brief   Adds a sample to a benchmark result
+ *
+ * Samples beyond @ref BENCHMARK_SAMPLES_MAX are ignored.
+ *
+ * @param[in,out] res   benchmark result
+ * @param[in] ticks     duration of the sample in ticks of
+ *                      @ref BENCHMARK_CLOCK_HZ
+ */
+void benchmark_result_add(benchmark_result_t *res, uint32_t ticks);
+
+/**
+ * @brief   Takes the samples of a benchmark and prints the statistics
+ *
+ * Calls @p sample @ref BENCHMARK_WARMUP_SAMPLES times to warm up and then
+ * @p samples times, adding the duration of each call to @p res. Unlike
+ * @ref BENCHMARK_SAMPLES(), interrupts stay enabled, so @p sample may block.
+ * @p sample does all benchmark_result_t::runs calls of a sample.
+ *
+ * @param[in,out] res   benchmark result, initialized with
+ *                      @ref benchmark_result_init()
+ * @param[in] samples   number of samples to take, at most
+ *                      @ref BENCHMARK_SAMPLES_MAX
+ * @param[in] sample    function taking one sample
+ * @param[in] arg       argument for @p sample
+ *
+ * @return  0 on success
+ * @return  the error returned by @p sample, nothing is printed then
+ */
+int benchmark_run(benchmark_result_t *res, unsigned samples,
+                  benchmark_sample_t sample, void *arg);
+
+/**
+ * @brief   Get the mean duration of the samples of a benchmark result
+ *
+ * @param[in] res       benchmark result
+ *
+ * @return  mean duration of a sample in ticks of @ref BENCHMARK_CLOCK_HZ
+ * @return  0 if there are no samples
+ */
+uint32_t benchmark_result_mean(const benchmark_result_t *res);
+
+/**
+ * @brief   Output the statistics of a benchmark result as JSON on STDIO
+ *
+ * All values are the time per call in nanoseconds.
+ *
+ * @param[in] res       benchmark result
+ */
+void benchmark_result_print(const benchmark_result_t *res);
+
 #ifdef __cplusplus
 }
 #endif
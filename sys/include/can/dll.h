@@ -29,6 +29,13 @@ extern "C" {
 #include "can/device.h"
 #include "thread.h"
 
+#ifndef CAN_DLL_RX_BATCH_SIZE
+/**
+ * @brief Max number of received frames handed to the router at once
+ */
+#define CAN_DLL_RX_BATCH_SIZE   (8)
+#endif
+
 /**
  * @brief Initialize the CAN DLL
  *
@@ -62,6 +69,23 @@ int can_dll_register_candev(candev_dev_t *candev);
  */
 int can_dll_dispatch_rx_frame(struct can_frame *frame, kernel_pid_t pid);
 
+/**
+ * @brief Dispatch several received frames
+ *
+ * Same as @ref can_dll_dispatch_rx_frame() for each of the @p count
+ * @p frames, but the frames are handed to the router in batches of up to
+ * @ref CAN_DLL_RX_BATCH_SIZE.
+ *
+ * @param[in] frames the received frames
+ * @param[in] count  number of frames in @p frames
+ * @param[in] pid    the pid of the receiver device
+ *
+ * @return 0 on success
+ * @return -ENOMEM if at least one frame could not be dispatched
+ */
+int can_dll_dispatch_rx_batch(struct can_frame *frames, unsigned count,
+                              kernel_pid_t pid);
+
 /**
  * @brief Dispatch a tx confirmation
  *
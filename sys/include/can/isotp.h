@@ -27,6 +27,7 @@ extern "C" {
 
 #include "can/can.h"
 #include "can/common.h"
+#include "iolist.h"
 #include "thread.h"
 #include "xtimer.h"
 #include "net/gnrc/pktbuf.h"
@@ -45,6 +46,23 @@ extern "C" {
 #define CAN_ISOTP_STMIN     (5)
 #endif
 
+#ifndef CAN_ISOTP_TX_PIPELINE
+/**
+ * @brief   Max number of Consecutive Frames queued at once
+ *
+ * When the receiver allows a STmin of 0, up to this number of Consecutive
+ * Frames of a block are handed to the DLL without waiting for the
+ * confirmation of each one. A small value lets other channels send in between.
+ *
+ * All these frames have the same CAN ID, so a value above 1 is only safe if
+ * the CAN driver sends queued frames of the same ID in the order they were
+ * queued, e.g. SocketCAN on native, or stm32 with
+ * can_conf_t::txfp set. Drivers picking the first free TX mailbox would
+ * reorder the frames and break the sequence numbers.
+ */
+#define CAN_ISOTP_TX_PIPELINE   (1)
+#endif
+
 #ifndef CAN_ISOTP_WFTMAX
 /**
  * @brief   Default maximum WFT for TX Flow Control
@@ -96,6 +114,9 @@ struct tpcon {
     uint8_t sn;           /**< current sequence number */
     int tx_handle;        /**< handle of the last sent frame */
     gnrc_pktsnip_t *snip; /**< allocated snip containing data buffer */
+    const iolist_t *iol;  /**< data to send in place, if @p snip is NULL */
+    unsigned iol_off;     /**< current offset in @p iol */
+    unsigned len;         /**< length of the data to send */
 };
 
 /**
@@ -171,6 +192,23 @@ kernel_pid_t isotp_init(char *stack, int stacksize, char priority, const char *n
  */
 int isotp_send(struct isotp *isotp, const void *buf, int len, int flags);
 
+/**
+ * @brief Send data through an isotp channel without copying it
+ *
+ * The frames are filled directly from the buffers of @p iolist, so neither
+ * the list nor the buffers may be changed until the CAN_MSG_TX_CONFIRMATION
+ * or CAN_MSG_TX_ERROR message for this channel has been received. For this
+ * reason CAN_ISOTP_TX_DONT_WAIT can't be used.
+ *
+ * @param isotp           the channel to use
+ * @param iolist          the data to send
+ * @param flags           flags for sending
+ *
+ * @return the number of bytes sent
+ * @return < 0 if an error occurred  (-EBUSY, -EINVAL)
+ */
+int isotp_send_iolist(struct isotp *isotp, const iolist_t *iolist, int flags);
+
 /**
  * @brief Bind an isotp channel
  *
@@ -189,6 +227,18 @@ int isotp_send(struct isotp *isotp, const void *buf, int len, int flags);
 int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg,
                struct isotp_fc_options *fc_options);
 
+/**
+ * @brief Change the flow control parameters of a bound isotp channel
+ *
+ * The block size and STmin of @p fc_options are announced in the next flow
+ * control frame, e.g. to let a peer send a large transfer faster once both
+ * sides agreed on it. wftmax limits the wait frames accepted from now on.
+ *
+ * @param isotp           the channel
+ * @param fc_options      the new flow control parameters
+ */
+void isotp_set_fc(struct isotp *isotp, const struct isotp_fc_options *fc_options);
+
 /**
  * @brief Release a bound isotp channel
  *
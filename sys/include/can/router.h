@@ -80,9 +80,12 @@ int can_router_free_frame(struct can_frame *frame);
 /**
  * @brief Dispatch a RX indication to subscribers threads
  *
- * This function goes through the list of subscribed filters to send a message to each
- * subscriber's thread. If all the subscriber's threads cannot receive message,
- * the packet is freed.
+ * This function looks up the subscribed filters matching the frame to send a
+ * message to each subscriber's thread. If all the subscriber's threads cannot
+ * receive message, the packet is freed.
+ *
+ * The look-up does not block, so this function can be called from interrupt
+ * context.
  *
  * @param[in] pkt   the packet to dispatch
  *
@@ -91,6 +94,21 @@ int can_router_free_frame(struct can_frame *frame);
  */
 int can_router_dispatch_rx_indic(can_pkt_t *pkt);
 
+/**
+ * @brief Dispatch several RX indications to subscribers threads
+ *
+ * Same as @ref can_router_dispatch_rx_indic() for each packet of @p pkts, in
+ * order, but the filter table is entered only once for the whole batch.
+ *
+ * @param[in] pkts  the packets to dispatch
+ * @param[in] count number of packets in @p pkts
+ *
+ * @return 0 on success
+ * @return < 0 on error, if at least one packet could not be dispatched to
+ *         all of its subscribers
+ */
+int can_router_dispatch_rx_batch(can_pkt_t **pkts, unsigned count);
+
 /**
  * @brief Dispatch a TX confirmation to the sender's thread
  *
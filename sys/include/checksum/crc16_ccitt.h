@@ -61,6 +61,24 @@ uint16_t crc16_ccitt_update(uint16_t crc, const unsigned char *buf, size_t len);
  */
 uint16_t crc16_ccitt_calc(const unsigned char *buf, size_t len);
 
+/**
+ * @brief           Update CRC16-CCITT, least significant bit first
+ *
+ * Reflected variant of crc16_ccitt_update(), as used by the IEEE 802.15.4
+ * frame check sequence and CRC-16/KERMIT (start value 0). It yields the same
+ * result as `ucrc16_calc_le(buf, len, UCRC16_CCITT_POLY_LE, crc)`.
+ *
+ * @param[in]  crc  A start value for the CRC calculation, usually the
+ *                  return value of a previous call to
+ *                  crc16_ccitt_le_update()
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ * @return          Checksum of the specified memory area based on the
+ *                  given start value
+ */
+uint16_t crc16_ccitt_le_update(uint16_t crc, const unsigned char *buf,
+                               size_t len);
+
 
 #ifdef __cplusplus
 }
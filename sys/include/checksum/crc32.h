@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc32      CRC32
+ * @ingroup     sys_checksum
+ * @brief       Table driven CRC-32 and CRC-32C checksum algorithms
+ *
+ * Implements CRC-32 (IEEE 802.3, Ethernet, zlib, PNG, polynomial
+ * `0x04c11db7`) and CRC-32C (Castagnoli, iSCSI, SCTP, polynomial
+ * `0x1edc6f41`), both reflected with initial value and final XOR `0xffffffff`.
+ *
+ * The look-up tables are constant and are placed in ROM. Their size is
+ * controlled by @ref CONFIG_CHECKSUM_CRC32_SLICES:
+ *
+ * | Slices | ROM per algorithm | Bytes per table look-up |
+ * |:------:|:-----------------:|:-----------------------:|
+ * | 1      | 1 KiB             | 1                       |
+ * | 4      | 4 KiB             | 4 (slice-by-4)          |
+ * | 8      | 8 KiB             | 8 (slice-by-8)          |
+ *
+ * If the CPU provides CRC instructions, they are used instead of the tables:
+ * the ARMv8 CRC32 extension (`__ARM_FEATURE_CRC32`) for both algorithms and
+ * SSE 4.2 (`__SSE4_2__`, e.g. on `native` with `CFLAGS += -msse4.2`) for
+ * CRC-32C.
+ *
+ * @{
+ *
+ * @file
+ * @brief   CRC-32 and CRC-32C definitions
+ */
+#ifndef CHECKSUM_CRC32_H
+#define CHECKSUM_CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of look-up tables used per algorithm (1, 4 or 8)
+ */
+#ifndef CONFIG_CHECKSUM_CRC32_SLICES
+#define CONFIG_CHECKSUM_CRC32_SLICES    (1)
+#endif
+
+/**
+ * @brief   Update CRC-32
+ *
+ * @param[in] crc   Checksum of the preceding data, as returned by
+ *                  crc32_calc() or crc32_update(), or 0 for the first part
+ * @param[in] buf   Start of the memory area to checksum
+ * @param[in] len   Number of bytes in @p buf to calculate checksum for
+ *
+ * @return  Checksum of the preceding data and the specified memory area
+ */
+uint32_t crc32_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief   Calculate CRC-32
+ *
+ * @param[in] buf   Start of the memory area to checksum
+ * @param[in] len   Number of bytes in @p buf to calculate checksum for
+ *
+ * @return  Checksum of the specified memory area
+ */
+static inline uint32_t crc32_calc(const void *buf, size_t len)
+{
+    return crc32_update(0, buf, len);
+}
+
+/**
+ * @brief   Update CRC-32C
+ *
+ * @param[in] crc   Checksum of the preceding data, as returned by
+ *                  crc32c_calc() or crc32c_update(), or 0 for the first part
+ * @param[in] buf   Start of the memory area to checksum
+ * @param[in] len   Number of bytes in @p buf to calculate checksum for
+ *
+ * @return  Checksum of the preceding data and the specified memory area
+ */
+uint32_t crc32c_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief   Calculate CRC-32C
+ *
+ * @param[in] buf   Start of the memory area to checksum
+ * @param[in] len   Number of bytes in @p buf to calculate checksum for
+ *
+ * @return  Checksum of the specified memory area
+ */
+static inline uint32_t crc32c_calc(const void *buf, size_t len)
+{
+    return crc32c_update(0, buf, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKSUM_CRC32_H */
+/** @} */
@@ -47,6 +47,30 @@
  * to be queued. Thus event queues can be used safely and efficiently in combination
  * with thread flags and msg queues.
  *
+ * A thread can serve multiple event queues with different priorities using
+ * event_queues_init() and event_loop_multi(). The queues are passed as an
+ * array, with the queue at index 0 having the highest priority. An event is
+ * only taken from a queue if all queues with a higher priority are empty, so
+ * urgent events don't have to wait behind bulk work:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static event_queue_t queues[2];   // queues[0]: urgent, queues[1]: bulk
+ *
+ * int main(void)
+ * {
+ *     event_queues_init(queues, ARRAY_SIZE(queues));
+ *     event_loop_multi(queues, ARRAY_SIZE(queues));
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * By default, event_post() appends the event inside a critical section. With
+ * `USEMODULE += event_lockfree`, event_post() pushes the event on a lock-free
+ * list using compare-and-swap instead, so posting from ISRs or threads never
+ * disables interrupts. The owning thread moves these events into the queue
+ * on its next call to event_get() or event_wait(), so their order is kept.
+ * On CPUs without compare-and-swap instructions (e.g. Cortex-M0), the atomic
+ * operations are emulated by disabling interrupts, so there is no gain.
+ *
  * Examples:
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
@@ -96,6 +120,7 @@
 #ifndef EVENT_H
 #define EVENT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "irq.h"
@@ -147,6 +172,9 @@ struct event {
 typedef struct {
     clist_node_t event_list;    /**< list of queued events              */
     thread_t *waiter;           /**< thread ownning event queue         */
+#if defined(MODULE_EVENT_LOCKFREE) || defined(DOXYGEN)
+    event_t *pending;           /**< events posted lock-free, newest first */
+#endif
 } event_queue_t;
 
 /**
@@ -165,6 +193,16 @@ void event_queue_init(event_queue_t *queue);
  */
 void event_queue_init_detached(event_queue_t *queue);
 
+/**
+ * @brief   Initialize an array of event queues
+ *
+ * This will set the calling thread as owner of each queue in @p queues.
+ *
+ * @param[out]  queues      event queue objects to initialize
+ * @param[in]   n_queues    number of queues in @p queues
+ */
+void event_queues_init(event_queue_t *queues, size_t n_queues);
+
 /**
  * @brief   Bind an event queue to the calling thread
  *
@@ -193,10 +231,14 @@ void event_post(event_queue_t *queue, event_t *event);
 /**
  * @brief   Cancel a queued event
  *
- * This will remove a queued event from an event queue.
+ * This will remove a queued event from an event queue. An event_post() of
+ * @p event to @p queue that was interrupted by this function will not queue
+ * the event either.
  *
  * @note    Due to the underlying list implementation, this will run in O(n).
  *
+ * @pre     @p event is not queued in a queue other than @p queue
+ *
  * @param[in]   queue   event queue to remove event from
  * @param[in]   event   event to remove from queue
  */
@@ -231,6 +273,36 @@ event_t *event_get(event_queue_t *queue);
  */
 event_t *event_wait(event_queue_t *queue);
 
+/**
+ * @brief   Get next event from the queue with the highest priority,
+ *          non-blocking
+ *
+ * @param[in]   queues      event queues to get event from, the queue at
+ *                          index 0 has the highest priority
+ * @param[in]   n_queues    number of queues in @p queues
+ *
+ * @returns     pointer to next event
+ * @returns     NULL if all queues are empty
+ */
+event_t *event_get_multi(event_queue_t *queues, size_t n_queues);
+
+/**
+ * @brief   Get next event from the queue with the highest priority, blocking
+ *
+ * This function will block until an event becomes available in any of the
+ * queues. All queues must be owned by the calling thread.
+ *
+ * @note    Events in lower priority queues starve as long as higher priority
+ *          queues are not empty.
+ *
+ * @param[in]   queues      event queues to get event from, the queue at
+ *                          index 0 has the highest priority
+ * @param[in]   n_queues    number of queues in @p queues
+ *
+ * @returns     pointer to next event
+ */
+event_t *event_wait_multi(event_queue_t *queues, size_t n_queues);
+
 #if defined(MODULE_XTIMER) || defined(DOXYGEN)
 /**
  * @brief   Get next event from event queue, blocking until timeout expires
@@ -262,6 +334,18 @@ event_t *event_wait_timeout(event_queue_t *queue, uint32_t timeout);
  */
 void event_loop(event_queue_t *queue);
 
+/**
+ * @brief   Event loop serving multiple queues by priority
+ *
+ * Like event_loop(), but always handles the next event of the queue with the
+ * lowest index that is not empty.
+ *
+ * @param[in]   queues      event queues to process, the queue at index 0 has
+ *                          the highest priority
+ * @param[in]   n_queues    number of queues in @p queues
+ */
+void event_loop_multi(event_queue_t *queues, size_t n_queues);
+
 #ifdef __cplusplus
 }
 #endif
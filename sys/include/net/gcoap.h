@@ -152,8 +152,10 @@
  *
  * A CoAP client may register for Observe notifications for any resource that
  * an application has registered with gcoap. An application does not need to
- * take any action to support Observe client registration. However, gcoap
- * limits registration for a given resource to a _single_ observer.
+ * take any action to support Observe client registration. However, by default
+ * gcoap limits registration for a given resource to a _single_ observer. Set
+ * @ref GCOAP_OBS_MULTI_OBSERVERS to 1 to allow several observers per
+ * resource.
  *
  * It is [suggested](https://tools.ietf.org/html/rfc7641#section-6) that a
  * server adds the 'obs' attribute to resources that are useful for observation
@@ -187,7 +189,9 @@
  *    in the coap_pkt_t, for up to _payload_len_ bytes.
  *
  * Finally, call gcoap_obs_send() for the resource, with the sum of the
- * metadata length and payload length for the representation.
+ * metadata length and payload length for the representation. With
+ * @ref GCOAP_OBS_MULTI_OBSERVERS, this sends the notification to every observer
+ * of the resource, so the representation only needs to be created once.
  *
  * ### Other considerations ###
  *
@@ -542,6 +546,20 @@ extern "C" {
 #define GCOAP_OBS_REGISTRATIONS_MAX     (2)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Allow more than one observer per resource
+ *
+ * If set to 1, every client may register as observer of a resource, limited
+ * only by @ref GCOAP_OBS_REGISTRATIONS_MAX, and gcoap_obs_send() notifies all
+ * of them in one pass. The token of the notification is replaced for each
+ * observer, which requires an additional buffer of @ref GCOAP_PDU_BUF_SIZE
+ * bytes.
+ */
+#ifndef GCOAP_OBS_MULTI_OBSERVERS
+#define GCOAP_OBS_MULTI_OBSERVERS       (0)
+#endif
+
 /**
  * @name    States for the memo used to track Observe registrations
  * @{
@@ -859,7 +877,9 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  * @brief   Sends a buffer containing a CoAP Observe notification to the
  *          observer registered for a resource
  *
- * Assumes a single observer for a resource.
+ * Assumes a single observer for a resource, unless
+ * @ref GCOAP_OBS_MULTI_OBSERVERS is set. Then the notification is sent to all
+ * observers of @p resource, each with its own token.
  *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
@@ -933,6 +953,42 @@ ssize_t gcoap_encode_link(const coap_resource_t *resource, char *buf,
  */
 int gcoap_add_qstring(coap_pkt_t *pdu, const char *key, const char *val);
 
+#if defined(TEST_SUITES) || defined(DOXYGEN)
+/**
+ * @brief   Handles a request as if it was received from @p remote
+ *
+ * @note    Only available when @ref TEST_SUITES is defined
+ *
+ * @param[in,out] pdu   Parsed request, is turned into the response.
+ * @param[in,out] buf   Buffer of @p pdu.
+ * @param[in] len       Length of @p buf.
+ * @param[in] remote    Endpoint the request was received from.
+ *
+ * @return  Length of the response.
+ * @return  -1, if no response is to be sent.
+ */
+ssize_t gcoap_handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         sock_udp_ep_t *remote);
+
+/**
+ * @brief   Removes all observers and Observe registrations
+ *
+ * @note    Only available when @ref TEST_SUITES is defined
+ */
+void gcoap_obs_reset(void);
+
+/**
+ * @brief   Returns a pointer to the array of Observe registrations
+ *
+ * @note    Only available when @ref TEST_SUITES is defined
+ *
+ * @return  The first of the @ref GCOAP_OBS_REGISTRATIONS_MAX registrations.
+ *          Unused registrations have gcoap_observe_memo_t::observer set to
+ *          NULL.
+ */
+const gcoap_observe_memo_t *gcoap_obs_memo_array(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
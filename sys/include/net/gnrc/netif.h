@@ -44,6 +44,9 @@
 #include "net/gnrc/netif/dedup.h"
 #endif
 #include "net/gnrc/netif/flags.h"
+#ifdef MODULE_GNRC_NETIF_OPT_CACHE
+#include "net/gnrc/netif/opt_cache.h"
+#endif
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/netif/ipv6.h"
 #endif
@@ -120,6 +123,23 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_GNRC_NETIF_OPT_CACHE) || DOXYGEN
+    /**
+     * @brief   Lock-free snapshot of frequently read options
+     *
+     * @note    Only available with @ref net_gnrc_netif_opt_cache.
+     */
+    gnrc_netif_opt_cache_t opt_cache;
+#endif
+#if defined(MODULE_GNRC_PKTLATENCY) || DOXYGEN
+    /**
+     * @brief   Time in microseconds of the oldest device interrupt not
+     *          handled yet, 0 if none
+     *
+     * @note    Only available with @ref net_gnrc_pktlatency.
+     */
+    uint32_t latency_isr;
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
@@ -283,6 +303,34 @@ gnrc_netif_t *gnrc_netif_iter(const gnrc_netif_t *prev);
  */
 gnrc_netif_t *gnrc_netif_get_by_pid(kernel_pid_t pid);
 
+#if defined(MODULE_GNRC_NETIF_OPT_CACHE) || DOXYGEN
+/**
+ * @brief   Gets an option of an interface from its lock-free option cache
+ *
+ * This does not communicate with the interface's thread, so it is safe to
+ * call from any context. @ref netif_get_opt() tries this first and only
+ * falls back to @ref gnrc_netapi_get() if this fails.
+ *
+ * @pre `netif != NULL`
+ *
+ * @note    Only available with @ref net_gnrc_netif_opt_cache.
+ *
+ * @param[in] netif     The network interface.
+ * @param[in] opt       The option to get.
+ * @param[in] context   Context to the option (as for @ref gnrc_netapi_get()).
+ * @param[out] data     Buffer for the option's value.
+ * @param[in] max_len   Maximum length of @p data.
+ *
+ * @return  Number of bytes written to @p data (or a positive value for
+ *          boolean options without data) on success.
+ * @return  -ENOTSUP, if @p opt is not cached or @p max_len does not fit.
+ * @return  -EAGAIN, if no consistent snapshot could be read, because the
+ *          cache is currently being updated.
+ */
+int gnrc_netif_opt_cache_get(const gnrc_netif_t *netif, netopt_t opt,
+                             uint16_t context, void *data, size_t max_len);
+#endif
+
 /**
  * @brief   Gets the (unicast on anycast) IPv6 address of an interface (if IPv6
  *          is supported)
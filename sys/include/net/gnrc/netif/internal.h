@@ -56,6 +56,33 @@ void gnrc_netif_acquire(gnrc_netif_t *netif);
  */
 void gnrc_netif_release(gnrc_netif_t *netif);
 
+#if defined(MODULE_GNRC_NETIF_OPT_CACHE) || DOXYGEN
+/**
+ * @brief   Publishes the current option values of an interface to its
+ *          lock-free option cache
+ *
+ * Values stored within @p netif (e.g. gnrc_netif_t::cur_hl) are always
+ * refreshed. Values that need to be requested from the network device are
+ * only refreshed when called from the interface's thread.
+ *
+ * @pre `netif != NULL`
+ * @pre The caller holds the interface's lock (see gnrc_netif_acquire()).
+ *
+ * @note    Only available with @ref net_gnrc_netif_opt_cache. A no-op
+ *          otherwise.
+ *
+ * @param[in,out] netif The network interface.
+ *
+ * @internal
+ */
+void gnrc_netif_opt_cache_update(gnrc_netif_t *netif);
+#else
+static inline void gnrc_netif_opt_cache_update(gnrc_netif_t *netif)
+{
+    (void)netif;
+}
+#endif
+
 #if defined(MODULE_GNRC_IPV6) || DOXYGEN
 /**
  * @brief   Adds an IPv6 address to the interface
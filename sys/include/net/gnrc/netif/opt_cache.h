@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_opt_cache    Lock-free cache for interface options
+ * @ingroup     net_gnrc_netif
+ * @brief       Answers frequently read interface options without IPC
+ *
+ * To activate, use `USEMODULE += gnrc_netif_opt_cache` in your applications
+ * Makefile.
+ *
+ * Every @ref gnrc_netapi_get() to a network interface is a synchronous
+ * `msg_send_receive()` to the interface's thread and thus costs two context
+ * switches. With this module, options that are read often but change rarely
+ * are published by the interface in a snapshot guarded by a sequence lock
+ * (see gnrc_netif_t::opt_cache). Readers copy the value out of the snapshot
+ * and only fall back to the IPC path if the option is not cached or the
+ * snapshot is currently being updated.
+ *
+ * The snapshot is updated by the interface thread on initialization and
+ * after every @ref GNRC_NETAPI_MSG_TYPE_SET, and by GNRC-internal code
+ * whenever it changes one of the cached interface fields directly. Writers
+ * are serialized by the interface's lock (see @ref gnrc_netif_acquire()).
+ *
+ * Currently cached are
+ *
+ * - @ref NETOPT_HOP_LIMIT
+ * - @ref NETOPT_MAX_PDU_SIZE (both with context @ref GNRC_NETTYPE_IPV6 and
+ *   the device's)
+ * - @ref NETOPT_ADDRESS or @ref NETOPT_ADDRESS_LONG, whichever is the
+ *   interface's source address
+ * - @ref NETOPT_SRC_LEN
+ * - @ref NETOPT_IS_WIRED
+ * - @ref NETOPT_DEVICE_TYPE
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for the lock-free interface option cache
+ */
+#ifndef NET_GNRC_NETIF_OPT_CACHE_H
+#define NET_GNRC_NETIF_OPT_CACHE_H
+
+#include <stdint.h>
+
+#include "net/gnrc/netif/conf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of attempts a reader makes to get a consistent snapshot
+ *          before falling back to IPC
+ *
+ * On single core systems a reader can only see an update in progress if it
+ * preempted the writer, so retrying more than once or twice is pointless.
+ */
+#ifndef GNRC_NETIF_OPT_CACHE_RETRIES
+#define GNRC_NETIF_OPT_CACHE_RETRIES    (2U)
+#endif
+
+/**
+ * @name    Validity flags for gnrc_netif_opt_cache_t::valid
+ * @{
+ */
+#define GNRC_NETIF_OPT_CACHE_MAX_PDU_SIZE   (0x01U) /**< max_pdu_size is set */
+#define GNRC_NETIF_OPT_CACHE_SRC_LEN        (0x02U) /**< src_len is set */
+#define GNRC_NETIF_OPT_CACHE_IS_WIRED       (0x04U) /**< device is wired */
+#define GNRC_NETIF_OPT_CACHE_L2ADDR         (0x08U) /**< l2addr is set */
+#define GNRC_NETIF_OPT_CACHE_INIT           (0x80U) /**< cache was populated */
+/** @} */
+
+/**
+ * @brief   Snapshot of frequently read interface options
+ *
+ * @note    Must only be written using gnrc_netif_opt_cache_update() and read
+ *          using gnrc_netif_opt_cache_get()
+ */
+typedef struct {
+    /**
+     * @brief   Sequence counter
+     *
+     * Odd while an update is in progress, incremented twice per update.
+     */
+    unsigned seq;
+#if (GNRC_NETIF_L2ADDR_MAXLEN > 0) || DOXYGEN
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /**< source link-layer address */
+#endif
+    uint16_t max_pdu_size;                      /**< device's max. PDU size */
+    uint16_t ipv6_mtu;                          /**< IPv6 MTU */
+    uint16_t src_len;                           /**< source address length */
+    uint16_t device_type;                       /**< device type */
+    uint8_t l2addr_opt;                         /**< option of gnrc_netif_opt_cache_t::l2addr */
+    uint8_t l2addr_len;                         /**< length of gnrc_netif_opt_cache_t::l2addr */
+    uint8_t cur_hl;                             /**< current hop limit */
+    uint8_t valid;                              /**< validity flags */
+} gnrc_netif_opt_cache_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_OPT_CACHE_H */
+/** @} */
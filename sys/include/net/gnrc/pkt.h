@@ -120,6 +120,30 @@ typedef struct gnrc_pktsnip {
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
                                      *   packet snip */
 #endif
+#if defined(MODULE_GNRC_PKTLATENCY) || defined(DOXYGEN)
+    /**
+     * @brief   Time in microseconds the packet was handed to
+     *          gnrc_pktsnip_t::latency_pid
+     *
+     * @note    Only available with @ref net_gnrc_pktlatency.
+     * @internal
+     */
+    uint32_t latency_stamp;
+    /**
+     * @brief   Thread currently holding the packet
+     *
+     * @note    Only available with @ref net_gnrc_pktlatency.
+     * @internal
+     */
+    kernel_pid_t latency_pid;
+    /**
+     * @brief   Tracking state of the packet
+     *
+     * @note    Only available with @ref net_gnrc_pktlatency.
+     * @internal
+     */
+    uint8_t latency_flags;
+#endif
 } gnrc_pktsnip_t;
 
 /**
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktlatency Per-packet latency instrumentation
+ * @ingroup     net_gnrc
+ * @brief       Measures how long packets stay with each GNRC thread
+ *
+ * With `USEMODULE += gnrc_pktlatency` every packet is time-stamped whenever
+ * it is handed from one thread to another via @ref net_gnrc_netapi. The time
+ * between two hand-overs (queueing and processing) is accounted to the
+ * thread that held the packet, separately for the receive and the send
+ * direction. This makes it possible to see which layer is the bottleneck
+ * under load.
+ *
+ * A received packet starts being tracked when the network device signals the
+ * interrupt, so the time accounted to the interface thread includes the
+ * interrupt latency. Packets sent by an application start being tracked when
+ * they are handed to the first GNRC thread. Tracking ends when a @ref net_sock
+ * "sock" receives the packet, or when the interface thread starts
+ * transmitting it.
+ *
+ * The time stamp is stored in the packet snip that was handed over first,
+ * so it is kept while headers are added or marked. Packets that are copied
+ * into new snips (e.g. 6LoWPAN fragments) start being tracked again. If a
+ * packet is dispatched to multiple subscribers, only the first one is
+ * tracked.
+ *
+ * The statistics of each thread can be printed with the `pktlat` shell
+ * command.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Per-packet latency instrumentation definitions
+ */
+#ifndef NET_GNRC_PKTLATENCY_H
+#define NET_GNRC_PKTLATENCY_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "matstat.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup    net_gnrc_pktlatency_conf    GNRC per-packet latency compile configurations
+ * @ingroup     net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of histogram buckets per thread and direction
+ */
+#ifndef GNRC_PKTLATENCY_HIST_BUCKETS
+#define GNRC_PKTLATENCY_HIST_BUCKETS    (12U)
+#endif
+
+/**
+ * @brief   Upper bound of the first histogram bucket as power of 2 in
+ *          microseconds
+ *
+ * Bucket `i` counts latencies below `2^(GNRC_PKTLATENCY_HIST_SHIFT + i)`
+ * microseconds, the last bucket all latencies above.
+ */
+#ifndef GNRC_PKTLATENCY_HIST_SHIFT
+#define GNRC_PKTLATENCY_HIST_SHIFT      (4U)
+#endif
+/** @} */
+
+/**
+ * @name    Flags for gnrc_pktsnip_t::latency_flags
+ * @{
+ */
+#define GNRC_PKTLATENCY_TRACKED     (0x01)  /**< snip carries the time stamp */
+#define GNRC_PKTLATENCY_SND         (0x02)  /**< packet is being sent */
+/** @} */
+
+/**
+ * @brief   Direction of a packet
+ */
+typedef enum {
+    GNRC_PKTLATENCY_DIR_RCV = 0,    /**< received packets */
+    GNRC_PKTLATENCY_DIR_SND,        /**< sent packets */
+    GNRC_PKTLATENCY_DIR_NUMOF,      /**< number of directions */
+} gnrc_pktlatency_dir_t;
+
+/**
+ * @brief   Latency statistics of a thread for one direction
+ */
+typedef struct {
+    matstat_state_t stat;   /**< latency in microseconds */
+    /**
+     * @brief   Latency histogram
+     *
+     * @see @ref GNRC_PKTLATENCY_HIST_SHIFT
+     */
+    uint32_t hist[GNRC_PKTLATENCY_HIST_BUCKETS];
+} gnrc_pktlatency_stats_t;
+
+/**
+ * @brief   Starts tracking a packet
+ *
+ * Any earlier time stamp in @p pkt is discarded.
+ *
+ * @param[in] pkt   The packet.
+ * @param[in] since Time in microseconds (see xtimer_now_usec()) the packet
+ *                  arrived at @p pid.
+ * @param[in] pid   Thread holding the packet.
+ * @param[in] dir   Direction of the packet.
+ */
+void gnrc_pktlatency_start(gnrc_pktsnip_t *pkt, uint32_t since,
+                           kernel_pid_t pid, gnrc_pktlatency_dir_t dir);
+
+/**
+ * @brief   Accounts the time since the last hand-over of @p pkt and
+ *          time-stamps it for @p pid
+ *
+ * Starts tracking @p pkt if it was not tracked before.
+ *
+ * @param[in] pkt   The packet.
+ * @param[in] pid   The thread the packet is handed to. May be
+ *                  `KERNEL_PID_UNDEF`, if it is not known yet (e.g. for
+ *                  mailboxes). The time will then be accounted to the thread
+ *                  calling @ref gnrc_pktlatency_done().
+ * @param[in] cmd   The @ref net_gnrc_netapi command (@ref
+ *                  GNRC_NETAPI_MSG_TYPE_RCV or @ref GNRC_NETAPI_MSG_TYPE_SND)
+ *                  @p pkt is handed over with.
+ */
+void gnrc_pktlatency_handover(gnrc_pktsnip_t *pkt, kernel_pid_t pid,
+                              uint16_t cmd);
+
+/**
+ * @brief   Accounts the time since the last hand-over of @p pkt and stops
+ *          tracking it
+ *
+ * @param[in] pkt   The packet.
+ */
+void gnrc_pktlatency_done(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Gets the latency statistics of a thread
+ *
+ * @param[in] pid   A thread.
+ * @param[in] dir   Direction.
+ *
+ * @return  The statistics of @p pid in direction @p dir.
+ * @return  NULL, if @p pid is invalid.
+ */
+const gnrc_pktlatency_stats_t *gnrc_pktlatency_stats_get(kernel_pid_t pid,
+                                                         gnrc_pktlatency_dir_t dir);
+
+/**
+ * @brief   Resets the statistics of all threads
+ */
+void gnrc_pktlatency_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTLATENCY_H */
+/** @} */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_minfwd  Minimal fragment forwarding
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Provides minimal fragment forwarding using the VRB
+ * @see         [draft-ietf-lwig-6lowpan-virtual-reassembly-02](
+ *                  https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-02
+ *              )
+ *
+ * When the first fragment of a datagram is received and a route to its
+ * destination is known, @ref net_gnrc_sixlowpan_iphc creates a
+ * @ref net_gnrc_sixlowpan_frag_vrb "virtual reassembly buffer (VRB)" entry,
+ * re-compresses the first fragment for the next hop and hands it to this
+ * module. All subsequent fragments of that datagram are then looked up in the
+ * VRB, get their datagram tag and link-layer header rewritten and are queued
+ * to the outgoing interface right away, i.e. the datagram never occupies the
+ * @ref net_gnrc_sixlowpan_frag_rb "reassembly buffer".
+ *
+ * To activate, use `USEMODULE += gnrc_sixlowpan_frag_minfwd` in your
+ * applications Makefile. With `gnrc_sixlowpan_frag_stats` the number of
+ * forwarded datagrams and fragments is counted.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Minimal fragment forwarding definitions
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_MINFWD_H
+#define NET_GNRC_SIXLOWPAN_FRAG_MINFWD_H
+
+#include <stddef.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/sixlowpan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Forwards a subsequent fragment according to a VRB entry
+ *
+ * The datagram tag of @p pkt is rewritten in-place to
+ * gnrc_sixlowpan_frag_vrb_t::out_tag and the link-layer header is replaced
+ * by one addressed to the next hop of @p vrbe. The VRB entry is removed once
+ * the whole datagram was forwarded.
+ *
+ * @pre `vrbe != NULL`
+ * @pre `pkt != NULL`
+ * @pre `sixlowpan_frag_n_is(pkt->data)`
+ *
+ * @param[in] pkt       A subsequent fragment including its fragmentation
+ *                      header (in receive order, i.e. the link-layer header,
+ *                      if any, is in `pkt->next`). Is consumed by this
+ *                      function.
+ * @param[in] vrbe      VRB entry of the datagram @p pkt belongs to.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ *
+ * @return  0 on success. Duplicates of already forwarded fragments are
+ *          dropped silently.
+ * @return  -EINVAL, when @p pkt overlaps an already forwarded fragment. The
+ *          VRB entry is removed in that case.
+ * @return  -ENOMEM, when the packet buffer is too full to prepare the packet
+ *          for forwarding or there is no space left to record the fragment
+ *          in the VRB entry.
+ */
+int gnrc_sixlowpan_frag_minfwd_forward(gnrc_pktsnip_t *pkt,
+                                       gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                       unsigned page);
+
+/**
+ * @brief   Sends a re-compressed first fragment according to a VRB entry
+ *
+ * @pre `vrbe != NULL`
+ * @pre `pkt != NULL`
+ * @pre `pkt->type == GNRC_NETTYPE_SIXLOWPAN`, i.e. @p pkt starts with the
+ *      re-compressed IPHC header and has no link-layer header.
+ *
+ * @param[in] pkt       The re-compressed first fragment without fragmentation
+ *                      header (in send order). Is consumed by this function.
+ * @param[in] vrbe      VRB entry of the datagram @p pkt belongs to.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ *
+ * @return  0 on success.
+ * @return  -ENOBUFS, when the re-compressed fragment does not fit into a
+ *          single link-layer frame of the outgoing interface.
+ * @return  -ENOMEM, when the packet buffer is too full to prepare the packet
+ *          for forwarding.
+ */
+int gnrc_sixlowpan_frag_minfwd_frag_iphc(gnrc_pktsnip_t *pkt,
+                                         gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                         unsigned page);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_MINFWD_H */
+/** @} */
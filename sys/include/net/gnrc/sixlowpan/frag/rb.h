@@ -197,6 +197,26 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void);
  */
 void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry);
 
+/**
+ * @brief   Records the interval of a received fragment in a base entry
+ *
+ * Used to detect duplicate and overlapping fragments of datagrams that are
+ * not reassembled, e.g. fragments forwarded via a VRB entry.
+ *
+ * @param[in,out] entry     The base entry of the datagram.
+ * @param[in] offset        Offset of the fragment in the datagram.
+ * @param[in] frag_size     Size of the fragment's payload.
+ *
+ * @return  0, if the interval was added to @p entry.
+ * @return  -EALREADY, if a fragment with the same interval was received
+ *          already.
+ * @return  -EINVAL, if the fragment overlaps a received fragment partially.
+ *          The datagram must be discarded according to RFC 4944.
+ * @return  -ENOMEM, if there is no space left in the interval buffer.
+ */
+int gnrc_sixlowpan_frag_rb_base_add_interval(gnrc_sixlowpan_frag_rb_base_t *entry,
+                                             uint16_t offset, size_t frag_size);
+
 /**
  * @brief   Garbage collect reassembly buffer.
  */
@@ -229,18 +249,14 @@ int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf
  *
  * @pre `rbuf != NULL`
  *
- * This functions sets rbuf_t::super::pkt to NULL and removes all rbuf::ints.
+ * This functions sets rbuf_t::super::pkt to NULL, removes all rbuf::ints
+ * and makes the entry available for new datagrams.
  *
  * @note    Does nothing if module `gnrc_sixlowpan_frag_rb` is not included.
  *
  * @param[in] rbuf  A reassembly buffer entry. Must not be NULL.
  */
-static inline void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf)
-{
-    assert(rbuf != NULL);
-    gnrc_sixlowpan_frag_rb_base_rm(&rbuf->super);
-    rbuf->pkt = NULL;
-}
+void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf);
 #else
 /* NOPs to be used with gnrc_sixlowpan_iphc if gnrc_sixlowpan_frag_rb is not
  * compiled in */
@@ -39,6 +39,12 @@ typedef struct {
     unsigned vrb_full;      /**< counts the number of events where the virtual
                              *   reassembly buffer is full */
 #endif
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD) || DOXYGEN
+    unsigned fwd_datagrams; /**< counts the number of datagrams forwarded
+                             *   using the virtual reassembly buffer */
+    unsigned fwd_frags;     /**< counts the number of fragments forwarded
+                             *   using the virtual reassembly buffer */
+#endif
 } gnrc_sixlowpan_frag_stats_t;
 
 /**
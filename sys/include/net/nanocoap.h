@@ -64,6 +64,10 @@
  * and exact matching should be register, and then a second one with the path
  * `/resource01/` and subtree matching.
  *
+ * Resources must be sorted by their path (by the ASCII encoding of the path
+ * characters), as the lookup of the resource for a request uses binary search.
+ * If more than one resource matches a request, the first one is used.
+ *
  * @{
  *
  * @file
@@ -1456,6 +1460,35 @@ extern ssize_t coap_well_known_core_default_handler(coap_pkt_t *pkt, \
  */
 int coap_match_path(const coap_resource_t *resource, uint8_t *uri);
 
+/**
+ * @brief   Finds the resource for a given URI and method in a resource array
+ *
+ * @p resources must be sorted by coap_resource_t::path, as required for
+ * resource arrays anyway, so that the lookup can use binary search instead of
+ * checking every resource. Resources with @ref COAP_MATCH_SUBTREE are
+ * considered by only visiting the paths that are a prefix of @p uri. If more
+ * than one resource matches, the first one in @p resources is chosen.
+ *
+ * @note This function is not intended for application use.
+ * @internal
+ *
+ * @param[in] resources         Array of resources, sorted by path
+ * @param[in] resources_numof   Number of entries in @p resources
+ * @param[in] uri               Null-terminated string URI to look up
+ * @param[in] method_flag       Method of the request as flag, see
+ *                              coap_method2flag()
+ * @param[out] resource         The matching resource. Not changed if no
+ *                              resource was found.
+ *
+ * @return  0, if a matching resource was found
+ * @return  -ENOENT, if no resource path matches @p uri
+ * @return  -ENOTSUP, if resource paths match @p uri, but none of them
+ *          allows @p method_flag
+ */
+int coap_find_resource(const coap_resource_t *resources, size_t resources_numof,
+                       const uint8_t *uri, coap_method_flags_t method_flag,
+                       const coap_resource_t **resource);
+
 #if defined(MODULE_GCOAP) || defined(DOXYGEN)
 /**
  * @name    Functions -- gcoap specific
@@ -41,6 +41,15 @@
  * 2. write image starting at second block
  * 3. write first block
  *
+ * If the module `riotboot_flashwrite_verify_sha256` is used, the data passed
+ * to riotboot_flashwrite_putbytes() is also fed into a SHA-256 context kept in
+ * the state structure. riotboot_flashwrite_verify_sha256_stream() can then
+ * compare the digest right after the download, without reading the whole
+ * slot back from flash like riotboot_flashwrite_verify_sha256() does.
+ * As the streamed digest covers the received data and not the flash content,
+ * every page is read back and compared after writing if
+ * @ref CONFIG_RIOTBOOT_FLASHWRITE_READBACK is enabled.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  * @author      Koen Zandberg <koen@bergzand.net>
  *
@@ -56,6 +65,23 @@ extern "C" {
 
 #include "riotboot/slot.h"
 #include "periph/flashpage.h"
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_VERIFY_SHA256
+#include "hashes/sha256.h"
+#endif
+
+/**
+ * @brief   Read back and compare every flash page after writing it
+ *
+ * Enabled by default, unless the image digest is computed while streaming
+ * (module `riotboot_flashwrite_verify_sha256`).
+ */
+#ifndef CONFIG_RIOTBOOT_FLASHWRITE_READBACK
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_VERIFY_SHA256
+#define CONFIG_RIOTBOOT_FLASHWRITE_READBACK     0
+#else
+#define CONFIG_RIOTBOOT_FLASHWRITE_READBACK     1
+#endif
+#endif
 
 /**
  * @brief   firmware update state structure
@@ -65,6 +91,9 @@ typedef struct {
     size_t offset;                          /**< update is at this position   */
     unsigned flashpage;                     /**< update is at this flashpage  */
     uint8_t flashpage_buf[FLASHPAGE_SIZE];  /**< flash writing buffer         */
+#if defined(MODULE_RIOTBOOT_FLASHWRITE_VERIFY_SHA256) || defined(DOXYGEN)
+    sha256_context_t sha256;                /**< digest of the written data   */
+#endif
 } riotboot_flashwrite_t;
 
 /**
@@ -109,8 +138,13 @@ static inline int riotboot_flashwrite_init(riotboot_flashwrite_t *state,
                                            int target_slot)
 {
     /* initialize state, but skip "RIOT" */
-    return riotboot_flashwrite_init_raw(state, target_slot,
-                                        RIOTBOOT_FLASHWRITE_SKIPLEN);
+    int res = riotboot_flashwrite_init_raw(state, target_slot,
+                                           RIOTBOOT_FLASHWRITE_SKIPLEN);
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_VERIFY_SHA256
+    /* the magic number is written last, but it is part of the image */
+    sha256_update(&state->sha256, "RIOT", RIOTBOOT_FLASHWRITE_SKIPLEN);
+#endif
+    return res;
 }
 
 /**
@@ -122,7 +156,8 @@ static inline int riotboot_flashwrite_init(riotboot_flashwrite_t *state,
  *
  * @param[in,out]   state   ptr to previously used update state
  * @param[in]       bytes   ptr to data
- * @param[in]       len     len of data
+ * @param[in]       len     len of data, may be 0 if @p more is false to
+ *                          write the buffered rest of the image
  * @param[in]       more    whether more data is coming
  *
  * @returns         0 on success, <0 otherwise
@@ -183,6 +218,29 @@ size_t riotboot_flashwrite_slotsize(const riotboot_flashwrite_t *state);
 int riotboot_flashwrite_verify_sha256(const uint8_t *sha256_digest,
                                       size_t img_size, int target_slot);
 
+/**
+ * @brief       Verify the digest of the data written so far
+ *
+ * Compares the SHA-256 digest computed by riotboot_flashwrite_putbytes() while
+ * the image was streamed in. The digest includes the bytes skipped by
+ * riotboot_flashwrite_init(), but no other bytes skipped by
+ * riotboot_flashwrite_init_raw().
+ *
+ * @note        The digest can only be verified once, afterwards the state
+ *              must be re-initialized.
+ *
+ * @param[in,out] state         ptr to previously used state structure
+ * @param[in]   sha256_digest   content of the image digest
+ * @param[in]   img_size        the size of the image
+ *
+ * @returns     -1 when image is too small
+ * @returns     0 if the digest is valid
+ * @returns     1 if the digest or the size is invalid
+ */
+int riotboot_flashwrite_verify_sha256_stream(riotboot_flashwrite_t *state,
+                                             const uint8_t *sha256_digest,
+                                             size_t img_size);
+
 #ifdef __cplusplus
 }
 #endif
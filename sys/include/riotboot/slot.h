@@ -29,6 +29,8 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+
 #include "riotboot/hdr.h"
 
 /**
@@ -70,6 +72,24 @@ void riotboot_slot_jump(unsigned slot);
  */
 const riotboot_hdr_t *riotboot_slot_get_hdr(unsigned slot);
 
+/**
+ * @brief  Get the size of a given flash slot
+ *
+ * @param[in]   slot    slot nr to work on
+ *
+ * @returns size of image slot nr @p slot in bytes, 0 for an invalid slot
+ */
+static inline size_t riotboot_slot_size(unsigned slot)
+{
+    switch (slot) {
+        case 0: return SLOT0_LEN;
+#if NUM_SLOTS == 2
+        case 1: return SLOT1_LEN;
+#endif
+        default: return 0;
+    }
+}
+
 /**
  * @brief  Validate slot
  *
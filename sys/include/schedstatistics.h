@@ -14,6 +14,23 @@
  *              (@ref schedstat_t) for a thread will be updated on every
  *              @ref sched_run().
  *
+ * Besides the runtime and number of schedules of each thread, the module
+ * records
+ *
+ * - the time spent in interrupt service routines (see @ref schedstat_cpu_t).
+ *   This time is not accounted to the runtime of the interrupted thread.
+ *   ISRs are only measured on CPUs that call @ref schedstat_isr_enter() and
+ *   @ref schedstat_isr_exit() (currently native),
+ * - the scheduling latency, i.e. the time from a thread becoming ready to
+ *   run until it actually runs, per priority (see @ref schedstat_latency_t),
+ * - the runtime of each thread and the ISR time within the last completed
+ *   window of at least @ref SCHEDSTATISTICS_WINDOW_US, from which the CPU
+ *   utilization can be derived.
+ *
+ * @ref schedstat_get_thread(), @ref schedstat_get_cpu() and
+ * @ref schedstat_get_latency() provide consistent snapshots of these values,
+ * e.g. for telemetry. The `ps` command prints them as well.
+ *
  * @note        If auto_init is disabled `init_schedstatistics()` needs to be
  *              called as well as xtimer_init().
  * @{
@@ -31,11 +48,22 @@
 
 #include <stdint.h>
 #include "kernel_types.h"
+#include "sched.h"
 
 #ifdef __cplusplus
  extern "C" {
 #endif
 
+/**
+ * @brief   Minimum length of a CPU utilization window in microseconds
+ *
+ * A window ends with the first context switch after this time elapsed, so
+ * use schedstat_cpu_t::last_window_ticks for the actual length.
+ */
+#ifndef SCHEDSTATISTICS_WINDOW_US
+#define SCHEDSTATISTICS_WINDOW_US   (1000000U)
+#endif
+
 /**
  *  Scheduler statistics
  */
@@ -44,19 +72,129 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+    uint32_t window_ticks;   /**< Runtime in the current window in ticks */
+    uint32_t last_window_ticks; /**< Runtime in the last completed window in
+                                     ticks */
+    uint32_t runnable_since; /**< Time stamp of the last time this thread
+                                  became ready to run */
+    uint8_t runnable;        /**< runnable_since is valid */
 } schedstat_t;
 
+/**
+ * @brief   CPU-wide statistics
+ */
+typedef struct {
+    uint64_t isr_ticks;             /**< Total time spent in ISRs in ticks */
+    unsigned int isr_count;         /**< Number of ISRs */
+    uint32_t window_start;          /**< Start of the current window */
+    uint32_t window_isr_ticks;      /**< Time spent in ISRs in the current
+                                         window in ticks */
+    uint32_t last_window_ticks;     /**< Length of the last completed window
+                                         in ticks, 0 if there is none yet */
+    uint32_t last_window_isr_ticks; /**< Time spent in ISRs in the last
+                                         completed window in ticks */
+} schedstat_cpu_t;
+
+/**
+ * @brief   Scheduling latency statistics of a priority
+ */
+typedef struct {
+    unsigned int count;     /**< Number of times a thread became ready and
+                                 ran */
+    uint32_t max_ticks;     /**< Maximum latency in ticks */
+    uint64_t total_ticks;   /**< Sum of all latencies in ticks */
+} schedstat_latency_t;
+
+/**
+ * @brief   Snapshot of the statistics of a thread
+ */
+typedef struct {
+    uint64_t runtime_ticks;     /**< The total runtime of the thread in ticks */
+    unsigned int schedules;     /**< How often the thread was scheduled to run */
+    uint32_t last_window_ticks; /**< Runtime in the last completed window in
+                                     ticks */
+    uint8_t priority;           /**< Priority of the thread */
+    /**
+     * @brief   Size of the stack of the thread in bytes
+     *
+     * @note    Only available with `DEVELHELP`, 0 otherwise.
+     */
+    uint16_t stack_size;
+    /**
+     * @brief   Stack high-water mark of the thread in bytes
+     *
+     * @note    Only available with `DEVELHELP`, 0 otherwise. Only
+     *          meaningful for threads created with
+     *          @ref THREAD_CREATE_STACKTEST: the stacks of other threads are
+     *          not painted, so nearly their whole stack is reported as used.
+     */
+    uint16_t stack_used;
+} schedstat_thread_t;
+
 /**
  *  Thread statistics table
  */
 extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+/**
+ *  CPU-wide statistics
+ */
+extern schedstat_cpu_t sched_cpustat;
+
+/**
+ *  Scheduling latency statistics per priority
+ */
+extern schedstat_latency_t sched_latency[SCHED_PRIO_LEVELS];
+
 /**
  *  @brief  Registers the sched statistics callback and sets laststart for
  *          caller thread
  */
 void init_schedstatistics(void);
 
+/**
+ * @brief   Gets a snapshot of the statistics of a thread
+ *
+ * @param[in] pid       A thread.
+ * @param[out] stat     The statistics of @p pid.
+ *
+ * @return  0 on success.
+ * @return  -ENOENT, if @p pid does not exist.
+ */
+int schedstat_get_thread(kernel_pid_t pid, schedstat_thread_t *stat);
+
+/**
+ * @brief   Gets a snapshot of the CPU-wide statistics
+ *
+ * @param[out] stat     The CPU-wide statistics.
+ */
+void schedstat_get_cpu(schedstat_cpu_t *stat);
+
+/**
+ * @brief   Gets a snapshot of the scheduling latency statistics of a priority
+ *
+ * @param[in] prio      A priority.
+ * @param[out] stat     The scheduling latency statistics of @p prio.
+ *
+ * @return  0 on success.
+ * @return  -EINVAL, if @p prio is not a valid priority.
+ */
+int schedstat_get_latency(uint8_t prio, schedstat_latency_t *stat);
+
+/**
+ * @brief   Records ISR entry
+ *
+ * To be called by CPU implementations before an interrupt handler is run.
+ */
+void schedstat_isr_enter(void);
+
+/**
+ * @brief   Records ISR exit
+ *
+ * To be called by CPU implementations after an interrupt handler returned.
+ */
+void schedstat_isr_exit(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,11 +28,22 @@
 #define SUIT_COAP_H
 
 #include "net/nanocoap.h"
+#include "net/sock/udp.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Maximum number of block requests kept in flight when downloading
+ *
+ * Each request needs a buffer of the requested block size on the stack of the
+ * downloading thread. 1 fetches one block after another.
+ */
+#ifndef SUIT_COAP_WINDOW_SIZE
+#define SUIT_COAP_WINDOW_SIZE   (4U)
+#endif
+
 /**
  * @brief    Start SUIT CoAP thread
  */
@@ -143,6 +154,40 @@ int suit_coap_get_blockwise_url(const char *url,
                                coap_blksize_t blksize,
                                coap_blockwise_cb_t callback, void *arg);
 
+/**
+ * @brief    Performs a blockwise coap get request to the specified remote.
+ *
+ * Keeps up to @ref SUIT_COAP_WINDOW_SIZE block requests in flight. The
+ * callback is called for the received blocks in order.
+ *
+ * @param[in]   remote     remote endpoint
+ * @param[in]   path       resource path
+ * @param[in]   blksize    sender suggested SZX for the COAP block request
+ * @param[in]   callback   callback to be executed on each received block
+ * @param[in]   arg        optional function arguments
+ *
+ * @returns     -1         if failed to fetch the url content
+ * @returns      0         on success
+ */
+int suit_coap_get_blockwise(sock_udp_ep_t *remote, const char *path,
+                            coap_blksize_t blksize,
+                            coap_blockwise_cb_t callback, void *arg);
+
+/**
+ * @brief    Performs a blockwise coap get request and stores the content
+ *
+ * @param[in]   url        url pointer to source path
+ * @param[in]   blksize    sender suggested SZX for the COAP block request
+ * @param[out]  buf        buffer for the content
+ * @param[in]   len        size of @p buf
+ *
+ * @returns     size of the content on success
+ * @returns     <0 on error
+ */
+ssize_t suit_coap_get_blockwise_url_buf(const char *url,
+                                        coap_blksize_t blksize,
+                                        uint8_t *buf, size_t len);
+
 /**
  * @brief   Trigger a SUIT udate
  *
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_suit_unpack SUIT payload unpacking
+ * @ingroup     sys_suit
+ * @brief       Streaming decompression and delta patching of SUIT payloads
+ *
+ * Payloads are passed through up to two stages before they are handed to a
+ * sink, usually the riotboot flash writer:
+ *
+ * 1. decompression (module `suit_unpack_heatshrink`), using the
+ *    [heatshrink](https://github.com/atomicobject/heatshrink) package with
+ *    its default window (8 bits) and lookahead (4 bits) sizes
+ * 2. delta patching against a source image, usually the running slot (module
+ *    `suit_unpack_delta`)
+ *
+ * The delta format is the uncompressed patch stream of the
+ * [bsdiff](https://github.com/mendsley/bsdiff) fork by Matthew Endsley:
+ * a 16 byte magic "ENDSLEY/BSDIFF43" and the 8 byte size of the new image,
+ * followed by blocks of three 8 byte control values (diff length, extra
+ * length, source seek), diff bytes and extra bytes. Unlike the original
+ * bsdiff format the streams are interleaved, so the patch can be applied
+ * while it is downloaded. Combined with heatshrink, it usually shrinks an
+ * update of a few changed functions to a few percent of the image size.
+ *
+ * Both stages process the data as it streams in, so only a small fixed
+ * amount of memory is needed and the payload is never stored as a whole.
+ *
+ * @{
+ *
+ * @file
+ * @brief       SUIT payload unpacking API
+ */
+
+#ifndef SUIT_UNPACK_H
+#define SUIT_UNPACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef MODULE_SUIT_UNPACK_HEATSHRINK
+#include "heatshrink_decoder.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the buffer collecting the unpacked data for the sink
+ */
+#ifndef SUIT_UNPACK_BUF_SIZE
+#define SUIT_UNPACK_BUF_SIZE            (64U)
+#endif
+
+/**
+ * @brief SUIT payload compression algorithms
+ *
+ * Values from draft-moran-suit-manifest-04, heatshrink is not part of the
+ * draft and uses a private value.
+ */
+typedef enum {
+    SUIT_COMPRESSION_NONE       = 0,    /**< Uncompressed payload */
+    SUIT_COMPRESSION_HEATSHRINK = -1,   /**< heatshrink, window 8, lookahead 4 */
+} suit_compression_t;
+
+/**
+ * @brief SUIT payload unpack algorithms
+ *
+ * Values from draft-moran-suit-manifest-04
+ */
+typedef enum {
+    SUIT_UNPACK_NONE            = 0,    /**< Payload is the image */
+    SUIT_UNPACK_DELTA           = 1,    /**< Payload is a delta patch */
+} suit_unpack_algorithm_t;
+
+/**
+ * @brief   Sink for unpacked data
+ *
+ * @param[in]   arg     argument passed to suit_unpack_init()
+ * @param[in]   offset  offset of @p buf in the unpacked image
+ * @param[in]   buf     unpacked data
+ * @param[in]   len     length of @p buf, may be 0 if @p more is false
+ * @param[in]   more    false for the last call
+ *
+ * @returns     0 on success, <0 to abort unpacking
+ */
+typedef int (*suit_unpack_sink_t)(void *arg, size_t offset,
+                                  const uint8_t *buf, size_t len, bool more);
+
+/**
+ * @brief   Unpacking state
+ */
+typedef struct {
+    suit_unpack_sink_t sink;        /**< sink for the unpacked data */
+    void *arg;                      /**< argument of the sink */
+    size_t in_offset;               /**< offset of the next input byte */
+    size_t out_offset;              /**< offset of buf in the unpacked image */
+    uint8_t compression;            /**< decompress the input */
+    uint8_t delta;                  /**< apply the input as delta patch */
+    uint16_t buf_len;               /**< number of bytes in buf */
+    uint8_t buf[SUIT_UNPACK_BUF_SIZE];  /**< unpacked data for the sink */
+#if defined(MODULE_SUIT_UNPACK_HEATSHRINK) || defined(DOXYGEN)
+    heatshrink_decoder hsd;         /**< heatshrink decoder */
+#endif
+#if defined(MODULE_SUIT_UNPACK_DELTA) || defined(DOXYGEN)
+    const uint8_t *src;             /**< source image of the delta */
+    size_t src_len;                 /**< length of the source image */
+    int32_t src_pos;                /**< position in the source image */
+    size_t new_len;                 /**< length of the patched image */
+    size_t left;                    /**< bytes left in the current part */
+    size_t extra_len;               /**< extra bytes of the current block */
+    int32_t seek;                   /**< source seek after the current block */
+    uint8_t patch_state;            /**< state of the patch parser */
+    uint8_t ctrl_len;               /**< number of bytes in ctrl */
+    uint8_t ctrl[24];               /**< header or control block */
+#endif
+} suit_unpack_t;
+
+/**
+ * @brief   Initialize the unpacking state
+ *
+ * @param[out]  unpack      state to initialize
+ * @param[in]   compression compression algorithm of the payload
+ * @param[in]   algorithm   unpack algorithm of the payload
+ * @param[in]   src         source image of a delta patch
+ * @param[in]   src_len     length of @p src
+ * @param[in]   sink        sink for the unpacked data
+ * @param[in]   arg         argument of @p sink
+ *
+ * @returns     0 on success
+ * @returns     -ENOTSUP if an algorithm is not supported
+ */
+int suit_unpack_init(suit_unpack_t *unpack, int compression, int algorithm,
+                     const uint8_t *src, size_t src_len,
+                     suit_unpack_sink_t sink, void *arg);
+
+/**
+ * @brief   Feed payload data into the unpacker
+ *
+ * The unpacked data is passed to the sink in chunks of up to
+ * @ref SUIT_UNPACK_BUF_SIZE bytes, or unmodified if neither decompression nor
+ * delta patching is used.
+ *
+ * @param[in,out]   unpack  unpacking state
+ * @param[in]       offset  offset of @p buf in the payload
+ * @param[in]       buf     payload data
+ * @param[in]       len     length of @p buf
+ * @param[in]       more    false for the last part of the payload
+ *
+ * @returns     0 on success
+ * @returns     -EINVAL if @p offset does not continue the previous data
+ * @returns     -EBADMSG if the payload is corrupt or truncated
+ * @returns     the error returned by the sink
+ */
+int suit_unpack_putbytes(suit_unpack_t *unpack, size_t offset,
+                         const uint8_t *buf, size_t len, bool more);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUIT_UNPACK_H */
+/** @} */
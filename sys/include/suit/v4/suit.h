@@ -22,6 +22,7 @@
 #ifndef SUIT_V4_SUIT_H
 #define SUIT_V4_SUIT_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -29,6 +30,9 @@
 #include "nanocbor/nanocbor.h"
 #include "uuid.h"
 #include "riotboot/flashwrite.h"
+#ifdef MODULE_SUIT_UNPACK
+#include "suit/unpack.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -119,6 +123,10 @@ typedef struct {
     nanocbor_value_t identifier;        /**< Identifier*/
     nanocbor_value_t url;               /**< Url */
     nanocbor_value_t digest;            /**< Digest */
+    int32_t compression;                /**< Compression algorithm of the
+                                             payload, 0 for none */
+    int32_t unpack;                     /**< Unpack algorithm of the payload,
+                                             0 for none */
 } suit_v4_component_t;
 
 /**
@@ -136,6 +144,9 @@ typedef struct {
     unsigned components_len;        /**< Current number of components */
     int32_t component_current;      /**< Current component index */
     riotboot_flashwrite_t *writer;  /**< Pointer to the riotboot flash writer */
+#if defined(MODULE_SUIT_UNPACK) || defined(DOXYGEN)
+    suit_unpack_t *unpack;          /**< Pointer to the payload unpacker */
+#endif
     /** Manifest validation buffer */
     uint8_t validation_buf[SUIT_COSE_BUF_SIZE];
     cose_key_t *key;                /**< Ptr to the public key for validation */
@@ -260,10 +271,13 @@ int suit_cbor_get_string(nanocbor_value_t *it, const uint8_t **buf, size_t *len)
 int suit_cbor_subparse(nanocbor_value_t *bseq, nanocbor_value_t *it);
 
 /**
- * @brief Helper function for writing bytes on flash a specified offset
+ * @brief Helper function for writing downloaded payload bytes
+ *
+ * If the module `suit_unpack` is used, the payload is passed through
+ * @ref sys_suit_unpack before it is written by suit_flashwrite_sink().
  *
  * @param[in]   arg     ptr to the SUIT manifest
- * @param[in]   offset  offset to write to on flash
+ * @param[in]   offset  offset of @p buf in the payload
  * @param[in]   buf     bytes to write
  * @param[in]   len     length of bytes to write
  * @param[in]   more    whether more data is coming
@@ -274,6 +288,21 @@ int suit_cbor_subparse(nanocbor_value_t *bseq, nanocbor_value_t *it);
 int suit_flashwrite_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
                            int more);
 
+/**
+ * @brief Helper function for writing bytes on flash a specified offset
+ *
+ * @param[in]   arg     ptr to the SUIT manifest
+ * @param[in]   offset  offset to write to on flash
+ * @param[in]   buf     bytes to write
+ * @param[in]   len     length of bytes to write
+ * @param[in]   more    whether more data is coming
+ *
+ * @return              0 on success
+ * @return              <0 on error
+ */
+int suit_flashwrite_sink(void *arg, size_t offset, const uint8_t *buf,
+                         size_t len, bool more);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_trace_kernel Kernel event tracer
+ * @ingroup     sys
+ * @brief       Records a binary timeline of kernel events
+ *
+ * When this module is used (`USEMODULE += trace_kernel`), the kernel records
+ * context switches, ISR entry and exit, message passing and mutex operations
+ * as fixed-size @ref trace_kernel_event_t records into a ring buffer of
+ * @ref TRACE_KERNEL_BUFFER_SIZE entries. Once the buffer is full, the oldest
+ * events are overwritten, so the buffer always holds the most recent history
+ * (flight recorder).
+ *
+ * Recording an event only reserves a slot with an atomic increment and
+ * copies 12 bytes, so it does not take a lock. On CPUs with exclusive
+ * load/store instructions (e.g. Cortex-M3 and up) the increment does not
+ * disable interrupts either. Other CPUs (e.g. Cortex-M0, AVR, MSP430) use the
+ * fallback of `core/atomic_c11.c`, which disables interrupts for the
+ * increment only. As RIOT runs on a single core there is exactly one buffer.
+ * Without the module, all hooks compile to nothing; with the module but
+ * tracing stopped (see @ref trace_kernel_stop()), each hook costs one load
+ * and a branch. The hooks are declared in `core/include/trace_kernel_hooks.h`.
+ *
+ * Timestamps are taken with @ref TRACE_KERNEL_TIMESTAMP(), which defaults to
+ * the xtimer tick counter. It can be overridden, e.g. with a cycle counter,
+ * in which case @ref TRACE_KERNEL_TIMESTAMP_HZ needs to be set accordingly.
+ *
+ * CPUs report ISRs by calling @ref trace_kernel_isr_enter() and
+ * @ref trace_kernel_isr_exit(). Currently only the native port does so, for
+ * every signal handler. On other CPUs, e.g. Cortex-M, the vector table calls
+ * the handlers directly without a common entry point, so no ISR events are
+ * recorded; events recorded from within an ISR still carry
+ * `KERNEL_PID_ISR` as their thread. On native,
+ * @ref trace_kernel_dump_json() additionally writes the
+ * buffer as a Chrome trace event file that can be opened with
+ * [Perfetto](https://ui.perfetto.dev) or `chrome://tracing`.
+ *
+ * @note    If auto_init is disabled, `trace_kernel_init()` needs to be called
+ *          after `xtimer_init()`.
+ * @{
+ *
+ * @file
+ * @brief   Kernel event tracer definitions
+ */
+#ifndef TRACE_KERNEL_H
+#define TRACE_KERNEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "trace_kernel_hooks.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup    sys_trace_kernel_conf   Kernel event tracer compile configurations
+ * @ingroup     config
+ * @{
+ */
+/**
+ * @brief   Number of events in the ring buffer
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef TRACE_KERNEL_BUFFER_SIZE
+#define TRACE_KERNEL_BUFFER_SIZE    (256U)
+#endif
+
+/**
+ * @brief   Start recording in trace_kernel_init()
+ *
+ * Set to 0 to only start recording once @ref trace_kernel_start() is called.
+ */
+#ifndef TRACE_KERNEL_AUTOSTART
+#define TRACE_KERNEL_AUTOSTART      (1)
+#endif
+
+/**
+ * @brief   Timestamp source for events
+ */
+#ifndef TRACE_KERNEL_TIMESTAMP
+#define TRACE_KERNEL_TIMESTAMP()    (xtimer_now().ticks32)
+#endif
+
+/**
+ * @brief   Frequency of @ref TRACE_KERNEL_TIMESTAMP() in Hz
+ */
+#ifndef TRACE_KERNEL_TIMESTAMP_HZ
+#define TRACE_KERNEL_TIMESTAMP_HZ   (XTIMER_HZ)
+#endif
+/** @} */
+
+#if (TRACE_KERNEL_BUFFER_SIZE & (TRACE_KERNEL_BUFFER_SIZE - 1)) != 0
+#error "TRACE_KERNEL_BUFFER_SIZE must be a power of 2"
+#endif
+
+/**
+ * @brief   A recorded event
+ */
+typedef struct {
+    uint32_t time;      /**< timestamp in TRACE_KERNEL_TIMESTAMP_HZ ticks */
+    uint8_t type;       /**< event type (see @ref trace_kernel_type_t) */
+    /**
+     * @brief   Thread that was running when the event was recorded
+     *
+     * Events recorded by an ISR carry the PID of the interrupted thread,
+     * they are enclosed by @ref TRACE_KERNEL_ISR_ENTER and
+     * @ref TRACE_KERNEL_ISR_EXIT where the CPU reports those.
+     */
+    uint8_t pid;
+    uint16_t arg16;     /**< type-specific argument */
+    uint32_t arg;       /**< type-specific argument */
+} trace_kernel_event_t;
+
+#if defined(MODULE_TRACE_KERNEL) || defined(DOXYGEN)
+/**
+ * @brief   Initializes the tracer
+ *
+ * Starts recording if @ref TRACE_KERNEL_AUTOSTART is set.
+ */
+void trace_kernel_init(void);
+
+/**
+ * @brief   Starts recording
+ */
+static inline void trace_kernel_start(void)
+{
+    trace_kernel_running = true;
+}
+
+/**
+ * @brief   Stops recording
+ *
+ * Events are recorded without locking, so this should be called before the
+ * buffer is read to get a consistent snapshot.
+ */
+static inline void trace_kernel_stop(void)
+{
+    trace_kernel_running = false;
+}
+
+/**
+ * @brief   Discards all recorded events
+ */
+void trace_kernel_clear(void);
+
+/**
+ * @brief   Copies recorded events, oldest first
+ *
+ * @pre Tracing is stopped.
+ *
+ * @param[out] events       Destination for the events.
+ * @param[in] max_events    Maximum number of events to copy to @p events.
+ *
+ * @return  Number of events copied to @p events.
+ */
+size_t trace_kernel_read(trace_kernel_event_t *events, size_t max_events);
+
+/**
+ * @brief   Number of events that were overwritten since the last
+ *          @ref trace_kernel_clear()
+ *
+ * @return  Number of lost events.
+ */
+uint32_t trace_kernel_lost(void);
+
+#if defined(CPU_NATIVE) || defined(DOXYGEN)
+/**
+ * @brief   Writes the recorded events to a Chrome trace event (JSON) file
+ *
+ * Threads show up as one track each, with a slice for every time they were
+ * scheduled. ISRs are shown on a separate track, messages and mutex
+ * operations as instant events of the respective thread. The file can be
+ * loaded into [Perfetto](https://ui.perfetto.dev) or `chrome://tracing`.
+ *
+ * @note    Only available on native.
+ *
+ * @pre Tracing is stopped.
+ *
+ * @param[in] path  Path of the file to write on the host.
+ *
+ * @return  Number of events written on success.
+ * @return  -errno, if the file could not be written.
+ */
+int trace_kernel_dump_json(const char *path);
+#endif  /* CPU_NATIVE */
+#endif  /* MODULE_TRACE_KERNEL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_KERNEL_H */
+/** @} */
@@ -116,10 +116,10 @@ static inline uint64_t _xtimer_now64(void)
     now = _xtimer_lltimer_now();
 #if XTIMER_MASK
     elapsed = _xtimer_lltimer_mask(now - _xtimer_lltimer_mask((uint32_t)_xtimer_current_time));
-    _xtimer_current_time += (uint64_t)elapsed;
+    _xtimer_current_time = _xtimer_current_time + (uint64_t)elapsed;
 #else
     elapsed = now - ((uint32_t)_xtimer_current_time & 0xFFFFFFFF);
-    _xtimer_current_time += (uint64_t)elapsed;
+    _xtimer_current_time = _xtimer_current_time + (uint64_t)elapsed;
 #endif
     irq_restore(state);
 
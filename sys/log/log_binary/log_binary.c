@@ -0,0 +1,536 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_binary
+ * @{
+ *
+ * @file
+ * @brief       Deferred binary log module implementation
+ *
+ * @}
+ */
+
+/* Required for strnlen in string.h, when building with -std=c99 */
+#define _DEFAULT_SOURCE 1
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "log.h"
+#include "stdio_base.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#if (LOG_BINARY_BUFFER_SIZE & (LOG_BINARY_BUFFER_SIZE - 1)) != 0
+#error "LOG_BINARY_BUFFER_SIZE must be a power of 2"
+#endif
+
+#if LOG_BINARY_RECORD_MAX > 255
+#error "LOG_BINARY_RECORD_MAX must not be larger than 255"
+#endif
+
+#define _MASK           (LOG_BINARY_BUFFER_SIZE - 1)
+#define _THREAD_FLAG    (0x1)
+
+/* argument types of a conversion specification */
+typedef enum {
+    _ARG_NONE,
+    _ARG_INT,
+    _ARG_LONG,
+    _ARG_LLONG,
+    _ARG_SIZE,
+    _ARG_PTR,
+    _ARG_DOUBLE,
+    _ARG_LDOUBLE,
+    _ARG_STR,
+} _arg_t;
+
+typedef struct {
+    const char *start;      /* first character of the specification */
+    const char *end;        /* first character after the specification */
+    _arg_t type;
+    uint8_t stars;          /* number of `*` width/precision arguments */
+    bool prec_star;         /* precision is the last `*` argument */
+    int prec;               /* precision, -1 if none */
+} _spec_t;
+
+static uint8_t _buf[LOG_BINARY_BUFFER_SIZE];
+/* bytes reserved by writers */
+static atomic_uint_least32_t _head = ATOMIC_VAR_INIT(0);
+/* bytes consumed by the reader, only written by the reader */
+static volatile uint32_t _tail;
+static atomic_uint _dropped = ATOMIC_VAR_INIT(0);
+static kernel_pid_t _drain_pid = KERNEL_PID_UNDEF;
+
+/* finds the next conversion specification in fmt, returns false at the end of
+ * the string */
+static bool _next_spec(const char *fmt, _spec_t *spec)
+{
+    while ((fmt = strchr(fmt, '%')) != NULL) {
+        if (fmt[1] == '%') {
+            fmt += 2;
+            continue;
+        }
+        break;
+    }
+    if (fmt == NULL) {
+        return false;
+    }
+    spec->start = fmt++;
+    spec->stars = 0;
+    spec->prec_star = false;
+    spec->prec = -1;
+    spec->type = _ARG_INT;
+    fmt += strspn(fmt, "-+ #0");
+    for (unsigned i = 0; i < 2; i++) {
+        /* width, then precision */
+        if (*fmt == '*') {
+            spec->stars++;
+            spec->prec_star = (i == 1);
+            fmt++;
+        }
+        else if (i == 1) {
+            /* a single '.' is a precision of 0 */
+            spec->prec = 0;
+            for (; (*fmt >= '0') && (*fmt <= '9'); fmt++) {
+                spec->prec = (spec->prec * 10) + (*fmt - '0');
+            }
+        }
+        else {
+            fmt += strspn(fmt, "0123456789");
+        }
+        if ((i == 0) && (*fmt == '.')) {
+            fmt++;
+        }
+        else {
+            break;
+        }
+    }
+    switch (*fmt) {
+        case 'h':
+            fmt += (fmt[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            if (fmt[1] == 'l') {
+                spec->type = _ARG_LLONG;
+                fmt += 2;
+            }
+            else {
+                spec->type = _ARG_LONG;
+                fmt++;
+            }
+            break;
+        case 'j':
+            spec->type = _ARG_LLONG;
+            fmt++;
+            break;
+        case 'z':
+        case 't':
+            spec->type = _ARG_SIZE;
+            fmt++;
+            break;
+        case 'L':
+            spec->type = _ARG_LDOUBLE;
+            fmt++;
+            break;
+        default:
+            break;
+    }
+    switch (*fmt) {
+        case 'p':
+            spec->type = _ARG_PTR;
+            break;
+        case 's':
+            spec->type = _ARG_STR;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if (spec->type != _ARG_LDOUBLE) {
+                spec->type = _ARG_DOUBLE;
+            }
+            break;
+        case '\0':
+            spec->type = _ARG_NONE;
+            spec->end = fmt;
+            return true;
+        default:
+            break;
+    }
+    spec->end = fmt + 1;
+    return true;
+}
+
+static size_t _arg_size(_arg_t type)
+{
+    switch (type) {
+        case _ARG_INT:
+            return sizeof(int);
+        case _ARG_LONG:
+            return sizeof(long);
+        case _ARG_LLONG:
+            return sizeof(long long);
+        case _ARG_SIZE:
+            return sizeof(size_t);
+        case _ARG_PTR:
+            return sizeof(void *);
+        case _ARG_DOUBLE:
+            return sizeof(double);
+        case _ARG_LDOUBLE:
+            return sizeof(long double);
+        default:
+            return 0;
+    }
+}
+
+static void _copy_in(uint32_t pos, const uint8_t *data, size_t len)
+{
+    size_t first = LOG_BINARY_BUFFER_SIZE - (pos & _MASK);
+
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&_buf[pos & _MASK], data, first);
+    memcpy(_buf, data + first, len - first);
+}
+
+static void _put(const uint8_t *record, size_t len)
+{
+    uint32_t head = atomic_load_explicit(&_head, memory_order_relaxed);
+
+    do {
+        if ((head + len - _tail) > LOG_BINARY_BUFFER_SIZE) {
+            atomic_fetch_add_explicit(&_dropped, 1, memory_order_relaxed);
+            return;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&_head, &head, head + len,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed));
+    /* the length byte marks the record as complete, so it is written last */
+    _copy_in(head + 1, record + 1, len - 1);
+    atomic_thread_fence(memory_order_release);
+    _buf[head & _MASK] = record[0];
+}
+
+void log_write(unsigned level, const char *format, ...)
+{
+    uint8_t record[LOG_BINARY_RECORD_MAX];
+    uint32_t fmt_addr = (uint32_t)(uintptr_t)format;
+    size_t len = LOG_BINARY_HDR_SIZE;
+    _spec_t spec;
+    va_list args;
+
+    record[1] = level;
+    memcpy(&record[2], &fmt_addr, sizeof(fmt_addr));
+    va_start(args, format);
+    for (const char *fmt = format; _next_spec(fmt, &spec); fmt = spec.end) {
+        union {
+            int i;
+            long l;
+            long long ll;
+            size_t z;
+            void *p;
+            double d;
+            long double ld;
+        } val;
+        size_t size;
+        int prec = spec.prec;
+
+        for (unsigned i = 0; i < spec.stars; i++) {
+            val.i = va_arg(args, int);
+            if ((len + sizeof(int)) > sizeof(record)) {
+                goto cut;
+            }
+            memcpy(&record[len], &val.i, sizeof(int));
+            len += sizeof(int);
+            if (spec.prec_star && (i == spec.stars - 1U)) {
+                /* a negative precision is taken as if it was omitted */
+                prec = (val.i < 0) ? -1 : val.i;
+            }
+        }
+        switch (spec.type) {
+            case _ARG_NONE:
+                continue;
+            case _ARG_STR: {
+                const char *str = va_arg(args, const char *);
+                size_t max = LOG_BINARY_STRING_MAX;
+                size_t str_len;
+
+                /* with a precision, the array does not need to be
+                 * terminated */
+                if ((prec >= 0) && ((unsigned)prec < max)) {
+                    max = prec;
+                }
+                str_len = (str != NULL) ? strnlen(str, max) : 0;
+                if ((len + 1 + str_len) > sizeof(record)) {
+                    goto cut;
+                }
+                record[len++] = str_len;
+                memcpy(&record[len], str, str_len);
+                len += str_len;
+                continue;
+            }
+            case _ARG_INT:
+                val.i = va_arg(args, int);
+                break;
+            case _ARG_LONG:
+                val.l = va_arg(args, long);
+                break;
+            case _ARG_LLONG:
+                val.ll = va_arg(args, long long);
+                break;
+            case _ARG_SIZE:
+                val.z = va_arg(args, size_t);
+                break;
+            case _ARG_PTR:
+                val.p = va_arg(args, void *);
+                break;
+            case _ARG_DOUBLE:
+                val.d = va_arg(args, double);
+                break;
+            case _ARG_LDOUBLE:
+                val.ld = va_arg(args, long double);
+                break;
+        }
+        size = _arg_size(spec.type);
+        if ((len + size) > sizeof(record)) {
+            goto cut;
+        }
+        memcpy(&record[len], &val, size);
+        len += size;
+    }
+    va_end(args);
+    goto out;
+
+cut:
+    va_end(args);
+    record[1] |= LOG_BINARY_LEVEL_CUT;
+out:
+    record[0] = len;
+    _put(record, len);
+    if (LOG_BINARY_THREAD && (_drain_pid != KERNEL_PID_UNDEF)) {
+        thread_flags_set((thread_t *)thread_get(_drain_pid), _THREAD_FLAG);
+    }
+}
+
+size_t log_binary_read(void *buf, size_t len)
+{
+    uint8_t *out = buf;
+    uint32_t tail = _tail;
+    size_t res = 0;
+
+    while (tail != atomic_load_explicit(&_head, memory_order_relaxed)) {
+        size_t rec_len = _buf[tail & _MASK];
+        size_t first = LOG_BINARY_BUFFER_SIZE - (tail & _MASK);
+
+        if ((rec_len == 0) || ((res + rec_len) > len)) {
+            /* not completely written yet or does not fit */
+            break;
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (first > rec_len) {
+            first = rec_len;
+        }
+        memcpy(&out[res], &_buf[tail & _MASK], first);
+        memcpy(&out[res + first], _buf, rec_len - first);
+        /* clear, so a length byte of a later record is only seen once it
+         * was written */
+        memset(&_buf[tail & _MASK], 0, first);
+        memset(_buf, 0, rec_len - first);
+        res += rec_len;
+        tail += rec_len;
+    }
+    atomic_thread_fence(memory_order_release);
+    _tail = tail;
+    return res;
+}
+
+/* the format of each argument is taken from the stored format string */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+
+/* passes the width and precision arguments of a star specification */
+#define _PRINT_STARS(fmt, stars, num, val) \
+    do { \
+        if ((num) == 0) { \
+            printf(fmt, val); \
+        } \
+        else if ((num) == 1) { \
+            printf(fmt, stars[0], val); \
+        } \
+        else { \
+            printf(fmt, stars[0], stars[1], val); \
+        } \
+    } while (0)
+
+static const uint8_t *_print_arg(const _spec_t *spec, const uint8_t *arg,
+                                 const uint8_t *end)
+{
+    char fmt[16];
+    size_t fmt_len = spec->end - spec->start;
+    int stars[2] = { 0, 0 };
+
+    if (fmt_len >= sizeof(fmt)) {
+        return NULL;
+    }
+    memcpy(fmt, spec->start, fmt_len);
+    fmt[fmt_len] = '\0';
+    for (unsigned i = 0; i < spec->stars; i++) {
+        if ((arg + sizeof(int)) > end) {
+            return NULL;
+        }
+        memcpy(&stars[i], arg, sizeof(int));
+        arg += sizeof(int);
+    }
+    if (spec->type == _ARG_STR) {
+        char str[LOG_BINARY_STRING_MAX + 1];
+
+        if ((arg >= end) || ((arg + 1 + *arg) > end)) {
+            return NULL;
+        }
+        memcpy(str, arg + 1, *arg);
+        str[*arg] = '\0';
+        arg += 1 + *arg;
+        _PRINT_STARS(fmt, stars, spec->stars, str);
+        return arg;
+    }
+    if ((arg + _arg_size(spec->type)) > end) {
+        return NULL;
+    }
+    union {
+        int i;
+        long l;
+        long long ll;
+        size_t z;
+        void *p;
+        double d;
+        long double ld;
+    } val;
+    memcpy(&val, arg, _arg_size(spec->type));
+    switch (spec->type) {
+        case _ARG_INT:
+            _PRINT_STARS(fmt, stars, spec->stars, val.i);
+            break;
+        case _ARG_LONG:
+            _PRINT_STARS(fmt, stars, spec->stars, val.l);
+            break;
+        case _ARG_LLONG:
+            _PRINT_STARS(fmt, stars, spec->stars, val.ll);
+            break;
+        case _ARG_SIZE:
+            _PRINT_STARS(fmt, stars, spec->stars, val.z);
+            break;
+        case _ARG_PTR:
+            _PRINT_STARS(fmt, stars, spec->stars, val.p);
+            break;
+        case _ARG_DOUBLE:
+            _PRINT_STARS(fmt, stars, spec->stars, val.d);
+            break;
+        case _ARG_LDOUBLE:
+            _PRINT_STARS(fmt, stars, spec->stars, val.ld);
+            break;
+        default:
+            break;
+    }
+    return arg + _arg_size(spec->type);
+}
+
+#pragma GCC diagnostic pop
+
+/* prints text of the format string in between conversion specifications */
+static void _print_text(const char *text, size_t len)
+{
+    const char *end = text + len;
+
+    while (text < end) {
+        const char *pct = memchr(text, '%', end - text);
+        size_t chunk = (pct != NULL) ? (size_t)(pct - text + 1)
+                                     : (size_t)(end - text);
+
+        /* only "%%" can be part of the text, print a single '%' for it */
+        printf("%.*s", (int)chunk, text);
+        text += (pct != NULL) ? chunk + 1 : chunk;
+    }
+}
+
+size_t log_binary_print(const uint8_t *record)
+{
+    const uint8_t *end = record + record[0];
+    const uint8_t *arg = record + LOG_BINARY_HDR_SIZE;
+    uint32_t fmt_addr;
+    const char *fmt;
+    _spec_t spec;
+
+    memcpy(&fmt_addr, &record[2], sizeof(fmt_addr));
+    fmt = (const char *)(uintptr_t)fmt_addr;
+    while (_next_spec(fmt, &spec)) {
+        _print_text(fmt, spec.start - fmt);
+        fmt = spec.end;
+        if (spec.type == _ARG_NONE) {
+            continue;
+        }
+        arg = _print_arg(&spec, arg, end);
+        if (arg == NULL) {
+            /* argument was cut */
+            printf("...");
+            return record[0];
+        }
+    }
+    _print_text(fmt, strlen(fmt));
+    return record[0];
+}
+
+unsigned log_binary_dropped(void)
+{
+    return atomic_load_explicit(&_dropped, memory_order_relaxed);
+}
+
+#if LOG_BINARY_THREAD
+static char _stack[LOG_BINARY_THREAD_STACKSIZE];
+
+static void *_drain(void *arg)
+{
+    uint8_t record[LOG_BINARY_RECORD_MAX];
+
+    (void)arg;
+    while (1) {
+        thread_flags_wait_any(_THREAD_FLAG);
+        while (log_binary_read(record, sizeof(record)) > 0) {
+            if (LOG_BINARY_DRAIN_TEXT) {
+                log_binary_print(record);
+            }
+            else {
+                static const uint8_t magic[] = {
+                    LOG_BINARY_FRAME_MAGIC0, LOG_BINARY_FRAME_MAGIC1
+                };
+
+                stdio_write(magic, sizeof(magic));
+                stdio_write(record, record[0]);
+            }
+        }
+    }
+    return NULL;
+}
+#endif
+
+void log_binary_init(void)
+{
+#if LOG_BINARY_THREAD
+    _drain_pid = thread_create(_stack, sizeof(_stack), LOG_BINARY_THREAD_PRIO,
+                               THREAD_CREATE_STACKTEST, _drain, NULL,
+                               "log_binary");
+#endif
+}
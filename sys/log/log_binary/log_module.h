@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_log_binary Deferred binary log module
+ * @ingroup     sys
+ * @brief       Stores log messages in binary form and formats them later
+ *
+ * Instead of formatting and printing a message in the context of the caller,
+ * @ref log_write() only stores the address of the format string, the log level
+ * and the raw arguments into a ring buffer of
+ * @ref LOG_BINARY_BUFFER_SIZE bytes. Slots in the buffer are reserved with an
+ * atomic compare-and-swap, so logging is safe from threads and ISRs without
+ * taking a lock. If the buffer is full, the message is dropped and counted
+ * (see @ref log_binary_dropped()).
+ *
+ * The buffer is drained by a low-priority thread that writes each record to
+ * stdio. By default it writes binary frames that are decoded on the host by
+ * `dist/tools/log_binary/decode.py`, which looks up the format strings in the
+ * ELF file of the application:
+ *
+ *     $ dist/tools/log_binary/decode.py bin/<board>/<app>.elf < log.bin
+ *
+ * With @ref LOG_BINARY_DRAIN_TEXT the thread formats the messages itself
+ * instead, which still moves formatting and output off the hot path. Set
+ * @ref LOG_BINARY_THREAD to 0 to drain the buffer manually with
+ * @ref log_binary_read(), e.g. from a debugger or a telemetry thread.
+ *
+ * Each record has the following layout, with all values in the byte order
+ * of the device:
+ *
+ * | Offset | Size | Content                                      |
+ * |--------|------|----------------------------------------------|
+ * | 0      | 1    | length of the record in bytes                |
+ * | 1      | 1    | log level, bit 7 set if arguments were cut   |
+ * | 2      | 4    | address of the format string                 |
+ * | 6      | n    | arguments                                    |
+ *
+ * Arguments are stored in the order of the format string with their C type
+ * size (`int`, `long`, `long long`, `size_t`, `void *`, `double` and
+ * `long double`). Strings (`%s`) are stored as a length byte followed by at
+ * most @ref LOG_BINARY_STRING_MAX characters, or less if the conversion has a
+ * precision, as their memory might be gone once the message is formatted.
+ *
+ * @note    The host decoder assumes a 32-bit device, i.e. 4 byte `int`,
+ *          `long`, `size_t` and pointers, and a `long double` that is the
+ *          same as `double`, as on ARM.
+ * @{
+ *
+ * @file
+ * @brief   Deferred binary log module definitions
+ */
+#ifndef LOG_MODULE_H
+#define LOG_MODULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the ring buffer in bytes
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef LOG_BINARY_BUFFER_SIZE
+#define LOG_BINARY_BUFFER_SIZE      (512U)
+#endif
+
+/**
+ * @brief   Maximum size of a record in bytes
+ *
+ * Arguments that do not fit are dropped and the record is marked with
+ * @ref LOG_BINARY_LEVEL_CUT. Must not be larger than 255.
+ */
+#ifndef LOG_BINARY_RECORD_MAX
+#define LOG_BINARY_RECORD_MAX       (64U)
+#endif
+
+/**
+ * @brief   Maximum number of characters stored for a `%s` argument
+ */
+#ifndef LOG_BINARY_STRING_MAX
+#define LOG_BINARY_STRING_MAX       (24U)
+#endif
+
+/**
+ * @brief   Drain the buffer with a thread
+ */
+#ifndef LOG_BINARY_THREAD
+#define LOG_BINARY_THREAD           (1)
+#endif
+
+/**
+ * @brief   Priority of the drain thread
+ */
+#ifndef LOG_BINARY_THREAD_PRIO
+#define LOG_BINARY_THREAD_PRIO      (THREAD_PRIORITY_IDLE - 1)
+#endif
+
+/**
+ * @brief   Stack size of the drain thread
+ */
+#ifndef LOG_BINARY_THREAD_STACKSIZE
+#define LOG_BINARY_THREAD_STACKSIZE (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Format messages in the drain thread instead of writing binary
+ *          frames
+ */
+#ifndef LOG_BINARY_DRAIN_TEXT
+#define LOG_BINARY_DRAIN_TEXT       (0)
+#endif
+
+/**
+ * @brief   Size of the record header in bytes
+ */
+#define LOG_BINARY_HDR_SIZE         (6U)
+
+/**
+ * @brief   Flag in the level field of a record if arguments were cut
+ */
+#define LOG_BINARY_LEVEL_CUT        (0x80U)
+
+/**
+ * @name    Start of a binary frame written by the drain thread
+ *
+ * Each record written to stdio by the drain thread is preceded by these two
+ * bytes, so the decoder can find records in between other output.
+ * @{
+ */
+#define LOG_BINARY_FRAME_MAGIC0     (0xa5U)
+#define LOG_BINARY_FRAME_MAGIC1     (0x5aU)
+/** @} */
+
+/**
+ * @brief   Stores a log message for deferred formatting
+ *
+ * @param[in] level     Log level of the message.
+ * @param[in] format    Format string of the message. Must stay valid
+ *                      forever, i.e. be a string literal.
+ */
+void log_write(unsigned level, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief   Takes the oldest records from the buffer
+ *
+ * Only whole records are taken. Must not be called concurrently with the
+ * drain thread.
+ *
+ * @param[out] buf      Destination for the records.
+ * @param[in] len       Size of @p buf in bytes.
+ *
+ * @return  Number of bytes written to @p buf, 0 if the buffer is empty.
+ */
+size_t log_binary_read(void *buf, size_t len);
+
+/**
+ * @brief   Formats a record and prints it to stdio
+ *
+ * @param[in] record    A record as returned by @ref log_binary_read().
+ *
+ * @return  Length of @p record in bytes.
+ */
+size_t log_binary_print(const uint8_t *record);
+
+/**
+ * @brief   Number of messages dropped because the buffer was full
+ *
+ * @return  Number of dropped messages.
+ */
+unsigned log_binary_dropped(void);
+
+/**
+ * @brief   Starts the drain thread
+ *
+ * Called by auto_init if @ref LOG_BINARY_THREAD is set.
+ */
+void log_binary_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_MODULE_H */
+/** @} */
@@ -58,7 +58,8 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
-                                   const coap_resource_t *resource);
+                                    const coap_resource_t *resource,
+                                    const sock_udp_ep_t *remote);
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -90,6 +91,11 @@ typedef struct {
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
                                            the entry is available */
+#if GCOAP_OBS_MULTI_OBSERVERS
+    uint8_t obs_buf[GCOAP_PDU_BUF_SIZE];
+                                        /* Notification with token rewritten for
+                                           another observer; protected by lock */
+#endif
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
@@ -103,6 +109,40 @@ static uint8_t _listen_buf[GCOAP_PDU_BUF_SIZE];
 static sock_udp_t _sock;
 
 
+/*
+ * The request memo, observer and observe memo tables are hash tables with
+ * linear probing: a lookup starts at the slot given by the hash of its key
+ * (token or endpoint) and an entry is stored at the first free slot from
+ * there on. As entries are removed without tombstones, a miss still visits
+ * every slot, but a hit typically only needs a single comparison.
+ */
+static unsigned _hash(unsigned hash, const uint8_t *data, size_t len)
+{
+    while (len--) {
+        hash = (hash * 31) + *(data++);
+    }
+    return hash;
+}
+
+static unsigned _ep_hash(const sock_udp_ep_t *ep)
+{
+    switch (ep->family) {
+#ifdef SOCK_HAS_IPV6
+        case AF_INET6:
+            return _hash(ep->port, ep->addr.ipv6, sizeof(ep->addr.ipv6));
+#endif
+        case AF_INET:
+            return _hash(ep->port, ep->addr.ipv4, sizeof(ep->addr.ipv4));
+        default:
+            return ep->port;
+    }
+}
+
+static inline unsigned _slot_next(unsigned slot, unsigned size)
+{
+    return (slot + 1) % size;
+}
+
 /* Event/Message loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
 {
@@ -292,8 +332,10 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         case GCOAP_RESOURCE_NO_PATH:
             return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
         case GCOAP_RESOURCE_FOUND:
-            /* find observe registration for resource */
-            _find_obs_memo_resource(&resource_memo, resource);
+            /* find observe registration for resource (by this remote if
+             * others may observe it too) */
+            _find_obs_memo_resource(&resource_memo, resource,
+                                    GCOAP_OBS_MULTI_OBSERVERS ? remote : NULL);
             break;
     }
 
@@ -318,7 +360,8 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         }
         /* initialize new registration request */
         if ((memo == NULL) && coap_has_observe(pdu)) {
-            /* verify resource not already registered (for another endpoint) */
+            /* verify resource not already registered (for another endpoint,
+             * or for this one if several observers are allowed) */
             if ((empty_slot >= 0) && (resource_memo == NULL)) {
                 int obs_slot = _find_observer(&observer, remote);
                 /* cache new observer */
@@ -407,30 +450,18 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     }
 
     while (listener) {
-        const coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-
-            int res = coap_match_path(resource, uri);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
-                if (! (resource->methods & method_flag)) {
-                    ret = GCOAP_RESOURCE_WRONG_METHOD;
-                    continue;
-                }
-
-                *resource_ptr = resource;
+        /* resources expected in alphabetical order */
+        switch (coap_find_resource(listener->resources,
+                                   listener->resources_len, uri,
+                                   method_flag, resource_ptr)) {
+            case 0:
                 *listener_ptr = listener;
                 return GCOAP_RESOURCE_FOUND;
-            }
+            case -ENOTSUP:
+                ret = GCOAP_RESOURCE_WRONG_METHOD;
+                break;
+            default:
+                break;
         }
         listener = listener->next;
     }
@@ -454,12 +485,14 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     coap_pkt_t memo_pdu_data;
     coap_pkt_t *memo_pdu = &memo_pdu_data;
     unsigned cmplen      = coap_get_token_len(src_pdu);
+    unsigned slot        = _hash(0, src_pdu->token, cmplen) % GCOAP_REQ_WAITING_MAX;
 
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
+    for (int i = 0; i < GCOAP_REQ_WAITING_MAX;
+         i++, slot = _slot_next(slot, GCOAP_REQ_WAITING_MAX)) {
+        if (_coap_state.open_reqs[slot].state == GCOAP_MEMO_UNUSED)
             continue;
 
-        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[slot];
         if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
             memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
         }
@@ -536,14 +569,18 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
 {
     int empty_slot = -1;
+    unsigned slot  = _ep_hash(remote) % GCOAP_OBS_CLIENTS_MAX;
     *observer      = NULL;
-    for (unsigned i = 0; i < GCOAP_OBS_CLIENTS_MAX; i++) {
+    for (unsigned i = 0; i < GCOAP_OBS_CLIENTS_MAX;
+         i++, slot = _slot_next(slot, GCOAP_OBS_CLIENTS_MAX)) {
 
-        if (_coap_state.observers[i].family == AF_UNSPEC) {
-            empty_slot = i;
+        if (_coap_state.observers[slot].family == AF_UNSPEC) {
+            if (empty_slot < 0) {
+                empty_slot = slot;
+            }
         }
-        else if (sock_udp_ep_equal(&_coap_state.observers[i], remote)) {
-            *observer = &_coap_state.observers[i];
+        else if (sock_udp_ep_equal(&_coap_state.observers[slot], remote)) {
+            *observer = &_coap_state.observers[slot];
             break;
         }
     }
@@ -558,35 +595,48 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
  * pdu[in] -- PDU for token to match, or NULL to match only on remote address
  *
  * return Index of empty slot, suitable for registering new memo; or -1 if no
- *        empty slots. Undefined if memo found.
+ *        empty slots. Undefined if memo found or pdu is NULL.
  */
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu)
 {
     int empty_slot = -1;
+    unsigned slot  = 0;
     *memo          = NULL;
 
     sock_udp_ep_t *remote_observer = NULL;
     _find_observer(&remote_observer, remote);
 
-    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer == NULL) {
-            empty_slot = i;
+    /* memos are stored by the hash of remote and token, so without a token
+     * any slot may hold a memo of the remote and the scan starts at the
+     * first one */
+    if (pdu != NULL) {
+        slot = _hash(_ep_hash(remote), pdu->token, coap_get_token_len(pdu)) %
+               GCOAP_OBS_REGISTRATIONS_MAX;
+    }
+    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX;
+         i++, slot = _slot_next(slot, GCOAP_OBS_REGISTRATIONS_MAX)) {
+        gcoap_observe_memo_t *obs_memo = &_coap_state.observe_memos[slot];
+
+        if (obs_memo->observer == NULL) {
+            if (empty_slot < 0) {
+                empty_slot = slot;
+            }
             continue;
         }
 
-        if (_coap_state.observe_memos[i].observer == remote_observer) {
+        if (obs_memo->observer == remote_observer) {
             if (pdu == NULL) {
-                *memo = &_coap_state.observe_memos[i];
+                *memo = obs_memo;
                 break;
             }
 
-            if (_coap_state.observe_memos[i].token_len == coap_get_token_len(pdu)) {
-                unsigned cmplen = _coap_state.observe_memos[i].token_len;
+            if (obs_memo->token_len == coap_get_token_len(pdu)) {
+                unsigned cmplen = obs_memo->token_len;
                 if (cmplen &&
-                        memcmp(&_coap_state.observe_memos[i].token[0], &pdu->token[0],
-                                                                       cmplen) == 0) {
-                    *memo = &_coap_state.observe_memos[i];
+                        memcmp(&obs_memo->token[0], &pdu->token[0],
+                                                    cmplen) == 0) {
+                    *memo = obs_memo;
                     break;
                 }
             }
@@ -600,14 +650,19 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
  *
  * memo[out] -- Registered observe memo, or NULL if not found
  * resource[in] -- Resource to match
+ * remote[in] -- Endpoint to match, or NULL to match any observer
  */
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
-                                   const coap_resource_t *resource)
+                                    const coap_resource_t *resource,
+                                    const sock_udp_ep_t *remote)
 {
     *memo = NULL;
     for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
         if (_coap_state.observe_memos[i].observer != NULL
-                && _coap_state.observe_memos[i].resource == resource) {
+                && _coap_state.observe_memos[i].resource == resource
+                && ((remote == NULL) ||
+                    sock_udp_ep_equal(_coap_state.observe_memos[i].observer,
+                                      remote))) {
             *memo = &_coap_state.observe_memos[i];
             break;
         }
@@ -737,11 +792,17 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
     /* Only allocate memory if necessary (i.e. if user is interested in the
      * response or request is confirmable) */
     if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
+        unsigned slot = _hash(0, buf + sizeof(coap_hdr_t),
+                              ((coap_hdr_t *)buf)->ver_t_tkl & 0xf)
+                        % GCOAP_REQ_WAITING_MAX;
+
         mutex_lock(&_coap_state.lock);
-        /* Find empty slot in list of open requests. */
-        for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-            if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-                memo = &_coap_state.open_reqs[i];
+        /* Find empty slot in list of open requests, starting at the token's
+         * slot so _find_req_memo() finds the memo right away. */
+        for (int i = 0; i < GCOAP_REQ_WAITING_MAX;
+             i++, slot = _slot_next(slot, GCOAP_REQ_WAITING_MAX)) {
+            if (_coap_state.open_reqs[slot].state == GCOAP_MEMO_UNUSED) {
+                memo = &_coap_state.open_reqs[slot];
                 memo->state = GCOAP_MEMO_WAIT;
                 break;
             }
@@ -864,7 +925,7 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 {
     gcoap_observe_memo_t *memo = NULL;
 
-    _find_obs_memo_resource(&memo, resource);
+    _find_obs_memo_resource(&memo, resource, NULL);
     if (memo == NULL) {
         /* Unique return value to specify there is not an observer */
         return GCOAP_OBS_INIT_UNUSED;
@@ -890,12 +951,74 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     }
 }
 
+#if GCOAP_OBS_MULTI_OBSERVERS
+/*
+ * Returns the notification in buf for the token of memo. Uses the shared
+ * buffer for notifications if the token differs from the one in buf; caller
+ * must hold _coap_state.lock.
+ */
+static const uint8_t *_obs_pdu_for_memo(const gcoap_observe_memo_t *memo,
+                                        const uint8_t *buf, size_t *len)
+{
+    const coap_hdr_t *hdr = (const coap_hdr_t *)buf;
+    unsigned token_len    = hdr->ver_t_tkl & 0xf;
+    size_t hdr_len        = sizeof(coap_hdr_t) + token_len;
+    size_t new_len        = *len - token_len + memo->token_len;
+    uint8_t *obs_buf      = _coap_state.obs_buf;
+
+    if ((memo->token_len == token_len) &&
+        (memcmp(&memo->token[0], buf + sizeof(coap_hdr_t), token_len) == 0)) {
+        return buf;
+    }
+    if ((*len < hdr_len) || (new_len > sizeof(_coap_state.obs_buf))) {
+        return NULL;
+    }
+    memcpy(obs_buf, buf, sizeof(coap_hdr_t));
+    ((coap_hdr_t *)obs_buf)->ver_t_tkl = (hdr->ver_t_tkl & ~0xf) |
+                                         memo->token_len;
+    memcpy(obs_buf + sizeof(coap_hdr_t), &memo->token[0], memo->token_len);
+    memcpy(obs_buf + sizeof(coap_hdr_t) + memo->token_len, buf + hdr_len,
+           *len - hdr_len);
+    *len = new_len;
+    return obs_buf;
+}
+
+size_t gcoap_obs_send(const uint8_t *buf, size_t len,
+                      const coap_resource_t *resource)
+{
+    size_t res = 0;
+
+    /* notify all observers of the resource in a single pass over the
+     * registrations */
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        gcoap_observe_memo_t *memo = &_coap_state.observe_memos[i];
+        const uint8_t *pdu_buf;
+        size_t pdu_len = len;
+
+        if ((memo->observer == NULL) || (memo->resource != resource)) {
+            continue;
+        }
+        if ((pdu_buf = _obs_pdu_for_memo(memo, buf, &pdu_len)) == NULL) {
+            DEBUG("gcoap: notification too large for token of observer\n");
+            continue;
+        }
+        ssize_t bytes = sock_udp_send(&_sock, pdu_buf, pdu_len,
+                                      memo->observer);
+        if ((bytes > 0) && (res == 0)) {
+            res = len;
+        }
+    }
+    mutex_unlock(&_coap_state.lock);
+    return res;
+}
+#else   /* GCOAP_OBS_MULTI_OBSERVERS */
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource)
 {
     gcoap_observe_memo_t *memo = NULL;
 
-    _find_obs_memo_resource(&memo, resource);
+    _find_obs_memo_resource(&memo, resource, NULL);
 
     if (memo) {
         ssize_t bytes = sock_udp_send(&_sock, buf, len, memo->observer);
@@ -905,6 +1028,7 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
         return 0;
     }
 }
+#endif  /* GCOAP_OBS_MULTI_OBSERVERS */
 
 uint8_t gcoap_op_state(void)
 {
@@ -1013,4 +1137,24 @@ int gcoap_add_qstring(coap_pkt_t *pdu, const char *key, const char *val)
     return coap_opt_add_string(pdu, COAP_OPT_URI_QUERY, qs, '&');
 }
 
+#ifdef TEST_SUITES
+ssize_t gcoap_handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         sock_udp_ep_t *remote)
+{
+    /* _handle_req() returns -1 in a size_t for requests not to answer */
+    return (ssize_t)_handle_req(pdu, buf, len, remote);
+}
+
+void gcoap_obs_reset(void)
+{
+    memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
+    memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
+}
+
+const gcoap_observe_memo_t *gcoap_obs_memo_array(void)
+{
+    return _coap_state.observe_memos;
+}
+#endif
+
 /** @} */
@@ -163,6 +163,105 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
     return res;
 }
 
+/* compares path to the first len characters of uri, like strcmp() would do
+ * with a copy of uri truncated to len */
+static int _cmp_prefix(const char *path, const uint8_t *uri, size_t len)
+{
+    int res = strncmp(path, (const char *)uri, len);
+
+    /* equal up to len => path is at least len characters long */
+    if ((res == 0) && (path[len] != '\0')) {
+        res = 1;
+    }
+    return res;
+}
+
+/* returns the number of resources in [0, hi) with a path sorting before or
+ * equal to the first len characters of uri */
+static size_t _upper_bound(const coap_resource_t *resources, size_t hi,
+                           const uint8_t *uri, size_t len)
+{
+    size_t lo = 0;
+
+    while (lo < hi) {
+        size_t mid = lo + ((hi - lo) / 2);
+
+        if (_cmp_prefix(resources[mid].path, uri, len) <= 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static size_t _common_prefix_len(const char *path, const uint8_t *uri)
+{
+    size_t len = 0;
+
+    while ((path[len] != '\0') && (path[len] == (char)uri[len])) {
+        len++;
+    }
+    return len;
+}
+
+int coap_find_resource(const coap_resource_t *resources, size_t resources_numof,
+                       const uint8_t *uri, coap_method_flags_t method_flag,
+                       const coap_resource_t **resource)
+{
+    const coap_resource_t *found = NULL;
+    size_t uri_len = strlen((const char *)uri);
+    /* every path matching uri sorts before or equal to uri */
+    size_t hi = _upper_bound(resources, resources_numof, uri, uri_len);
+    int res = -ENOENT;
+
+    assert((resources != NULL) || (resources_numof == 0));
+    assert(uri && resource);
+    while (hi > 0) {
+        const char *path = resources[hi - 1].path;
+        size_t prefix_len = _common_prefix_len(path, uri);
+
+        if (path[prefix_len] == '\0') {
+            /* path is uri or a prefix of it: check all resources with this
+             * path (they may differ in their methods) */
+            size_t lo = hi - 1;
+
+            while ((lo > 0) && (strcmp(resources[lo - 1].path, path) == 0)) {
+                lo--;
+            }
+            for (size_t i = hi; i > lo; i--) {
+                const coap_resource_t *r = &resources[i - 1];
+
+                if ((prefix_len == uri_len) ||
+                    (r->methods & COAP_MATCH_SUBTREE)) {
+                    if (r->methods & method_flag) {
+                        found = r;
+                    }
+                    else if (res == -ENOENT) {
+                        res = -ENOTSUP;
+                    }
+                }
+            }
+            if (prefix_len == 0) {
+                break;
+            }
+            /* only shorter prefixes of uri are left */
+            hi = _upper_bound(resources, lo, uri, prefix_len - 1);
+        }
+        else {
+            /* resources before path that match uri must be prefixes of uri not
+             * longer than prefix_len, skip everything in between */
+            hi = _upper_bound(resources, hi - 1, uri, prefix_len);
+        }
+    }
+    if (found != NULL) {
+        *resource = found;
+        return 0;
+    }
+    return res;
+}
+
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
     const coap_optpos_t *optpos = pkt->options;
@@ -393,22 +492,10 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
     }
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < coap_resources_numof; i++) {
-        const coap_resource_t *resource = &coap_resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
-        }
-
-        int res = coap_match_path(resource, uri);
-        if (res > 0) {
-            continue;
-        }
-        else if (res < 0) {
-            break;
-        }
-        else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
-        }
+    const coap_resource_t *resource;
+    if (coap_find_resource(coap_resources, coap_resources_numof, uri,
+                           method_flag, &resource) == 0) {
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
     }
 
     return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
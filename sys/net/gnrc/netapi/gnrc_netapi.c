@@ -23,6 +23,9 @@
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
+#ifdef MODULE_GNRC_PKTLATENCY
+#include "net/gnrc/pktlatency.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -48,7 +51,7 @@ int _gnrc_netapi_get_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
     return (int)ack.content.value;
 }
 
-int _gnrc_netapi_send_recv(kernel_pid_t pid, gnrc_pktsnip_t *pkt, uint16_t type)
+static int _send_recv(kernel_pid_t pid, gnrc_pktsnip_t *pkt, uint16_t type)
 {
     msg_t msg;
     /* set the outgoing message's fields */
@@ -63,6 +66,14 @@ int _gnrc_netapi_send_recv(kernel_pid_t pid, gnrc_pktsnip_t *pkt, uint16_t type)
     return ret;
 }
 
+int _gnrc_netapi_send_recv(kernel_pid_t pid, gnrc_pktsnip_t *pkt, uint16_t type)
+{
+#ifdef MODULE_GNRC_PKTLATENCY
+    gnrc_pktlatency_handover(pkt, pid, type);
+#endif
+    return _send_recv(pid, pkt, type);
+}
+
 #ifdef MODULE_GNRC_NETAPI_MBOX
 static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt)
 {
@@ -79,6 +90,20 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
+#ifdef MODULE_GNRC_PKTLATENCY
+static kernel_pid_t _target_pid(const gnrc_netreg_entry_t *entry)
+{
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    if (entry->type != GNRC_NETREG_TYPE_DEFAULT) {
+        /* is accounted to the thread that gets the packet from the mailbox
+         * or runs the callback */
+        return KERNEL_PID_UNDEF;
+    }
+#endif
+    return entry->target.pid;
+}
+#endif
+
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
@@ -88,14 +113,17 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
         gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
 
         gnrc_pktbuf_hold(pkt, numof - 1);
+#ifdef MODULE_GNRC_PKTLATENCY
+        /* only the first subscriber is tracked */
+        gnrc_pktlatency_handover(pkt, _target_pid(sendto), cmd);
+#endif
 
         while (sendto) {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
             int release = 0;
             switch (sendto->type) {
                 case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt,
-                                               cmd) < 1) {
+                    if (_send_recv(sendto->target.pid, pkt, cmd) < 1) {
                         /* unable to dispatch packet */
                         release = 1;
                     }
@@ -122,7 +150,7 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                 gnrc_pktbuf_release(pkt);
             }
 #else
-            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+            if (_send_recv(sendto->target.pid, pkt, cmd) < 1) {
                 /* unable to dispatch packet */
                 gnrc_pktbuf_release(pkt);
             }
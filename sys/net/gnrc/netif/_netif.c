@@ -15,6 +15,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <string.h>
 
 #include "fmt.h"
@@ -37,6 +38,13 @@ int netif_get_opt(netif_t *netif, netopt_t opt, uint16_t context,
                   void *value, size_t max_len)
 {
     gnrc_netif_t *iface = (gnrc_netif_t*) netif;
+#ifdef MODULE_GNRC_NETIF_OPT_CACHE
+    int res = gnrc_netif_opt_cache_get(iface, opt, context, value, max_len);
+
+    if ((res != -ENOTSUP) && (res != -EAGAIN)) {
+        return res;
+    }
+#endif
     return gnrc_netapi_get(iface->pid, opt, context, value, max_len);
 }
 
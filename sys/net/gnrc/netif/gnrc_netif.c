@@ -35,6 +35,9 @@
 
 #include "net/gnrc/netif.h"
 #include "net/gnrc/netif/internal.h"
+#ifdef MODULE_GNRC_PKTLATENCY
+#include "net/gnrc/pktlatency.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -1384,6 +1387,7 @@ static void *_gnrc_netif_thread(void *args)
     }
     _configure_netdev(dev);
     netif->ops->init(netif);
+    gnrc_netif_opt_cache_update(netif);
 #if DEVELHELP
     assert(options_tested);
 #endif
@@ -1404,9 +1408,15 @@ static void *_gnrc_netif_thread(void *args)
             case NETDEV_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
                 dev->driver->isr(dev);
+#ifdef MODULE_GNRC_PKTLATENCY
+                netif->latency_isr = 0;
+#endif
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
+#ifdef MODULE_GNRC_PKTLATENCY
+                gnrc_pktlatency_done(msg.content.ptr);
+#endif
                 res = netif->ops->send(netif, msg.content.ptr);
                 if (res < 0) {
                     DEBUG("gnrc_netif: error sending packet %p (code: %i)\n",
@@ -1437,6 +1447,15 @@ static void *_gnrc_netif_thread(void *args)
                 /* set option for device driver */
                 res = netif->ops->set(netif, opt);
                 DEBUG("gnrc_netif: response of netif->ops->set(): %i\n", res);
+#ifdef MODULE_GNRC_NETIF_OPT_CACHE
+                if (res >= 0) {
+                    /* publish before replying so the setter reads back the
+                     * new value */
+                    gnrc_netif_acquire(netif);
+                    gnrc_netif_opt_cache_update(netif);
+                    gnrc_netif_release(netif);
+                }
+#endif
                 reply.content.value = (uint32_t)res;
                 msg_reply(&msg, &reply);
                 break;
@@ -1490,6 +1509,12 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
         msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
                       .content = { .ptr = netif } };
 
+#ifdef MODULE_GNRC_PKTLATENCY
+        if (netif->latency_isr == 0) {
+            netif->latency_isr = xtimer_now_usec();
+        }
+#endif
+
         if (msg_send(&msg, netif->pid) <= 0) {
             puts("gnrc_netif: possibly lost interrupt.");
         }
@@ -1501,6 +1526,13 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             case NETDEV_EVENT_RX_COMPLETE:
                 pkt = netif->ops->recv(netif);
                 if (pkt) {
+#ifdef MODULE_GNRC_PKTLATENCY
+                    gnrc_pktlatency_start(pkt, (netif->latency_isr != 0)
+                                               ? netif->latency_isr
+                                               : xtimer_now_usec(),
+                                          netif->pid,
+                                          GNRC_PKTLATENCY_DIR_RCV);
+#endif
                     _pass_on_packet(pkt);
                 }
                 break;
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#ifdef MODULE_GNRC_NETIF_OPT_CACHE
+
+#include <errno.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "sched.h"
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* Readers only need to be protected against a writer they preempted, so a
+ * compiler barrier is sufficient on the single-core platforms we support */
+#define _barrier()      atomic_signal_fence(memory_order_seq_cst)
+
+static uint16_t _get_dev_u16(gnrc_netif_t *netif, netopt_t opt, uint8_t flag,
+                             uint8_t *valid)
+{
+    uint16_t tmp = 0;
+    gnrc_netapi_opt_t o = { .opt = opt, .data = &tmp,
+                            .data_len = sizeof(tmp) };
+
+    if (netif->ops->get(netif, &o) == sizeof(tmp)) {
+        *valid |= flag;
+    }
+    return tmp;
+}
+
+void gnrc_netif_opt_cache_update(gnrc_netif_t *netif)
+{
+    gnrc_netif_opt_cache_t *cache = &netif->opt_cache;
+    bool from_dev = (netif->pid == sched_active_pid);
+    uint8_t valid = cache->valid;
+    uint16_t max_pdu_size = cache->max_pdu_size;
+    uint16_t src_len = cache->src_len;
+    netopt_t l2addr_opt = (netopt_t)cache->l2addr_opt;
+
+    if (from_dev) {
+        /* query device before taking the sequence lock, so the window in
+         * which readers need to fall back to IPC stays small */
+        gnrc_netapi_opt_t o = { .opt = NETOPT_IS_WIRED };
+
+        valid = GNRC_NETIF_OPT_CACHE_INIT;
+        max_pdu_size = _get_dev_u16(netif, NETOPT_MAX_PDU_SIZE,
+                                    GNRC_NETIF_OPT_CACHE_MAX_PDU_SIZE, &valid);
+        src_len = _get_dev_u16(netif, NETOPT_SRC_LEN,
+                               GNRC_NETIF_OPT_CACHE_SRC_LEN, &valid);
+        if (netif->ops->get(netif, &o) > 0) {
+            valid |= GNRC_NETIF_OPT_CACHE_IS_WIRED;
+        }
+#if GNRC_NETIF_L2ADDR_MAXLEN > 0
+        if (netif->flags & GNRC_NETIF_FLAGS_HAS_L2ADDR) {
+            l2addr_opt = gnrc_netif_get_l2addr_opt(netif);
+            valid |= GNRC_NETIF_OPT_CACHE_L2ADDR;
+        }
+#endif
+    }
+    else if (!(valid & GNRC_NETIF_OPT_CACHE_INIT)) {
+        /* device values were never requested, so the interface thread is not
+         * up yet. Leave the cache invalid so readers use IPC */
+        return;
+    }
+
+    cache->seq++;
+    _barrier();
+    cache->valid = valid;
+    cache->max_pdu_size = max_pdu_size;
+    cache->src_len = src_len;
+    cache->l2addr_opt = (uint8_t)l2addr_opt;
+#if GNRC_NETIF_L2ADDR_MAXLEN > 0
+    memcpy(cache->l2addr, netif->l2addr, netif->l2addr_len);
+    cache->l2addr_len = netif->l2addr_len;
+#endif
+    cache->device_type = netif->device_type;
+    cache->cur_hl = netif->cur_hl;
+#ifdef MODULE_GNRC_IPV6
+    cache->ipv6_mtu = netif->ipv6.mtu;
+#endif
+    _barrier();
+    cache->seq++;
+    DEBUG("gnrc_netif_opt_cache: updated cache of interface %u (seq: %u)\n",
+          netif->pid, cache->seq);
+}
+
+static int _put_u16(uint16_t val, void *data, size_t max_len)
+{
+    if (max_len != sizeof(uint16_t)) {
+        return -ENOTSUP;
+    }
+    memcpy(data, &val, sizeof(val));
+    return sizeof(uint16_t);
+}
+
+static int _read(const gnrc_netif_opt_cache_t *cache, netopt_t opt,
+                 uint16_t context, void *data, size_t max_len)
+{
+    uint8_t valid = cache->valid;
+
+    switch (opt) {
+        case NETOPT_HOP_LIMIT:
+            if (max_len != sizeof(uint8_t)) {
+                return -ENOTSUP;
+            }
+            *((uint8_t *)data) = cache->cur_hl;
+            return sizeof(uint8_t);
+        case NETOPT_MAX_PDU_SIZE:
+#ifdef MODULE_GNRC_IPV6
+            if (context == GNRC_NETTYPE_IPV6) {
+                return _put_u16(cache->ipv6_mtu, data, max_len);
+            }
+#endif
+            if (valid & GNRC_NETIF_OPT_CACHE_MAX_PDU_SIZE) {
+                return _put_u16(cache->max_pdu_size, data, max_len);
+            }
+            break;
+        case NETOPT_SRC_LEN:
+            if (valid & GNRC_NETIF_OPT_CACHE_SRC_LEN) {
+                return _put_u16(cache->src_len, data, max_len);
+            }
+            break;
+        case NETOPT_DEVICE_TYPE:
+            return _put_u16(cache->device_type, data, max_len);
+        case NETOPT_IS_WIRED:
+            if (valid & GNRC_NETIF_OPT_CACHE_IS_WIRED) {
+                return 1;
+            }
+            break;
+#if GNRC_NETIF_L2ADDR_MAXLEN > 0
+        case NETOPT_ADDRESS:
+        case NETOPT_ADDRESS_LONG:
+            if ((valid & GNRC_NETIF_OPT_CACHE_L2ADDR) &&
+                (opt == (netopt_t)cache->l2addr_opt) &&
+                (max_len >= cache->l2addr_len)) {
+                memcpy(data, cache->l2addr, cache->l2addr_len);
+                return cache->l2addr_len;
+            }
+            break;
+#endif
+        default:
+            break;
+    }
+    (void)context;
+    return -ENOTSUP;
+}
+
+int gnrc_netif_opt_cache_get(const gnrc_netif_t *netif, netopt_t opt,
+                             uint16_t context, void *data, size_t max_len)
+{
+    const gnrc_netif_opt_cache_t *cache = &netif->opt_cache;
+
+    for (unsigned i = 0; i < GNRC_NETIF_OPT_CACHE_RETRIES; i++) {
+        unsigned seq = cache->seq;
+        int res;
+
+        _barrier();
+        if (seq & 1U) {
+            /* we preempted the writer */
+            continue;
+        }
+        if (!(cache->valid & GNRC_NETIF_OPT_CACHE_INIT)) {
+            return -ENOTSUP;
+        }
+        res = _read(cache, opt, context, data, max_len);
+        _barrier();
+        if (cache->seq == seq) {
+            return res;
+        }
+    }
+    DEBUG("gnrc_netif_opt_cache: no consistent snapshot for interface %u\n",
+          netif->pid);
+    return -EAGAIN;
+}
+
+#else   /* MODULE_GNRC_NETIF_OPT_CACHE */
+typedef int dont_be_pedantic;
+#endif  /* MODULE_GNRC_NETIF_OPT_CACHE */
+
+/** @} */
@@ -96,8 +96,8 @@ static bool _try_l2addr_reconfiguration(gnrc_netif_t *netif)
     uint8_t hwaddr[GNRC_NETIF_L2ADDR_MAXLEN];
     uint16_t hwaddr_len;
 
-    if (gnrc_netapi_get(netif->pid, NETOPT_SRC_LEN, 0, &hwaddr_len,
-                        sizeof(hwaddr_len)) < 0) {
+    if (netif_get_opt(&netif->netif, NETOPT_SRC_LEN, 0, &hwaddr_len,
+                      sizeof(hwaddr_len)) < 0) {
         return false;
     }
     luid_get(hwaddr, hwaddr_len);
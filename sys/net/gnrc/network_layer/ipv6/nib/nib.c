@@ -672,6 +672,7 @@ static void _handle_rtr_adv(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
     }
     if (rtr_adv->cur_hl != 0) {
         netif->cur_hl = rtr_adv->cur_hl;
+        gnrc_netif_opt_cache_update(netif);
     }
 #if GNRC_IPV6_NIB_CONF_ARSM
     if (rtr_adv->reach_time.u32 != 0) {
@@ -1360,6 +1361,7 @@ static void _handle_mtuo(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
     }
     if (byteorder_ntohl(mtuo->mtu) >= IPV6_MIN_MTU) {
         netif->ipv6.mtu = byteorder_ntohl(mtuo->mtu);
+        gnrc_netif_opt_cache_update(netif);
     }
 }
 
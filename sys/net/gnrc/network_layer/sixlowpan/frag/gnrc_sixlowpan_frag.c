@@ -21,6 +21,9 @@
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+#include "net/gnrc/sixlowpan/frag/minfwd.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD */
 #include "net/gnrc/sixlowpan/frag/rb.h"
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/gnrc/netif.h"
@@ -314,9 +317,24 @@ void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
         case SIXLOWPAN_FRAG_1_DISP:
             break;
 
-        case SIXLOWPAN_FRAG_N_DISP:
+        case SIXLOWPAN_FRAG_N_DISP: {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+            gnrc_sixlowpan_frag_vrb_t *vrbe = gnrc_sixlowpan_frag_vrb_get(
+                    gnrc_netif_hdr_get_src_addr(hdr), hdr->src_l2addr_len,
+                    sixlowpan_frag_datagram_tag(frag)
+                );
+
+            if (vrbe != NULL) {
+                /* first fragment was already forwarded, so skip reassembly
+                 * buffer and forward this fragment right away */
+                DEBUG("6lo rbuf: found VRB entry, forwarding fragment\n");
+                gnrc_sixlowpan_frag_minfwd_forward(pkt, vrbe, page);
+                return;
+            }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD */
             offset = (((sixlowpan_frag_n_t *)frag)->offset * 8);
             break;
+        }
 
         default:
             DEBUG("6lo rbuf: Not a fragment header.\n");
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/gnrc/sixlowpan/frag/minfwd.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#ifdef  MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+#include "net/gnrc/sixlowpan/frag/stats.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_STATS */
+#include "net/sixlowpan.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_pktsnip_t *_netif_hdr_from_vrbe(const gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                            bool more_data)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, vrbe->super.dst,
+                                                 vrbe->super.dst_len);
+
+    if (netif != NULL) {
+        gnrc_netif_hdr_t *netif_hdr = netif->data;
+
+        gnrc_netif_hdr_set_netif(netif_hdr, vrbe->out_netif);
+        if (more_data) {
+            netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+        }
+    }
+    return netif;
+}
+
+static int _send(gnrc_pktsnip_t *pkt, const gnrc_sixlowpan_frag_vrb_t *vrbe,
+                 bool more_data, unsigned page)
+{
+    gnrc_pktsnip_t *netif = _netif_hdr_from_vrbe(vrbe, more_data);
+
+    if (netif == NULL) {
+        DEBUG("6lo minfwd: unable to allocate link-layer header\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    LL_PREPEND(pkt, netif);
+    /* releases pkt on error */
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    gnrc_sixlowpan_frag_stats_get()->fwd_frags++;
+#endif
+    return 0;
+}
+
+int gnrc_sixlowpan_frag_minfwd_forward(gnrc_pktsnip_t *pkt,
+                                       gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                       unsigned page)
+{
+    gnrc_pktsnip_t *tmp;
+    sixlowpan_frag_n_t *hdr;
+    uint16_t offset;
+    uint16_t frag_size;
+    bool more_data;
+    int res;
+
+    assert(vrbe != NULL);
+    assert(pkt != NULL);
+    assert(sixlowpan_frag_n_is(pkt->data));
+    if ((tmp = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("6lo minfwd: unable to get write access to fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    pkt = tmp;
+    /* the link-layer header of the previous hop is replaced below */
+    if ((pkt->next != NULL) && (pkt->next->type == GNRC_NETTYPE_NETIF)) {
+        pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    }
+    hdr = pkt->data;
+    offset = sixlowpan_frag_offset(hdr);
+    frag_size = pkt->size - sizeof(sixlowpan_frag_n_t);
+    /* RFC 4944 requires to discard overlapping fragments, duplicates are
+     * dropped so they are not counted twice */
+    res = gnrc_sixlowpan_frag_rb_base_add_interval(&vrbe->super, offset,
+                                                   frag_size);
+    if (res == -EALREADY) {
+        DEBUG("6lo minfwd: dropping duplicate fragment (offset: %u)\n",
+              (unsigned)offset);
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    else if (res < 0) {
+        DEBUG("6lo minfwd: %s, removing VRB entry\n",
+              (res == -EINVAL) ? "overlapping fragment"
+                               : "unable to record fragment interval");
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+        gnrc_pktbuf_release(pkt);
+        return res;
+    }
+    more_data = ((offset + frag_size) < vrbe->super.datagram_size);
+    /* rewrite tag in place, datagram size and offset stay the same */
+    hdr->tag = byteorder_htons(vrbe->out_tag);
+    DEBUG("6lo minfwd: forwarding fragment (offset: %u, size: %u) from "
+          "tag %u to tag %u\n", (unsigned)offset, (unsigned)frag_size,
+          vrbe->super.tag, vrbe->out_tag);
+    res = _send(pkt, vrbe, more_data, page);
+    vrbe->super.current_size += frag_size;
+    vrbe->super.arrival = xtimer_now_usec();
+    if ((res < 0) ||
+        (vrbe->super.current_size >= vrbe->super.datagram_size)) {
+        DEBUG("6lo minfwd: %s, removing VRB entry\n",
+              (res < 0) ? "error forwarding" : "datagram complete");
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+    return res;
+}
+
+int gnrc_sixlowpan_frag_minfwd_frag_iphc(gnrc_pktsnip_t *pkt,
+                                         gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                         unsigned page)
+{
+    gnrc_pktsnip_t *frag;
+    sixlowpan_frag_t *hdr;
+    size_t frag_size = gnrc_pkt_len(pkt) + sizeof(sixlowpan_frag_t);
+    int res;
+
+    assert(vrbe != NULL);
+    assert(pkt != NULL);
+    assert(pkt->type == GNRC_NETTYPE_SIXLOWPAN);
+    if ((vrbe->out_netif->sixlo.max_frag_size > 0) &&
+        (frag_size > vrbe->out_netif->sixlo.max_frag_size)) {
+        DEBUG("6lo minfwd: re-compressed first fragment too large "
+              "(%u > %u)\n", (unsigned)frag_size,
+              vrbe->out_netif->sixlo.max_frag_size);
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    frag = gnrc_pktbuf_add(pkt, NULL, sizeof(sixlowpan_frag_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo minfwd: unable to allocate fragmentation header\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    hdr = frag->data;
+    hdr->disp_size = byteorder_htons(vrbe->super.datagram_size);
+    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    hdr->tag = byteorder_htons(vrbe->out_tag);
+    DEBUG("6lo minfwd: forwarding first fragment (size: %u) from tag %u to "
+          "tag %u\n", (unsigned)frag_size, vrbe->super.tag, vrbe->out_tag);
+    res = _send(frag, vrbe, true, page);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    if (res == 0) {
+        gnrc_sixlowpan_frag_stats_get()->fwd_datagrams++;
+    }
+#endif
+    return res;
+}
+
+/** @} */
@@ -13,6 +13,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <inttypes.h>
 #include <stdbool.h>
 
@@ -53,8 +54,20 @@
 #endif
 
 static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
+/* intervals released by gnrc_sixlowpan_frag_rb_base_rm(), linked via `next` */
+static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_free;
+/* number of intervals in rbuf_int that were never handed out */
+static unsigned _rbuf_int_unused = RBUF_INT_SIZE;
 
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+/* hashed index of the entries in use: each bucket chains the entries whose
+ * tuple hashes to it via _rbuf_next, which also links the free entries */
+static gnrc_sixlowpan_frag_rb_t *_rbuf_buckets[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+static gnrc_sixlowpan_frag_rb_t *_rbuf_next[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+/* entries released by gnrc_sixlowpan_frag_rb_remove() */
+static gnrc_sixlowpan_frag_rb_t *_rbuf_free;
+/* number of entries in rbuf that were never handed out */
+static unsigned _rbuf_unused = CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE;
 
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
@@ -72,11 +85,17 @@ static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void);
 /* update interval buffer of entry */
 static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                               uint16_t offset, size_t frag_size);
+/* gets a free entry from rbuf */
+static gnrc_sixlowpan_frag_rb_t *_rbuf_get_free(void);
 /* gets an entry identified by its tuple */
 static int _rbuf_get(const void *src, size_t src_len,
                      const void *dst, size_t dst_len,
                      size_t size, uint16_t tag,
                      unsigned page);
+/* gets the bucket of a datagram in _rbuf_buckets */
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           uint16_t tag);
 /* gets an entry only by link-layer information and tag */
 static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
                                                   uint16_t tag);
@@ -96,12 +115,16 @@ static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
                             size_t frag_size, size_t offset)
 {
     gnrc_sixlowpan_frag_rb_int_t *ptr = entry->ints;
+    uint16_t end = (uint16_t)(offset + frag_size - 1);
 
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
-     * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
+     * https://tools.ietf.org/html/rfc4944#section-5.3
+     *
+     * Intervals are sorted by their start (see _rbuf_update_ints()), so no
+     * interval beyond the first one starting after `end` can overlap */
+    while ((ptr != NULL) && (ptr->start <= end)) {
+        if (_rbuf_int_overlap_partially(ptr, offset, end)) {
 
             /* "A fresh reassembly may be commenced with the most recently
              * received link fragment"
@@ -163,11 +186,12 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
     const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
     const uint8_t src_len = netif_hdr->src_l2addr_len;
     const uint8_t dst_len = netif_hdr->dst_l2addr_len;
+    gnrc_sixlowpan_frag_rb_t *e = _rbuf_buckets[_rbuf_hash(src, src_len,
+                                                            dst, dst_len,
+                                                            tag)];
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
-
-        if ((e->pkt != NULL) && (e->super.tag == tag) &&
+    for (; e != NULL; e = _rbuf_next[e - rbuf]) {
+        if ((e->super.tag == tag) &&
             (e->super.src_len == src_len) &&
             (e->super.dst_len == dst_len) &&
             (memcmp(e->super.src, src, src_len) == 0) &&
@@ -178,6 +202,23 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
     return NULL;
 }
 
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           uint16_t tag)
+{
+    /* the datagram size is not part of the key, as it is not known for
+     * _rbuf_get_by_tag() */
+    unsigned idx = tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        idx = (idx * 31) + src[i];
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        idx = (idx * 31) + dst[i];
+    }
+    return idx % CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE;
+}
+
 #ifndef NDEBUG
 static bool _valid_offset(gnrc_pktsnip_t *pkt, size_t offset)
 {
@@ -323,19 +364,46 @@ static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
 
 static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
+    gnrc_sixlowpan_frag_rb_int_t *res = _rbuf_int_free;
+
+    if (res != NULL) {
+        _rbuf_int_free = res->next;
+        res->next = NULL;
     }
+    else if (_rbuf_int_unused > 0) {
+        res = &rbuf_int[RBUF_INT_SIZE - _rbuf_int_unused];
+        _rbuf_int_unused--;
+    }
+    return res;
+}
 
-    return NULL;
+static gnrc_sixlowpan_frag_rb_t *_rbuf_get_free(void)
+{
+    gnrc_sixlowpan_frag_rb_t *res = _rbuf_free;
+
+    if (res != NULL) {
+        _rbuf_free = _rbuf_next[res - rbuf];
+        _rbuf_next[res - rbuf] = NULL;
+    }
+    else if (_rbuf_unused > 0) {
+        res = &rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE - _rbuf_unused];
+        _rbuf_unused--;
+    }
+    return res;
+}
+
+static void _rbuf_int_release(gnrc_sixlowpan_frag_rb_int_t *i)
+{
+    i->start = 0;
+    i->end = 0;
+    i->next = _rbuf_int_free;
+    _rbuf_int_free = i;
 }
 
 static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                               uint16_t offset, size_t frag_size)
 {
-    gnrc_sixlowpan_frag_rb_int_t *new;
+    gnrc_sixlowpan_frag_rb_int_t *new, **ptr = &entry->ints;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
 
     new = _rbuf_int_get_free();
@@ -357,7 +425,12 @@ static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                                                   l2addr_str),
           entry->datagram_size, entry->tag);
 
-    LL_PREPEND(entry->ints, new);
+    /* keep intervals sorted by start for _check_fragments() */
+    while ((*ptr != NULL) && ((*ptr)->start < new->start)) {
+        ptr = &(*ptr)->next;
+    }
+    new->next = *ptr;
+    *ptr = new;
 
     return true;
 }
@@ -414,56 +487,52 @@ static int _rbuf_get(const void *src, size_t src_len,
                      size_t size, uint16_t tag,
                      unsigned page)
 {
-    gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
+    gnrc_sixlowpan_frag_rb_t *res, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
-
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+    unsigned hash = _rbuf_hash(src, src_len, dst, dst_len, tag);
+
+    /* check first if entry already available */
+    for (res = _rbuf_buckets[hash]; res != NULL; res = _rbuf_next[res - rbuf]) {
+        if ((res->super.datagram_size == size) &&
+            (res->super.tag == tag) && (res->super.src_len == src_len) &&
+            (res->super.dst_len == dst_len) &&
+            (memcmp(res->super.src, src, src_len) == 0) &&
+            (memcmp(res->super.dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+                  gnrc_netif_addr_to_str(res->super.src,
+                                         res->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(res->super.dst,
+                                         res->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+                  (unsigned)res->super.datagram_size, res->super.tag);
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
+            if (res->super.current_size == 0) {
                 /* ensure that only empty reassembly buffer entries and entries
                  * scheduled for deletion have `current_size == 0` */
                 DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
                 return -1;
             }
 #endif
-            rbuf[i].super.arrival = now_usec;
+            res->super.arrival = now_usec;
             _set_rbuf_timeout();
-            return i;
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
-            res = &(rbuf[i]);
-        }
-
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) ||
-            (oldest->super.arrival - rbuf[i].super.arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
+            return res - &(rbuf[0]);
         }
     }
 
+    res = _rbuf_get_free();
     /* entry not in buffer and no empty spot found */
     if (res == NULL) {
+        /* only a full buffer needs to be searched for the oldest entry */
+        for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+            /* note that xtimer_now will overflow in ~1.2 hours */
+            if ((oldest == NULL) ||
+                (oldest->super.arrival - rbuf[i].super.arrival < UINT32_MAX / 2)) {
+                oldest = &(rbuf[i]);
+            }
+        }
         assert(oldest != NULL);
-        /* if oldest is not empty, res must not be NULL (because otherwise
-         * oldest could have been picked as res) */
         assert(!gnrc_sixlowpan_frag_rb_entry_empty(oldest));
         if (GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE ||
             ((now_usec - oldest->super.arrival) >
@@ -471,7 +540,8 @@ static int _rbuf_get(const void *src, size_t src_len,
             DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
             gnrc_pktbuf_release(oldest->pkt);
             gnrc_sixlowpan_frag_rb_remove(oldest);
-            res = oldest;
+            res = _rbuf_get_free();
+            assert(res == oldest);
 #if GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE && \
     defined(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
             gnrc_sixlowpan_frag_stats_get()->rbuf_full++;
@@ -501,6 +571,8 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->pkt = gnrc_pktbuf_add(NULL, NULL, size, reass_type);
     if (res->pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        _rbuf_next[res - rbuf] = _rbuf_free;
+        _rbuf_free = res;
         return -1;
     }
 
@@ -514,6 +586,8 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    _rbuf_next[res - rbuf] = _rbuf_buckets[hash];
+    _rbuf_buckets[hash] = res;
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -533,6 +607,8 @@ void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
     memset(rbuf_int, 0, sizeof(rbuf_int));
+    _rbuf_int_free = NULL;
+    _rbuf_int_unused = RBUF_INT_SIZE;
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -540,6 +616,9 @@ void gnrc_sixlowpan_frag_rb_reset(void)
         }
     }
     memset(rbuf, 0, sizeof(rbuf));
+    memset(_rbuf_buckets, 0, sizeof(_rbuf_buckets));
+    _rbuf_free = NULL;
+    _rbuf_unused = CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE;
 }
 
 const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
@@ -548,19 +627,54 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
 }
 #endif
 
+void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf_entry)
+{
+    assert(rbuf_entry != NULL);
+    if (rbuf_entry->pkt != NULL) {
+        /* the key is still set, so the entry can be found in its bucket */
+        gnrc_sixlowpan_frag_rb_t **ptr = &_rbuf_buckets[
+                _rbuf_hash(rbuf_entry->super.src, rbuf_entry->super.src_len,
+                           rbuf_entry->super.dst, rbuf_entry->super.dst_len,
+                           rbuf_entry->super.tag)
+            ];
+
+        while (*ptr != rbuf_entry) {
+            assert(*ptr != NULL);
+            ptr = &_rbuf_next[*ptr - rbuf];
+        }
+        *ptr = _rbuf_next[rbuf_entry - rbuf];
+        _rbuf_next[rbuf_entry - rbuf] = _rbuf_free;
+        _rbuf_free = rbuf_entry;
+    }
+    gnrc_sixlowpan_frag_rb_base_rm(&rbuf_entry->super);
+    rbuf_entry->pkt = NULL;
+}
+
 void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
 {
     while (entry->ints != NULL) {
         gnrc_sixlowpan_frag_rb_int_t *next = entry->ints->next;
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
+        _rbuf_int_release(entry->ints);
         entry->ints = next;
     }
     entry->datagram_size = 0;
 }
 
+int gnrc_sixlowpan_frag_rb_base_add_interval(gnrc_sixlowpan_frag_rb_base_t *entry,
+                                             uint16_t offset, size_t frag_size)
+{
+    switch (_check_fragments(entry, frag_size, offset)) {
+        case RBUF_ADD_REPEAT:
+            return -EINVAL;
+        case RBUF_ADD_DUPLICATE:
+            return -EALREADY;
+        default:
+            break;
+    }
+    return _rbuf_update_ints(entry, offset, frag_size) ? 0 : -ENOMEM;
+}
+
 static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
 {
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0U
@@ -46,6 +46,23 @@ static inline bool _equal_index(const gnrc_sixlowpan_frag_vrb_t *vrbe,
             (memcmp(vrbe->super.src, src, src_len) == 0));
 }
 
+/* entries are searched starting from a slot determined by the index tuple, so
+ * subsequent fragments usually find their entry with the first comparison */
+static inline unsigned _start_idx(const uint8_t *src, size_t src_len,
+                                  unsigned tag)
+{
+    unsigned idx = tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        idx = (idx * 31U) + src[i];
+    }
+    return idx % CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE;
+}
+
+static inline unsigned _next_idx(unsigned idx)
+{
+    return (idx + 1) % CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE;
+}
 
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
         const gnrc_sixlowpan_frag_rb_base_t *base,
@@ -57,8 +74,9 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
     assert(out_netif != NULL);
     assert(out_dst != NULL);
     assert(out_dst_len > 0);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *ptr = &_vrb[i];
+    for (unsigned i = 0, idx = _start_idx(base->src, base->src_len, base->tag);
+         i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++, idx = _next_idx(idx)) {
+        gnrc_sixlowpan_frag_vrb_t *ptr = &_vrb[idx];
 
         if (gnrc_sixlowpan_frag_vrb_entry_empty(ptr) ||
             _equal_index(ptr, base->src, base->src_len, base->tag)) {
@@ -171,8 +189,9 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
 {
     DEBUG("6lo vrb: trying to get entry for (%s, %u)\n",
           gnrc_netif_addr_to_str(src, src_len, addr_str), src_tag);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
+    for (unsigned i = 0, idx = _start_idx(src, src_len, src_tag);
+         i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++, idx = _next_idx(idx)) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[idx];
 
         if (_equal_index(vrbe, src, src_len, src_tag)) {
             DEBUG("6lo vrb: got VRB to (%s, %u)\n",
@@ -24,6 +24,9 @@
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+#include "net/gnrc/sixlowpan/frag/minfwd.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD */
 #include "net/gnrc/sixlowpan/frag/rb.h"
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
 #include "net/gnrc/sixlowpan/frag/vrb.h"
@@ -597,6 +600,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             (rbuf->super.current_size <= iface->sixlo.max_frag_size) &&
             (vrbe = gnrc_sixlowpan_frag_vrb_from_route(&rbuf->super, iface,
                                                        ipv6))) {
+            /* intervals are owned by the VRB entry now, so they are not
+             * released twice when either entry is removed */
+            rbuf->super.ints = NULL;
             /* add netif header to `ipv6` so its flags can be used when
              * forwarding the fragment */
             LL_DELETE(sixlo, netif);
@@ -648,8 +654,6 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                 if ((res = _forward_frag(ipv6, sixlo->next, vrbe, page)) == 0) {
                     DEBUG("6lo iphc: successfully recompressed and forwarded "
                           "1st fragment\n");
-                    /* empty list, as it should be in VRB now */
-                    rbuf->super.ints = NULL;
                 }
             }
             if ((ipv6 == NULL) || (res < 0)) {
@@ -717,6 +721,10 @@ static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *frag_hdr,
     /* remove rewritten netif header (forwarding implementation must do this
      * anyway) */
     pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+    (void)frag_hdr;
+    return gnrc_sixlowpan_frag_minfwd_frag_iphc(pkt, vrbe, page);
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD */
     /* the following is just debug output for testing without any forwarding
      * scheme */
     DEBUG("6lo iphc: Do not know how to forward fragment from (%s, %u) ",
@@ -739,6 +747,7 @@ static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *frag_hdr,
     (void)frag_hdr;
     (void)page;
     return -ENOTSUP;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD */
 }
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
 
@@ -74,6 +74,9 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 #ifdef MODULE_GNRC_NETERR
     pkt->err_sub = KERNEL_PID_UNDEF;
 #endif
+#ifdef MODULE_GNRC_PKTLATENCY
+    pkt->latency_flags = 0;
+#endif
 }
 
 void gnrc_pktbuf_init(void)
@@ -241,6 +244,11 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
         new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
         if (new != NULL) {
             pkt->users--;
+#ifdef MODULE_GNRC_PKTLATENCY
+            new->latency_stamp = pkt->latency_stamp;
+            new->latency_pid = pkt->latency_pid;
+            new->latency_flags = pkt->latency_flags;
+#endif
         }
         mutex_unlock(&_mutex);
         return new;
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "sched.h"
+#include "xtimer.h"
+
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/pktlatency.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_pktlatency_stats_t _stats[MAXTHREADS][GNRC_PKTLATENCY_DIR_NUMOF];
+
+static gnrc_pktsnip_t *_tracked(gnrc_pktsnip_t *pkt)
+{
+    while (pkt != NULL) {
+        if (pkt->latency_flags & GNRC_PKTLATENCY_TRACKED) {
+            return pkt;
+        }
+        pkt = pkt->next;
+    }
+    return NULL;
+}
+
+static unsigned _bucket(uint32_t latency)
+{
+    unsigned bucket;
+
+    latency >>= GNRC_PKTLATENCY_HIST_SHIFT;
+    if (latency == 0) {
+        return 0;
+    }
+    bucket = bitarithm_msb(latency) + 1;
+    return (bucket < GNRC_PKTLATENCY_HIST_BUCKETS)
+         ? bucket
+         : (GNRC_PKTLATENCY_HIST_BUCKETS - 1);
+}
+
+static void _account(const gnrc_pktsnip_t *snip, uint32_t now)
+{
+    kernel_pid_t pid = snip->latency_pid;
+    gnrc_pktlatency_stats_t *stats;
+    uint32_t latency = now - snip->latency_stamp;
+
+    if (pid == KERNEL_PID_UNDEF) {
+        /* hand-over target was not known, so it is us */
+        pid = sched_active_pid;
+    }
+    if (!pid_is_valid(pid)) {
+        return;
+    }
+    stats = &_stats[pid - KERNEL_PID_FIRST][
+        (snip->latency_flags & GNRC_PKTLATENCY_SND)
+            ? GNRC_PKTLATENCY_DIR_SND
+            : GNRC_PKTLATENCY_DIR_RCV
+    ];
+    DEBUG("gnrc_pktlatency: %" PRIu32 " usec at %" PRIkernel_pid " (%s)\n",
+          latency, pid,
+          (snip->latency_flags & GNRC_PKTLATENCY_SND) ? "snd" : "rcv");
+    if (stats->stat.count == 0) {
+        /* statistics are zero-initialized, but min and max need to start at
+         * the other end */
+        matstat_clear(&stats->stat);
+    }
+    matstat_add(&stats->stat, (int32_t)latency);
+    stats->hist[_bucket(latency)]++;
+}
+
+static void _stamp(gnrc_pktsnip_t *snip, uint32_t now, kernel_pid_t pid,
+                   gnrc_pktlatency_dir_t dir)
+{
+    snip->latency_stamp = now;
+    snip->latency_pid = pid;
+    snip->latency_flags = GNRC_PKTLATENCY_TRACKED;
+    if (dir == GNRC_PKTLATENCY_DIR_SND) {
+        snip->latency_flags |= GNRC_PKTLATENCY_SND;
+    }
+}
+
+void gnrc_pktlatency_start(gnrc_pktsnip_t *pkt, uint32_t since,
+                           kernel_pid_t pid, gnrc_pktlatency_dir_t dir)
+{
+    gnrc_pktsnip_t *snip = _tracked(pkt);
+
+    if (snip != NULL) {
+        snip->latency_flags = 0;
+    }
+    _stamp(pkt, since, pid, dir);
+}
+
+void gnrc_pktlatency_handover(gnrc_pktsnip_t *pkt, kernel_pid_t pid,
+                              uint16_t cmd)
+{
+    uint32_t now = xtimer_now_usec();
+    gnrc_pktsnip_t *snip = _tracked(pkt);
+
+    if (snip != NULL) {
+        _account(snip, now);
+    }
+    else {
+        snip = pkt;
+    }
+    _stamp(snip, now, pid, (cmd == GNRC_NETAPI_MSG_TYPE_SND)
+                           ? GNRC_PKTLATENCY_DIR_SND
+                           : GNRC_PKTLATENCY_DIR_RCV);
+}
+
+void gnrc_pktlatency_done(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snip = _tracked(pkt);
+
+    if (snip != NULL) {
+        _account(snip, xtimer_now_usec());
+        snip->latency_flags = 0;
+    }
+}
+
+const gnrc_pktlatency_stats_t *gnrc_pktlatency_stats_get(kernel_pid_t pid,
+                                                         gnrc_pktlatency_dir_t dir)
+{
+    if (!pid_is_valid(pid) || (dir >= GNRC_PKTLATENCY_DIR_NUMOF)) {
+        return NULL;
+    }
+    return &_stats[pid - KERNEL_PID_FIRST][dir];
+}
+
+void gnrc_pktlatency_stats_reset(void)
+{
+    for (unsigned i = 0; i < MAXTHREADS; i++) {
+        for (unsigned dir = 0; dir < GNRC_PKTLATENCY_DIR_NUMOF; dir++) {
+            _stats[i][dir].stat.count = 0;
+            memset(_stats[i][dir].hist, 0, sizeof(_stats[i][dir].hist));
+        }
+    }
+}
+
+/** @} */
@@ -21,6 +21,9 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/netreg.h"
+#ifdef MODULE_GNRC_PKTLATENCY
+#include "net/gnrc/pktlatency.h"
+#endif
 #include "net/udp.h"
 #include "utlist.h"
 #include "xtimer.h"
@@ -110,6 +113,9 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
     switch (msg.type) {
         case GNRC_NETAPI_MSG_TYPE_RCV:
             pkt = msg.content.ptr;
+#ifdef MODULE_GNRC_PKTLATENCY
+            gnrc_pktlatency_done(pkt);
+#endif
             break;
 #ifdef MODULE_XTIMER
         case _TIMEOUT_MSG_TYPE:
@@ -15,6 +15,7 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "thread.h"
@@ -48,6 +49,36 @@ static const char *state_names[] = {
     [STATUS_COND_BLOCKED] = "bl cond",
 };
 
+#ifdef MODULE_SCHEDSTATISTICS
+static unsigned _permille(uint32_t part, uint32_t total)
+{
+    return (total > 0) ? (unsigned)(((uint64_t)part * 1000) / total) : 0;
+}
+
+static void _print_schedstat(void)
+{
+    schedstat_cpu_t cpu;
+
+    schedstat_get_cpu(&cpu);
+    unsigned isr_window = _permille(cpu.last_window_isr_ticks,
+                                    cpu.last_window_ticks);
+    printf("\tISR: %u calls, %" PRIu32 " ticks, last window %u.%u%% of %"
+           PRIu32 " ticks\n", cpu.isr_count, (uint32_t)cpu.isr_ticks,
+           isr_window / 10, isr_window % 10, cpu.last_window_ticks);
+    for (unsigned prio = 0; prio < SCHED_PRIO_LEVELS; prio++) {
+        schedstat_latency_t lat;
+
+        schedstat_get_latency(prio, &lat);
+        if (lat.count == 0) {
+            continue;
+        }
+        printf("\tlatency pri %2u: %u wakeups, mean %" PRIu32 " max %" PRIu32
+               " ticks\n", prio, lat.count,
+               (uint32_t)(lat.total_ticks / lat.count), lat.max_ticks);
+    }
+}
+#endif /* MODULE_SCHEDSTATISTICS */
+
 /**
  * @brief Prints a list of running threads including stack usage to stdout.
  */
@@ -67,7 +98,7 @@ void ps(void)
            "| stack  ( used) | base addr  | current     "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-           "| runtime  | switches"
+           "| runtime  | switches  | window"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -116,6 +147,8 @@ void ps(void)
             unsigned runtime_major = runtime_ticks / rt_sum;
             unsigned runtime_minor = ((runtime_ticks % rt_sum) * 1000) / rt_sum;
             unsigned switches = sched_pidlist[i].schedules;
+            unsigned window = _permille(sched_pidlist[i].last_window_ticks,
+                                        sched_cpustat.last_window_ticks);
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -126,7 +159,7 @@ void ps(void)
                    " | %6i (%5i) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   " | %2d.%03d%% |  %8u"
+                   " | %2d.%03d%% |  %8u | %3u.%u%%"
 #endif
                    "\n",
                    p->pid,
@@ -138,7 +171,8 @@ void ps(void)
                    , p->stack_size, stacksz, (void *)p->stack_start, (void *)p->sp
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   , runtime_major, runtime_minor, switches
+                   , runtime_major, runtime_minor, switches,
+                   window / 10, window % 10
 #endif
                   );
         }
@@ -155,4 +189,7 @@ void ps(void)
     printf("\tTotal used size: %u\n", sizes.used);
 #   endif
 #endif
+#ifdef MODULE_SCHEDSTATISTICS
+    _print_schedstat();
+#endif
 }
@@ -36,13 +36,7 @@ static inline size_t min(size_t a, size_t b)
 
 size_t riotboot_flashwrite_slotsize(const riotboot_flashwrite_t *state)
 {
-    switch (state->target_slot) {
-        case 0: return SLOT0_LEN;
-#if NUM_SLOTS==2
-        case 1: return SLOT1_LEN;
-#endif
-        default: return 0;
-    }
+    return riotboot_slot_size(state->target_slot);
 }
 
 int riotboot_flashwrite_init_raw(riotboot_flashwrite_t *state, int target_slot,
@@ -59,6 +53,22 @@ int riotboot_flashwrite_init_raw(riotboot_flashwrite_t *state, int target_slot,
     state->target_slot = target_slot;
     state->flashpage = flashpage_page((void *)riotboot_slot_get_hdr(target_slot));
 
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_VERIFY_SHA256
+    sha256_init(&state->sha256);
+#endif
+
+    return 0;
+}
+
+static int _write_page(riotboot_flashwrite_t *state)
+{
+    flashpage_write(state->flashpage, state->flashpage_buf);
+    if (CONFIG_RIOTBOOT_FLASHWRITE_READBACK &&
+        (flashpage_verify(state->flashpage, state->flashpage_buf) != FLASHPAGE_OK)) {
+        LOG_WARNING(LOG_PREFIX "error writing flashpage %u!\n", state->flashpage);
+        return -1;
+    }
+    state->flashpage++;
     return 0;
 }
 
@@ -67,6 +77,15 @@ int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
 {
     LOG_DEBUG(LOG_PREFIX "processing bytes %u-%u\n", state->offset, state->offset + len - 1);
 
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_VERIFY_SHA256
+    sha256_update(&state->sha256, bytes, len);
+#endif
+
+    if (!len && !more && (state->offset % FLASHPAGE_SIZE)) {
+        /* write the partially filled last page */
+        return _write_page(state);
+    }
+
     while (len) {
         size_t flashpage_pos = state->offset % FLASHPAGE_SIZE;
         size_t flashpage_avail = FLASHPAGE_SIZE - flashpage_pos;
@@ -80,11 +99,9 @@ int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
         bytes += to_copy;
         len -= to_copy;
         if ((!flashpage_avail) || (!more)) {
-            if (flashpage_write_and_verify(state->flashpage, state->flashpage_buf) != FLASHPAGE_OK) {
-                LOG_WARNING(LOG_PREFIX "error writing flashpage %u!\n", state->flashpage);
+            if (_write_page(state) < 0) {
                 return -1;
             }
-            state->flashpage++;
         }
     }
 
@@ -25,6 +25,7 @@
 
 #include "hashes/sha256.h"
 #include "log.h"
+#include "riotboot/flashwrite.h"
 #include "riotboot/slot.h"
 
 int riotboot_flashwrite_verify_sha256(const uint8_t *sha256_digest, size_t img_len, int target_slot)
@@ -55,3 +56,25 @@ int riotboot_flashwrite_verify_sha256(const uint8_t *sha256_digest, size_t img_l
 
     return memcmp(sha256_digest, digest, SHA256_DIGEST_LENGTH) != 0;
 }
+
+int riotboot_flashwrite_verify_sha256_stream(riotboot_flashwrite_t *state,
+                                             const uint8_t *sha256_digest,
+                                             size_t img_len)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+
+    if (img_len < 4) {
+        LOG_INFO("riotboot: verify_sha256_stream(): image too small\n");
+        return -1;
+    }
+
+    if (state->offset != img_len) {
+        LOG_INFO("riotboot: verify_sha256_stream(): got %u bytes, expected %u\n",
+                 (unsigned)state->offset, (unsigned)img_len);
+        return 1;
+    }
+
+    sha256_final(&state->sha256, digest);
+
+    return memcmp(sha256_digest, digest, SHA256_DIGEST_LENGTH) != 0;
+}
@@ -21,11 +21,40 @@
  * @}
  */
 
+#include <errno.h>
+#include <stdbool.h>
+
+#include "irq.h"
 #include "sched.h"
+#include "thread.h"
 #include "xtimer.h"
 #include "schedstatistics.h"
 
 schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
+schedstat_cpu_t sched_cpustat;
+schedstat_latency_t sched_latency[SCHED_PRIO_LEVELS];
+
+static uint32_t _window_ticks;
+/* ISR time not yet subtracted from the runtime of the active thread */
+static uint32_t _isr_slice;
+static uint32_t _isr_start;
+static unsigned _isr_nesting;
+static bool _initialized;
+
+static void _roll_window(uint32_t now)
+{
+    if ((now - sched_cpustat.window_start) < _window_ticks) {
+        return;
+    }
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        sched_pidlist[pid].last_window_ticks = sched_pidlist[pid].window_ticks;
+        sched_pidlist[pid].window_ticks = 0;
+    }
+    sched_cpustat.last_window_ticks = now - sched_cpustat.window_start;
+    sched_cpustat.last_window_isr_ticks = sched_cpustat.window_isr_ticks;
+    sched_cpustat.window_isr_ticks = 0;
+    sched_cpustat.window_start = now;
+}
 
 void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
 {
@@ -34,12 +63,59 @@ void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
     /* Update active thread runtime, there is always an active thread since
        first sched_run happens when main_trampoline gets scheduled */
     schedstat_t *active_stat = &sched_pidlist[active_thread];
-    active_stat->runtime_ticks += now - active_stat->laststart;
+    uint32_t slice = now - active_stat->laststart;
+
+    /* ISRs that preempted the thread did not run on its behalf */
+    slice = (slice > _isr_slice) ? (slice - _isr_slice) : 0;
+    _isr_slice = 0;
+    active_stat->runtime_ticks += slice;
+    active_stat->window_ticks += slice;
+    _roll_window(now);
 
     /* Update next_thread stats */
     schedstat_t *next_stat = &sched_pidlist[next_thread];
     next_stat->laststart = now;
     next_stat->schedules++;
+    if (next_stat->runnable) {
+        schedstat_latency_t *lat = &sched_latency[
+            sched_threads[next_thread]->priority
+        ];
+        uint32_t latency = now - next_stat->runnable_since;
+
+        next_stat->runnable = 0;
+        lat->count++;
+        lat->total_ticks += latency;
+        if (latency > lat->max_ticks) {
+            lat->max_ticks = latency;
+        }
+    }
+}
+
+static void _runnable_cb(kernel_pid_t pid)
+{
+    schedstat_t *stat = &sched_pidlist[pid];
+
+    stat->runnable_since = xtimer_now().ticks32;
+    stat->runnable = 1;
+}
+
+void schedstat_isr_enter(void)
+{
+    if (_initialized && (_isr_nesting++ == 0)) {
+        _isr_start = xtimer_now().ticks32;
+    }
+}
+
+void schedstat_isr_exit(void)
+{
+    if (_initialized && (--_isr_nesting == 0)) {
+        uint32_t duration = xtimer_now().ticks32 - _isr_start;
+
+        sched_cpustat.isr_ticks += duration;
+        sched_cpustat.isr_count++;
+        sched_cpustat.window_isr_ticks += duration;
+        _isr_slice += duration;
+    }
 }
 
 void init_schedstatistics(void)
@@ -49,5 +125,56 @@ void init_schedstatistics(void)
     schedstat_t *active_stat = &sched_pidlist[sched_active_pid];
     active_stat->laststart = xtimer_now().ticks32;
     active_stat->schedules = 1;
+    _window_ticks = xtimer_ticks_from_usec(SCHEDSTATISTICS_WINDOW_US).ticks32;
+    sched_cpustat.window_start = active_stat->laststart;
+    _initialized = true;
+    sched_register_runnable_cb(_runnable_cb);
     sched_register_cb(sched_statistics_cb);
 }
+
+int schedstat_get_thread(kernel_pid_t pid, schedstat_thread_t *stat)
+{
+    thread_t *thread;
+    unsigned state = irq_disable();
+
+    if (!pid_is_valid(pid) ||
+        ((thread = (thread_t *)sched_threads[pid]) == NULL)) {
+        irq_restore(state);
+        return -ENOENT;
+    }
+    stat->runtime_ticks = sched_pidlist[pid].runtime_ticks;
+    stat->schedules = sched_pidlist[pid].schedules;
+    stat->last_window_ticks = sched_pidlist[pid].last_window_ticks;
+    stat->priority = thread->priority;
+    irq_restore(state);
+#ifdef DEVELHELP
+    stat->stack_size = thread->stack_size;
+    stat->stack_used = thread->stack_size -
+                       thread_measure_stack_free(thread->stack_start);
+#else
+    stat->stack_size = 0;
+    stat->stack_used = 0;
+#endif
+    return 0;
+}
+
+void schedstat_get_cpu(schedstat_cpu_t *stat)
+{
+    unsigned state = irq_disable();
+
+    *stat = sched_cpustat;
+    irq_restore(state);
+}
+
+int schedstat_get_latency(uint8_t prio, schedstat_latency_t *stat)
+{
+    unsigned state;
+
+    if (prio >= SCHED_PRIO_LEVELS) {
+        return -EINVAL;
+    }
+    state = irq_disable();
+    *stat = sched_latency[prio];
+    irq_restore(state);
+    return 0;
+}
@@ -27,6 +27,10 @@ int _gnrc_6lo_frag_stats(int argc, char **argv)
     printf("frag full: %u\n", stats->frag_full);
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
     printf("VRB full: %u\n", stats->vrb_full);
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+    printf("datagrams fwd: %u\n", stats->fwd_datagrams);
+    printf("fragments fwd: %u\n", stats->fwd_frags);
 #endif
     return 0;
 }
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "thread.h"
+#include "net/gnrc/pktlatency.h"
+
+static void _print_hist(const gnrc_pktlatency_stats_t *stats)
+{
+    printf("    ");
+    for (unsigned i = 0; i < GNRC_PKTLATENCY_HIST_BUCKETS; i++) {
+        if (stats->hist[i] == 0) {
+            continue;
+        }
+        if (i < (GNRC_PKTLATENCY_HIST_BUCKETS - 1)) {
+            printf(" <%" PRIu32 ":", (uint32_t)1 << (GNRC_PKTLATENCY_HIST_SHIFT + i));
+        }
+        else {
+            printf(" >=%" PRIu32 ":", (uint32_t)1 << (GNRC_PKTLATENCY_HIST_SHIFT + i - 1));
+        }
+        printf("%" PRIu32, stats->hist[i]);
+    }
+    puts("");
+}
+
+static void _print(void)
+{
+    static const char *dirs[] = { "rcv", "snd" };
+
+    puts("pid | name                 | dir |   count |     min |    mean |     max (usec)");
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        for (unsigned dir = 0; dir < GNRC_PKTLATENCY_DIR_NUMOF; dir++) {
+            const gnrc_pktlatency_stats_t *stats = gnrc_pktlatency_stats_get(pid, dir);
+            const char *name = thread_getname(pid);
+
+            if (stats->stat.count == 0) {
+                continue;
+            }
+            printf("%3" PRIkernel_pid " | %-20s | %s | %7" PRIu32 " | %7" PRIi32
+                   " | %7" PRIi32 " | %7" PRIi32 "\n", pid,
+                   (name != NULL) ? name : "-", dirs[dir], stats->stat.count,
+                   stats->stat.min, matstat_mean(&stats->stat),
+                   stats->stat.max);
+            _print_hist(stats);
+        }
+    }
+}
+
+int _gnrc_pktlatency(int argc, char **argv)
+{
+    if (argc < 2) {
+        _print();
+        return 0;
+    }
+    if (strcmp(argv[1], "reset") == 0) {
+        gnrc_pktlatency_stats_reset();
+        return 0;
+    }
+    printf("usage: %s [reset]\n", argv[0]);
+    return 1;
+}
+
+/** @} */
@@ -107,6 +107,10 @@ extern int _blacklist(int argc, char **argv);
 extern int _gnrc_pktbuf_cmd(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_PKTLATENCY
+extern int _gnrc_pktlatency(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_RPL
 extern int _gnrc_rpl(int argc, char **argv);
 #endif
@@ -230,6 +234,10 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_GNRC_PKTBUF_CMD
     {"pktbuf", "prints internal stats of the packet buffer", _gnrc_pktbuf_cmd },
 #endif
+#ifdef MODULE_GNRC_PKTLATENCY
+    {"pktlat", "per-thread packet latency statistics ('pktlat [reset]')",
+     _gnrc_pktlatency },
+#endif
 #ifdef MODULE_GNRC_RPL
     {"rpl", "rpl configuration tool ('rpl help' for more information)", _gnrc_rpl },
 #endif
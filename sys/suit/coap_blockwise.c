@@ -0,0 +1,469 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *               2019 Inria
+ *               2019 Kaspar Schleiser <kaspar@schleiser.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_suit
+ * @{
+ *
+ * @file
+ * @brief       SUIT CoAP windowed block-wise download
+ *
+ * Up to @ref SUIT_COAP_WINDOW_SIZE Block2 requests are kept in flight. Each
+ * request is retransmitted on its own, the received blocks are passed to the
+ * callback in order.
+ *
+ * The number of requests in flight starts at one and grows by one for every
+ * received block. It is halved on every retransmission. The block size is
+ * negotiated with the server: if the server answers with a smaller block,
+ * the rest of the block is requested and all further blocks are requested
+ * with the smaller size. A block that had to be retransmitted twice is
+ * requested with half the size, as smaller blocks need less link layer
+ * fragments on lossy links.
+ *
+ * @author      Koen Zandberg <koen@bergzand.net>
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "log.h"
+#include "net/nanocoap.h"
+#include "net/sock/udp.h"
+#include "net/sock/util.h"
+#include "random.h"
+#include "suit/coap.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* space for the CoAP header and options of a block response */
+#define HDR_MAX                 (64U)
+
+/* smallest block size the block size is reduced to on retransmissions */
+#define BLOCKSIZE_MIN           (COAP_BLOCKSIZE_32)
+
+#define BLOCK_LEN(szx)          (1U << ((szx) + 4))
+
+enum {
+    SLOT_FREE = 0,
+    SLOT_PENDING,
+    SLOT_DONE,
+};
+
+typedef struct {
+    size_t offset;      /**< offset of the first byte in the slot */
+    size_t len;         /**< number of bytes received */
+    size_t size;        /**< number of bytes the slot covers */
+    uint32_t deadline;  /**< retransmission deadline of the request */
+    uint32_t timeout;   /**< current retransmission timeout */
+    int more;           /**< block option more flag of the last response */
+    uint16_t id;        /**< message ID of the pending request */
+    uint8_t szx;        /**< block size of the pending request */
+    uint8_t tries;      /**< number of transmissions of the pending request */
+    uint8_t state;      /**< state of the slot */
+} _slot_t;
+
+typedef struct {
+    sock_udp_t sock;
+    const char *path;
+    uint8_t *buf;       /**< buffer for requests and responses */
+    size_t buf_len;
+    uint8_t *data;      /**< received data, one block per slot */
+    size_t next;        /**< offset of the next block to request */
+    size_t end;         /**< size of the resource, SIZE_MAX while unknown */
+    unsigned szx;       /**< block size for new requests */
+    unsigned window;    /**< number of requests allowed in flight */
+    unsigned inflight;  /**< number of requests in flight */
+    uint16_t id;        /**< next message ID */
+    _slot_t slots[SUIT_COAP_WINDOW_SIZE];
+} _download_t;
+
+static inline uint32_t _now(void)
+{
+    return xtimer_now_usec();
+}
+
+/* initial timeout of a request, random between ACK_TIMEOUT and
+ * (ACK_TIMEOUT * ACK_RANDOM_FACTOR) as in RFC 7252, section 4.8 */
+static uint32_t _ack_timeout(void)
+{
+    uint32_t timeout = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
+#if COAP_RANDOM_FACTOR_1000 > 1000
+    timeout = random_uint32_range(timeout, (uint32_t)COAP_ACK_TIMEOUT *
+                                           COAP_RANDOM_FACTOR_1000 * US_PER_MS);
+#endif
+    return timeout;
+}
+
+static inline uint8_t *_slot_data(_download_t *dl, _slot_t *slot)
+{
+    /* the slots are as large as the blocks initially requested */
+    return dl->data + (slot - dl->slots) * (dl->buf_len - HDR_MAX);
+}
+
+static int _send_request(_download_t *dl, _slot_t *slot)
+{
+    coap_hdr_t *hdr = (coap_hdr_t *)dl->buf;
+    uint8_t *pktpos = dl->buf;
+    size_t num = (slot->offset + slot->len) >> (slot->szx + 4);
+
+    pktpos += coap_build_hdr(hdr, COAP_TYPE_CON, NULL, 0, COAP_METHOD_GET,
+                             slot->id);
+    pktpos += coap_opt_put_uri_path(pktpos, 0, dl->path);
+    pktpos += coap_opt_put_uint(pktpos, COAP_OPT_URI_PATH, COAP_OPT_BLOCK2,
+                                (num << 4) | slot->szx);
+
+    DEBUG("suit_coap: requesting block %u (szx=%u, id=%u)\n", (unsigned)num,
+          slot->szx, slot->id);
+    slot->tries++;
+    slot->deadline = _now() + slot->timeout;
+    ssize_t res = sock_udp_send(&dl->sock, dl->buf, pktpos - dl->buf, NULL);
+    return (res < 0) ? (int)res : 0;
+}
+
+/* (re)starts the request for the missing part of a slot */
+static int _request(_download_t *dl, _slot_t *slot, unsigned szx)
+{
+    slot->timeout = _ack_timeout();
+    slot->tries = 0;
+    slot->szx = szx;
+    slot->id = dl->id++;
+    return _send_request(dl, slot);
+}
+
+static int _request_next(_download_t *dl, _slot_t *slot)
+{
+    slot->offset = dl->next;
+    slot->len = 0;
+    slot->size = BLOCK_LEN(dl->szx);
+    slot->state = SLOT_PENDING;
+    dl->next += slot->size;
+    dl->inflight++;
+    return _request(dl, slot, dl->szx);
+}
+
+static void _set_end(_download_t *dl, size_t end)
+{
+    if (end >= dl->end) {
+        return;
+    }
+    dl->end = end;
+    /* cancel the requests beyond the end of the resource */
+    for (unsigned i = 0; i < SUIT_COAP_WINDOW_SIZE; i++) {
+        _slot_t *slot = &dl->slots[i];
+        /* a received block at the very end is the (empty) last one */
+        if ((slot->state == SLOT_PENDING && slot->offset >= end) ||
+            (slot->state == SLOT_DONE && slot->offset > end)) {
+            if (slot->state == SLOT_PENDING) {
+                dl->inflight--;
+            }
+            slot->state = SLOT_FREE;
+        }
+    }
+}
+
+static _slot_t *_find_slot(_download_t *dl, uint8_t state)
+{
+    for (unsigned i = 0; i < SUIT_COAP_WINDOW_SIZE; i++) {
+        if (dl->slots[i].state == state) {
+            return &dl->slots[i];
+        }
+    }
+    return NULL;
+}
+
+static int _handle_timeouts(_download_t *dl)
+{
+    uint32_t now = _now();
+
+    for (unsigned i = 0; i < SUIT_COAP_WINDOW_SIZE; i++) {
+        _slot_t *slot = &dl->slots[i];
+        if ((slot->state != SLOT_PENDING) ||
+            ((int32_t)(slot->deadline - now) > 0)) {
+            continue;
+        }
+        if (slot->tries > COAP_MAX_RETRANSMIT) {
+            DEBUG("suit_coap: maximum retries reached\n");
+            return -ETIMEDOUT;
+        }
+        DEBUG("suit_coap: timeout for offset %u\n", (unsigned)slot->offset);
+        dl->window = (dl->window > 1) ? dl->window / 2 : 1;
+
+        int res;
+        if ((slot->tries >= 2) && (slot->szx > BLOCKSIZE_MIN)) {
+            /* try with smaller blocks, this needs a new message ID */
+            if (dl->szx >= slot->szx) {
+                dl->szx = slot->szx - 1;
+            }
+            res = _request(dl, slot, slot->szx - 1);
+        }
+        else {
+            slot->timeout *= 2;
+            res = _send_request(dl, slot);
+        }
+        if (res < 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static int _handle_response(_download_t *dl, size_t len)
+{
+    coap_pkt_t pkt;
+
+    if (coap_parse(&pkt, dl->buf, len) < 0) {
+        DEBUG("suit_coap: error parsing packet\n");
+        return 0;
+    }
+
+    _slot_t *slot = NULL;
+    for (unsigned i = 0; i < SUIT_COAP_WINDOW_SIZE; i++) {
+        if ((dl->slots[i].state == SLOT_PENDING) &&
+            (dl->slots[i].id == coap_get_id(&pkt))) {
+            slot = &dl->slots[i];
+            break;
+        }
+    }
+    if ((slot == NULL) || (coap_get_code_raw(&pkt) == COAP_CODE_EMPTY)) {
+        /* duplicate, late or empty response */
+        return 0;
+    }
+
+    unsigned code = coap_get_code(&pkt);
+    if (code != 205) {
+        DEBUG("suit_coap: code=%u for offset %u\n", code,
+              (unsigned)slot->offset);
+        if ((slot->offset > 0) && (slot->len == 0)) {
+            /* the resource ends before this block */
+            _set_end(dl, slot->offset);
+            return 0;
+        }
+        return -1;
+    }
+
+    coap_block1_t block2;
+    coap_get_block2(&pkt, &block2);
+    if (block2.more == -1) {
+        /* no block option, the resource fits into a single response */
+        block2.offset = 0;
+        block2.szx = slot->szx;
+    }
+    if ((block2.offset != slot->offset + slot->len) ||
+        (pkt.payload_len > slot->size - slot->len)) {
+        DEBUG("suit_coap: unexpected block at offset %u\n",
+              (unsigned)block2.offset);
+        return -1;
+    }
+
+    memcpy(_slot_data(dl, slot) + slot->len, pkt.payload, pkt.payload_len);
+    slot->len += pkt.payload_len;
+    slot->more = block2.more;
+
+    if (block2.szx < dl->szx) {
+        /* the server prefers smaller blocks */
+        dl->szx = block2.szx;
+    }
+    if ((block2.more == 1) && (slot->len < slot->size)) {
+        /* got a smaller block than requested, fetch the rest of the slot */
+        return _request(dl, slot, block2.szx);
+    }
+
+    slot->state = SLOT_DONE;
+    dl->inflight--;
+    if (dl->window < SUIT_COAP_WINDOW_SIZE) {
+        dl->window++;
+    }
+    if (block2.more != 1) {
+        _set_end(dl, slot->offset + slot->len);
+    }
+    return 0;
+}
+
+/* passes the received slots to the callback in order, returns 1 after the
+ * last block */
+static int _deliver(_download_t *dl, size_t *offset,
+                    coap_blockwise_cb_t callback, void *arg)
+{
+    for (;;) {
+        _slot_t *slot = NULL;
+        for (unsigned i = 0; i < SUIT_COAP_WINDOW_SIZE; i++) {
+            if ((dl->slots[i].state == SLOT_DONE) &&
+                (dl->slots[i].offset == *offset)) {
+                slot = &dl->slots[i];
+                break;
+            }
+        }
+        if (slot == NULL) {
+            /* the resource ended before all blocks were received */
+            return (*offset >= dl->end) ? -1 : 0;
+        }
+
+        int more = slot->more;
+        if (callback(arg, slot->offset, _slot_data(dl, slot), slot->len,
+                     more)) {
+            DEBUG("callback res != 0, aborting.\n");
+            return -1;
+        }
+        *offset += slot->len;
+        slot->state = SLOT_FREE;
+        if (more != 1) {
+            return 1;
+        }
+    }
+}
+
+int suit_coap_get_blockwise(sock_udp_ep_t *remote, const char *path,
+                            coap_blksize_t blksize,
+                            coap_blockwise_cb_t callback, void *arg)
+{
+    /* mmmmh dynamically sized arrays */
+    uint8_t buf[HDR_MAX + BLOCK_LEN(blksize)];
+    uint8_t data[SUIT_COAP_WINDOW_SIZE * BLOCK_LEN(blksize)];
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    _download_t dl;
+
+    memset(&dl, 0, sizeof(dl));
+    dl.path = path;
+    dl.buf = buf;
+    dl.buf_len = sizeof(buf);
+    dl.data = data;
+    dl.end = SIZE_MAX;
+    dl.szx = blksize;
+    dl.window = 1;
+    dl.id = (uint16_t)_now();
+
+    /* HACK: use random local port */
+    local.port = 0x8000 + (xtimer_now_usec() % 0XFFF);
+
+    int res = sock_udp_create(&dl.sock, &local, remote, 0);
+    if (res < 0) {
+        return res;
+    }
+
+    size_t offset = 0;
+    res = 0;
+    while (res == 0) {
+        _slot_t *slot;
+        while ((dl.inflight < dl.window) && (dl.next < dl.end) &&
+               ((slot = _find_slot(&dl, SLOT_FREE)) != NULL)) {
+            if ((res = _request_next(&dl, slot)) < 0) {
+                DEBUG("suit_coap: error sending coap request, %d\n", res);
+                goto out;
+            }
+        }
+
+        if (dl.inflight == 0) {
+            /* nothing left to wait for */
+            res = -1;
+            break;
+        }
+
+        /* wait for a response until the next retransmission is due */
+        uint32_t timeout = UINT32_MAX;
+        uint32_t now = _now();
+        for (unsigned i = 0; i < SUIT_COAP_WINDOW_SIZE; i++) {
+            if (dl.slots[i].state == SLOT_PENDING) {
+                int32_t left = (int32_t)(dl.slots[i].deadline - now);
+                left = (left < 0) ? 0 : left;
+                if ((uint32_t)left < timeout) {
+                    timeout = left;
+                }
+            }
+        }
+
+        ssize_t len = sock_udp_recv(&dl.sock, buf, sizeof(buf), timeout,
+                                    NULL);
+        if ((len == -ETIMEDOUT) || (len == -EAGAIN)) {
+            res = _handle_timeouts(&dl);
+        }
+        else if (len < 0) {
+            DEBUG("suit_coap: error receiving coap response, %d\n", (int)len);
+            res = len;
+        }
+        else if ((res = _handle_response(&dl, len)) == 0) {
+            res = _deliver(&dl, &offset, callback, arg);
+        }
+    }
+
+out:
+    sock_udp_close(&dl.sock);
+    return (res == 1) ? 0 : -1;
+}
+int suit_coap_get_blockwise_url(const char *url,
+                               coap_blksize_t blksize,
+                               coap_blockwise_cb_t callback, void *arg)
+{
+    char hostport[CONFIG_SOCK_HOSTPORT_MAXLEN];
+    char urlpath[CONFIG_SOCK_URLPATH_MAXLEN];
+    sock_udp_ep_t remote;
+
+    if (strncmp(url, "coap://", 7)) {
+        LOG_INFO("suit: URL doesn't start with \"coap://\"\n");
+        return -EINVAL;
+    }
+
+    if (sock_urlsplit(url, hostport, urlpath) < 0) {
+        LOG_INFO("suit: invalid URL\n");
+        return -EINVAL;
+    }
+
+    if (sock_udp_str2ep(&remote, hostport) < 0) {
+        LOG_INFO("suit: invalid URL\n");
+        return -EINVAL;
+    }
+
+    if (!remote.port) {
+        remote.port = COAP_PORT;
+    }
+
+    return suit_coap_get_blockwise(&remote, urlpath, blksize, callback, arg);
+}
+
+typedef struct {
+    size_t offset;
+    uint8_t *ptr;
+    size_t len;
+} _buf_t;
+
+static int _2buf(void *arg, size_t offset, uint8_t *buf, size_t len, int more)
+{
+    (void)more;
+
+    _buf_t *_buf = arg;
+    if (_buf->offset != offset) {
+        return 0;
+    }
+    if (len > _buf->len) {
+        return -1;
+    }
+    else {
+        memcpy(_buf->ptr, buf, len);
+        _buf->offset += len;
+        _buf->ptr += len;
+        _buf->len -= len;
+        return 0;
+    }
+}
+
+ssize_t suit_coap_get_blockwise_url_buf(const char *url,
+                               coap_blksize_t blksize,
+                               uint8_t *buf, size_t len)
+{
+    _buf_t _buf = { .ptr=buf, .len=len };
+    int res = suit_coap_get_blockwise_url(url, blksize, _2buf, &_buf);
+    return (res < 0) ? (ssize_t)res : (ssize_t)_buf.offset;
+}
+
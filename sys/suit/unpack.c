@@ -0,0 +1,370 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_suit_unpack
+ * @{
+ *
+ * @file
+ * @brief       SUIT payload decompression and delta patching
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "suit/unpack.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define DELTA_MAGIC         "ENDSLEY/BSDIFF43"
+#define DELTA_MAGIC_LEN     (sizeof(DELTA_MAGIC) - 1)
+#define DELTA_HDR_LEN       (DELTA_MAGIC_LEN + 8)
+#define DELTA_CTRL_LEN      (3 * 8)
+/* limit for image size and source position, keeps the arithmetic in range */
+#define DELTA_POS_MAX       (INT32_MAX / 2)
+
+enum {
+    PATCH_HEADER,
+    PATCH_CTRL,
+    PATCH_DIFF,
+    PATCH_EXTRA,
+};
+
+/* passes the collected unpacked data to the sink */
+static int _flush(suit_unpack_t *unpack, bool more)
+{
+    int res = unpack->sink(unpack->arg, unpack->out_offset, unpack->buf,
+                           unpack->buf_len, more);
+
+    unpack->out_offset += unpack->buf_len;
+    unpack->buf_len = 0;
+    return res;
+}
+
+static int _output(suit_unpack_t *unpack, const uint8_t *buf, size_t len)
+{
+    while (len) {
+        size_t n = sizeof(unpack->buf) - unpack->buf_len;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(unpack->buf + unpack->buf_len, buf, n);
+        unpack->buf_len += n;
+        buf += n;
+        len -= n;
+        if (unpack->buf_len == sizeof(unpack->buf)) {
+            int res = _flush(unpack, true);
+            if (res < 0) {
+                return res;
+            }
+        }
+    }
+    return 0;
+}
+
+#ifdef MODULE_SUIT_UNPACK_DELTA
+/* decodes the sign-magnitude little endian integers of bsdiff */
+static int _offtin(const uint8_t *buf, int32_t *out)
+{
+    uint32_t val = buf[0] | (buf[1] << 8) | (buf[2] << 16) |
+                   ((uint32_t)buf[3] << 24);
+
+    /* only the sign bit may be set in the upper half */
+    if ((val > INT32_MAX) || buf[4] || buf[5] || buf[6] || (buf[7] & 0x7f)) {
+        return -EBADMSG;
+    }
+    *out = (buf[7] & 0x80) ? -(int32_t)val : (int32_t)val;
+    return 0;
+}
+
+static int _patch_ctrl(suit_unpack_t *unpack)
+{
+    int32_t diff_len, extra_len;
+
+    if (unpack->patch_state == PATCH_HEADER) {
+        int32_t new_len;
+        if (memcmp(unpack->ctrl, DELTA_MAGIC, DELTA_MAGIC_LEN) ||
+            _offtin(unpack->ctrl + DELTA_MAGIC_LEN, &new_len) ||
+            (new_len < 0) || (new_len > DELTA_POS_MAX)) {
+            DEBUG("suit_unpack: invalid delta header\n");
+            return -EBADMSG;
+        }
+        unpack->new_len = new_len;
+        unpack->patch_state = PATCH_CTRL;
+        return 0;
+    }
+
+    if (_offtin(unpack->ctrl, &diff_len) ||
+        _offtin(unpack->ctrl + 8, &extra_len) ||
+        _offtin(unpack->ctrl + 16, &unpack->seek) ||
+        (diff_len < 0) || (extra_len < 0)) {
+        return -EBADMSG;
+    }
+    /* the data following this block must fit into the new image */
+    size_t pos = unpack->out_offset + unpack->buf_len;
+    if ((size_t)diff_len + (size_t)extra_len > unpack->new_len - pos) {
+        DEBUG("suit_unpack: delta exceeds image size\n");
+        return -EBADMSG;
+    }
+    unpack->left = diff_len;
+    unpack->extra_len = extra_len;
+    unpack->patch_state = PATCH_DIFF;
+    return 0;
+}
+
+/* advances to the next part of the current block once a part is done */
+static int _patch_next(suit_unpack_t *unpack)
+{
+    while ((unpack->left == 0) &&
+           ((unpack->patch_state == PATCH_DIFF) ||
+            (unpack->patch_state == PATCH_EXTRA))) {
+        if (unpack->patch_state == PATCH_DIFF) {
+            unpack->left = unpack->extra_len;
+            unpack->patch_state = PATCH_EXTRA;
+        }
+        else {
+            int64_t pos = (int64_t)unpack->src_pos + unpack->seek;
+            if ((pos > DELTA_POS_MAX) || (pos < -DELTA_POS_MAX)) {
+                return -EBADMSG;
+            }
+            unpack->src_pos = pos;
+            unpack->patch_state = PATCH_CTRL;
+        }
+    }
+    return 0;
+}
+
+static int _patch(suit_unpack_t *unpack, const uint8_t *buf, size_t len)
+{
+    while (len) {
+        int res = _patch_next(unpack);
+        if (res < 0) {
+            return res;
+        }
+        switch (unpack->patch_state) {
+            case PATCH_HEADER:
+            case PATCH_CTRL: {
+                size_t need = ((unpack->patch_state == PATCH_HEADER)
+                               ? DELTA_HDR_LEN : DELTA_CTRL_LEN)
+                              - unpack->ctrl_len;
+                size_t n = (len < need) ? len : need;
+                memcpy(unpack->ctrl + unpack->ctrl_len, buf, n);
+                unpack->ctrl_len += n;
+                buf += n;
+                len -= n;
+                if (n == need) {
+                    unpack->ctrl_len = 0;
+                    res = _patch_ctrl(unpack);
+                    if (res < 0) {
+                        return res;
+                    }
+                }
+                break;
+            }
+            case PATCH_DIFF: {
+                /* add the source bytes to the diff bytes, like bspatch,
+                 * positions outside of the source image count as zero */
+                uint8_t tmp[16];
+                size_t n = (len < unpack->left) ? len : unpack->left;
+                if (n > sizeof(tmp)) {
+                    n = sizeof(tmp);
+                }
+                for (size_t i = 0; i < n; i++, unpack->src_pos++) {
+                    tmp[i] = buf[i];
+                    if ((unpack->src_pos >= 0) &&
+                        ((size_t)unpack->src_pos < unpack->src_len)) {
+                        tmp[i] += unpack->src[unpack->src_pos];
+                    }
+                }
+                res = _output(unpack, tmp, n);
+                if (res < 0) {
+                    return res;
+                }
+                buf += n;
+                len -= n;
+                unpack->left -= n;
+                break;
+            }
+            case PATCH_EXTRA: {
+                size_t n = (len < unpack->left) ? len : unpack->left;
+                res = _output(unpack, buf, n);
+                if (res < 0) {
+                    return res;
+                }
+                buf += n;
+                len -= n;
+                unpack->left -= n;
+                break;
+            }
+        }
+    }
+    return _patch_next(unpack);
+}
+
+static int _patch_finish(suit_unpack_t *unpack)
+{
+    if ((unpack->patch_state != PATCH_CTRL) || unpack->ctrl_len ||
+        (unpack->out_offset + unpack->buf_len != unpack->new_len)) {
+        DEBUG("suit_unpack: delta truncated\n");
+        return -EBADMSG;
+    }
+    return 0;
+}
+#endif /* MODULE_SUIT_UNPACK_DELTA */
+
+/* second stage: applies the delta patch, if any */
+static int _unpack(suit_unpack_t *unpack, const uint8_t *buf, size_t len)
+{
+#ifdef MODULE_SUIT_UNPACK_DELTA
+    if (unpack->delta) {
+        return _patch(unpack, buf, len);
+    }
+#endif
+    return _output(unpack, buf, len);
+}
+
+#ifdef MODULE_SUIT_UNPACK_HEATSHRINK
+static int _poll(suit_unpack_t *unpack)
+{
+    uint8_t tmp[SUIT_UNPACK_BUF_SIZE];
+    HSD_poll_res pres;
+
+    do {
+        size_t n = 0;
+        pres = heatshrink_decoder_poll(&unpack->hsd, tmp, sizeof(tmp), &n);
+        if (pres < 0) {
+            return -EBADMSG;
+        }
+        int res = _unpack(unpack, tmp, n);
+        if (res < 0) {
+            return res;
+        }
+    } while (pres == HSDR_POLL_MORE);
+
+    return 0;
+}
+
+/* first stage: decompresses the payload */
+static int _decompress(suit_unpack_t *unpack, const uint8_t *buf, size_t len,
+                       bool more)
+{
+    while (len) {
+        size_t n = 0;
+        /* heatshrink does not modify the input */
+        if (heatshrink_decoder_sink(&unpack->hsd, (uint8_t *)buf, len, &n) < 0) {
+            return -EBADMSG;
+        }
+        buf += n;
+        len -= n;
+        int res = _poll(unpack);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    if (!more) {
+        HSD_finish_res fres;
+        while ((fres = heatshrink_decoder_finish(&unpack->hsd)) == HSDR_FINISH_MORE) {
+            int res = _poll(unpack);
+            if (res < 0) {
+                return res;
+            }
+        }
+        if (fres != HSDR_FINISH_DONE) {
+            return -EBADMSG;
+        }
+    }
+    return 0;
+}
+#endif /* MODULE_SUIT_UNPACK_HEATSHRINK */
+
+int suit_unpack_init(suit_unpack_t *unpack, int compression, int algorithm,
+                     const uint8_t *src, size_t src_len,
+                     suit_unpack_sink_t sink, void *arg)
+{
+    memset(unpack, 0, sizeof(*unpack));
+    unpack->sink = sink;
+    unpack->arg = arg;
+
+    switch (compression) {
+        case SUIT_COMPRESSION_NONE:
+            break;
+#ifdef MODULE_SUIT_UNPACK_HEATSHRINK
+        case SUIT_COMPRESSION_HEATSHRINK:
+            heatshrink_decoder_reset(&unpack->hsd);
+            unpack->compression = 1;
+            break;
+#endif
+        default:
+            DEBUG("suit_unpack: unsupported compression %d\n", compression);
+            return -ENOTSUP;
+    }
+
+    switch (algorithm) {
+        case SUIT_UNPACK_NONE:
+            break;
+#ifdef MODULE_SUIT_UNPACK_DELTA
+        case SUIT_UNPACK_DELTA:
+            unpack->src = src;
+            unpack->src_len = src_len;
+            unpack->patch_state = PATCH_HEADER;
+            unpack->delta = 1;
+            break;
+#endif
+        default:
+            DEBUG("suit_unpack: unsupported algorithm %d\n", algorithm);
+            return -ENOTSUP;
+    }
+    (void)src;
+    (void)src_len;
+
+    return 0;
+}
+
+int suit_unpack_putbytes(suit_unpack_t *unpack, size_t offset,
+                         const uint8_t *buf, size_t len, bool more)
+{
+    int res;
+
+    if (offset != unpack->in_offset) {
+        DEBUG("suit_unpack: expected offset %u, got %u\n",
+              (unsigned)unpack->in_offset, (unsigned)offset);
+        return -EINVAL;
+    }
+    unpack->in_offset += len;
+
+    if (!unpack->compression && !unpack->delta) {
+        /* nothing to do, hand the data over without copying it */
+        res = unpack->sink(unpack->arg, offset, buf, len, more);
+        unpack->out_offset = unpack->in_offset;
+        return res;
+    }
+
+#ifdef MODULE_SUIT_UNPACK_HEATSHRINK
+    if (unpack->compression) {
+        res = _decompress(unpack, buf, len, more);
+    }
+    else
+#endif
+    {
+        res = _unpack(unpack, buf, len);
+    }
+    if ((res < 0) || more) {
+        return res;
+    }
+
+#ifdef MODULE_SUIT_UNPACK_DELTA
+    if (unpack->delta && (res = _patch_finish(unpack)) < 0) {
+        return res;
+    }
+#endif
+    return _flush(unpack, false);
+}
@@ -155,6 +155,45 @@ static int _param_get_img_size(suit_v4_manifest_t *manifest, nanocbor_value_t *i
     return res;
 }
 
+/* gets the algorithm of a compression-info or unpack-info parameter, a byte
+ * string wrapping a map with the algorithm at key 1 */
+static int _param_get_algorithm(nanocbor_value_t *it, int32_t *algorithm)
+{
+    /* work on a copy, the caller skips the value */
+    nanocbor_value_t value = *it;
+    nanocbor_value_t info, map;
+
+    if ((suit_cbor_subparse(&value, &info) < 0) ||
+        (nanocbor_enter_map(&info, &map) < 0)) {
+        return -1;
+    }
+    while (!nanocbor_at_end(&map)) {
+        int32_t info_key;
+        if (suit_cbor_get_int32(&map, &info_key)) {
+            return -1;
+        }
+        if (info_key == 1) {
+            return suit_cbor_get_int32(&map, algorithm);
+        }
+        nanocbor_skip(&map);
+    }
+    return -1;
+}
+
+static int _param_get_compression_info(suit_v4_manifest_t *manifest, nanocbor_value_t *it)
+{
+    LOG_DEBUG("got compression info\n");
+    return _param_get_algorithm(it,
+            &manifest->components[manifest->component_current].compression);
+}
+
+static int _param_get_unpack_info(suit_v4_manifest_t *manifest, nanocbor_value_t *it)
+{
+    LOG_DEBUG("got unpack info\n");
+    return _param_get_algorithm(it,
+            &manifest->components[manifest->component_current].unpack);
+}
+
 static int _dtv_set_param(suit_v4_manifest_t *manifest, int key, nanocbor_value_t *it)
 {
     (void)key;
@@ -174,6 +213,12 @@ static int _dtv_set_param(suit_v4_manifest_t *manifest, int key, nanocbor_value_
             case 6: /* SUIT URI LIST */
                 res = _param_get_uri_list(manifest, &map);
                 break;
+            case 8: /* SUIT COMPRESSION INFO */
+                res = _param_get_compression_info(manifest, &map);
+                break;
+            case 9: /* SUIT UNPACK INFO */
+                res = _param_get_unpack_info(manifest, &map);
+                break;
             case 11: /* SUIT DIGEST */
                 res = _param_get_digest(manifest, &map);
                 break;
@@ -262,6 +307,24 @@ static int _dtv_fetch(suit_v4_manifest_t *manifest, int key, nanocbor_value_t *_
 
     int target_slot = riotboot_slot_other();
     riotboot_flashwrite_init(manifest->writer, target_slot);
+
+    const suit_v4_component_t *comp = &manifest->components[0];
+#ifdef MODULE_SUIT_UNPACK
+    /* delta patches apply to the running image */
+    int current_slot = riotboot_slot_current();
+    if (suit_unpack_init(manifest->unpack, comp->compression, comp->unpack,
+                         (const uint8_t *)riotboot_slot_get_hdr(current_slot),
+                         riotboot_slot_size(current_slot),
+                         suit_flashwrite_sink, manifest) < 0) {
+        LOG_INFO("unsupported payload compression or unpack algorithm\n");
+        return SUIT_ERR_UNSUPPORTED;
+    }
+#else
+    if (comp->compression || comp->unpack) {
+        LOG_INFO("payload compression and unpacking need suit_unpack\n");
+        return SUIT_ERR_UNSUPPORTED;
+    }
+#endif
     int res = suit_coap_get_blockwise_url(manifest->urlbuf, COAP_BLOCKSIZE_64, suit_flashwrite_helper,
             manifest);
 
@@ -279,10 +342,11 @@ static int _dtv_fetch(suit_v4_manifest_t *manifest, int key, nanocbor_value_t *_
     }
 
     /* "digest" points to a 36 byte string that includes the digest type.
-     * riotboot_flashwrite_verify_sha256() is only interested in the 32b digest,
-     * so shift the pointer accordingly.
+     * riotboot_flashwrite_verify_sha256_stream() is only interested in the 32b
+     * digest, so shift the pointer accordingly.
      */
-    res = riotboot_flashwrite_verify_sha256(digest + 4, manifest->components[0].size, target_slot);
+    res = riotboot_flashwrite_verify_sha256_stream(manifest->writer, digest + 4,
+                                                   manifest->components[0].size);
     if (res) {
         LOG_INFO("image verification failed\n");
         return res;
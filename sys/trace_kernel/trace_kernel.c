@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_trace_kernel
+ * @{
+ *
+ * @file
+ * @brief       Kernel event tracer implementation
+ *
+ * @}
+ */
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "msg.h"
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "trace_kernel.h"
+
+#define _MASK   (TRACE_KERNEL_BUFFER_SIZE - 1)
+
+volatile bool trace_kernel_running;
+
+static trace_kernel_event_t _buf[TRACE_KERNEL_BUFFER_SIZE];
+/* total number of reserved slots, wraps at 2^32 which is a multiple of the
+ * buffer size */
+static atomic_uint_least32_t _head = ATOMIC_VAR_INIT(0);
+/* number of reserved slots at the time of the last clear */
+static uint32_t _tail;
+
+void trace_kernel_record_event(trace_kernel_type_t type, uint16_t arg16,
+                               uint32_t arg)
+{
+    uint32_t time = TRACE_KERNEL_TIMESTAMP();
+    /* reserve a slot. An ISR preempting us reserves and fills the next one,
+     * so the events of a buffer may be slightly out of order w.r.t. their
+     * timestamps */
+    uint32_t slot = atomic_fetch_add_explicit(&_head, 1, memory_order_relaxed);
+    trace_kernel_event_t *ev = &_buf[slot & _MASK];
+
+    ev->time = time;
+    ev->type = type;
+    /* not KERNEL_PID_ISR when in interrupt context: sched_run() may run in
+     * an ISR (e.g. PendSV on Cortex-M), and TRACE_KERNEL_SCHED needs the
+     * thread switched away from */
+    ev->pid = thread_getpid();
+    ev->arg16 = arg16;
+    ev->arg = arg;
+}
+
+void trace_kernel_init(void)
+{
+    trace_kernel_clear();
+    if (TRACE_KERNEL_AUTOSTART) {
+        trace_kernel_start();
+    }
+}
+
+void trace_kernel_clear(void)
+{
+    _tail = atomic_load_explicit(&_head, memory_order_relaxed);
+}
+
+static uint32_t _available(uint32_t head)
+{
+    uint32_t num = head - _tail;
+
+    return (num > TRACE_KERNEL_BUFFER_SIZE) ? TRACE_KERNEL_BUFFER_SIZE : num;
+}
+
+size_t trace_kernel_read(trace_kernel_event_t *events, size_t max_events)
+{
+    uint32_t head = atomic_load_explicit(&_head, memory_order_relaxed);
+    uint32_t num = _available(head);
+    uint32_t start = head - num;
+
+    if (num > max_events) {
+        num = max_events;
+    }
+    for (uint32_t i = 0; i < num; i++) {
+        events[i] = _buf[(start + i) & _MASK];
+    }
+    return num;
+}
+
+uint32_t trace_kernel_lost(void)
+{
+    uint32_t head = atomic_load_explicit(&_head, memory_order_relaxed);
+
+    return (head - _tail) - _available(head);
+}
+
+#ifdef CPU_NATIVE
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "native_internal.h"
+
+/* all events of the dump are shown as one process */
+#define _JSON_PID       (0)
+/* track for ISRs, thread tracks use their PID */
+#define _JSON_TID_ISR   (KERNEL_PID_ISR)
+
+typedef struct {
+    int fd;
+    int res;
+    bool first;
+} _json_t;
+
+static void _json_printf(_json_t *json, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void _json_printf(_json_t *json, const char *fmt, ...)
+{
+    char line[160];
+    va_list args;
+    int len;
+
+    if (json->res < 0) {
+        return;
+    }
+    va_start(args, fmt);
+    len = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if ((len < 0) || ((size_t)len >= sizeof(line))) {
+        json->res = -EOVERFLOW;
+    }
+    else if (real_write(json->fd, line, len) != len) {
+        json->res = -errno;
+    }
+}
+
+/* starts a new entry in the traceEvents array */
+static void _json_sep(_json_t *json)
+{
+    _json_printf(json, "%s\n", (json->first) ? "" : ",");
+    json->first = false;
+}
+
+static void _json_thread_name(_json_t *json, unsigned tid, const char *name)
+{
+    _json_sep(json);
+    _json_printf(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,"
+                 "\"tid\":%u,\"args\":{\"name\":\"%s\"}}", _JSON_PID, tid,
+                 name);
+}
+
+static void _json_slice(_json_t *json, unsigned tid, const char *name,
+                        uint64_t start, uint64_t end)
+{
+    _json_sep(json);
+    _json_printf(json, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,"
+                 "\"ts\":%" PRIu64 ",\"dur\":%" PRIu64 "}", name, _JSON_PID,
+                 tid, start, end - start);
+}
+
+static void _json_instant(_json_t *json, unsigned tid, const char *name,
+                          uint64_t ts, const char *arg_name, uint32_t arg)
+{
+    _json_sep(json);
+    _json_printf(json, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%u,"
+                 "\"tid\":%u,\"ts\":%" PRIu64 ",\"args\":{\"%s\":\"0x%"
+                 PRIx32 "\"}}", name, _JSON_PID, tid, ts, arg_name, arg);
+}
+
+static uint64_t _to_usec(uint64_t ticks)
+{
+    return (ticks * US_PER_SEC) / TRACE_KERNEL_TIMESTAMP_HZ;
+}
+
+int trace_kernel_dump_json(const char *path)
+{
+    static const char *_names[] = {
+        [TRACE_KERNEL_MSG_SEND] = "msg_send",
+        [TRACE_KERNEL_MSG_RECV] = "msg_receive",
+        [TRACE_KERNEL_MUTEX_WAIT] = "mutex_wait",
+        [TRACE_KERNEL_MUTEX_LOCK] = "mutex_lock",
+        [TRACE_KERNEL_MUTEX_UNLOCK] = "mutex_unlock",
+    };
+    _json_t json = { .first = true };
+    uint32_t head = atomic_load_explicit(&_head, memory_order_relaxed);
+    uint32_t num = _available(head);
+    uint32_t start = head - num;
+    /* 64-bit time line to unwrap the 32-bit timestamps */
+    uint64_t now = 0, slice_start = 0, isr_start = 0;
+    uint32_t last = 0;
+    int cur = -1;
+    bool in_isr = false;
+
+    json.fd = real_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (json.fd < 0) {
+        return -errno;
+    }
+    _json_printf(&json, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        const char *name = thread_getname(pid);
+        char tmp[sizeof("pid -32768")];
+
+        if (sched_threads[pid] == NULL) {
+            continue;
+        }
+        if (name == NULL) {
+            snprintf(tmp, sizeof(tmp), "pid %u", (unsigned)pid);
+            name = tmp;
+        }
+        _json_thread_name(&json, pid, name);
+    }
+    _json_thread_name(&json, _JSON_TID_ISR, "ISR");
+    for (uint32_t i = 0; i < num; i++) {
+        const trace_kernel_event_t *ev = &_buf[(start + i) & _MASK];
+
+        if (i > 0) {
+            /* events may be slightly out of order (see
+             * trace_kernel_record_event()), so only ever move forward */
+            int32_t diff = (int32_t)(ev->time - last);
+
+            if (diff > 0) {
+                now += diff;
+                last = ev->time;
+            }
+        }
+        else {
+            last = ev->time;
+        }
+        switch (ev->type) {
+            case TRACE_KERNEL_SCHED:
+                if (cur >= 0) {
+                    _json_slice(&json, cur, "running", _to_usec(slice_start),
+                                _to_usec(now));
+                }
+                cur = ev->arg;
+                slice_start = now;
+                break;
+            case TRACE_KERNEL_ISR_ENTER:
+                in_isr = true;
+                isr_start = now;
+                break;
+            case TRACE_KERNEL_ISR_EXIT:
+                if (in_isr) {
+                    char name[sizeof("irq 4294967295")];
+
+                    snprintf(name, sizeof(name), "irq %" PRIu32, ev->arg);
+                    _json_slice(&json, _JSON_TID_ISR, name,
+                                _to_usec(isr_start), _to_usec(now));
+                }
+                in_isr = false;
+                break;
+            case TRACE_KERNEL_MSG_SEND:
+            case TRACE_KERNEL_MSG_RECV:
+            {
+                char name[sizeof("msg_receive 0xffff")];
+
+                snprintf(name, sizeof(name), "%s 0x%04x", _names[ev->type],
+                         (unsigned)ev->arg16);
+                _json_instant(&json, (in_isr) ? _JSON_TID_ISR : ev->pid,
+                              name, _to_usec(now),
+                              (ev->type == TRACE_KERNEL_MSG_SEND) ? "to" : "from",
+                              ev->arg);
+                break;
+            }
+            case TRACE_KERNEL_MUTEX_WAIT:
+            case TRACE_KERNEL_MUTEX_LOCK:
+            case TRACE_KERNEL_MUTEX_UNLOCK:
+                _json_instant(&json, (in_isr) ? _JSON_TID_ISR : ev->pid,
+                              _names[ev->type], _to_usec(now), "mutex",
+                              ev->arg);
+                break;
+            default:
+                break;
+        }
+    }
+    if (cur >= 0) {
+        _json_slice(&json, cur, "running", _to_usec(slice_start),
+                    _to_usec(now));
+    }
+    _json_printf(&json, "\n]}\n");
+    real_close(json.fd);
+    return (json.res < 0) ? json.res : (int)num;
+}
+#endif /* CPU_NATIVE */
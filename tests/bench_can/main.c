@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure CAN reception throughput and latency
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "can/raw.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
+#endif
+
+/* frames sent back to back per sample */
+#ifndef BURST
+#define BURST               (256U)
+#endif
+
+/* pause between the bursts, for the bus to become idle */
+#ifndef BURST_PAUSE_US
+#define BURST_PAUSE_US      (100U * US_PER_MS)
+#endif
+
+#define BURSTS              (BENCHMARK_WARMUP_SAMPLES + BENCH_SAMPLES)
+#define FRAMES              (BURSTS * BURST)
+
+#define IFNUM_TX            (0)
+#define IFNUM_RX            (1)
+#define BENCH_CAN_ID        (0x123)
+#define RX_TIMEOUT_US       (US_PER_SEC)
+#define RX_QUEUE_SIZE       (64)
+#define TX_QUEUE_SIZE       (8)
+
+static char _tx_stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *_tx_thread(void *arg)
+{
+    msg_t queue[TX_QUEUE_SIZE];
+    struct can_frame frame = {
+        .can_id = BENCH_CAN_ID,
+        .can_dlc = 2 * sizeof(uint32_t),
+    };
+
+    (void)arg;
+    msg_init_queue(queue, TX_QUEUE_SIZE);
+
+    for (uint32_t seq = 0; seq < FRAMES; seq++) {
+        msg_t msg;
+
+        if ((seq % BURST) == 0) {
+            xtimer_usleep(BURST_PAUSE_US);
+        }
+
+        uint32_t now = benchmark_clock();
+        memcpy(&frame.data[0], &seq, sizeof(seq));
+        memcpy(&frame.data[sizeof(seq)], &now, sizeof(now));
+        while (raw_can_send(IFNUM_TX, &frame, thread_getpid()) < 0) {
+            /* out of packets, let the receiver catch up */
+            xtimer_usleep(100);
+        }
+        /* confirmations are not needed, only keep the queue empty */
+        while (msg_try_receive(&msg) == 1) {}
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t queue[RX_QUEUE_SIZE];
+    struct can_filter filter = {
+        .can_id = BENCH_CAN_ID,
+        .can_mask = CAN_SFF_MASK,
+    };
+    benchmark_result_t frame_res;
+    benchmark_result_t latency_res;
+    unsigned received = 0;
+    unsigned burst = 0;
+    unsigned burst_frames = 0;
+    uint32_t burst_start = 0;
+    uint32_t burst_latency = 0;
+
+    puts("CAN reception benchmark");
+
+    msg_init_queue(queue, RX_QUEUE_SIZE);
+    if (raw_can_subscribe_rx(IFNUM_RX, &filter, thread_getpid(), NULL) < 0) {
+        puts("raw_can_subscribe_rx() failed");
+        puts("[FAILED]");
+        return 1;
+    }
+
+    benchmark_result_init(&frame_res, "rx frame", BURST);
+    benchmark_result_init(&latency_res, "rx latency", 1);
+
+    thread_create(_tx_stack, sizeof(_tx_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, _tx_thread, NULL, "bench_can tx");
+
+    while (1) {
+        msg_t msg;
+
+        if (xtimer_msg_receive_timeout(&msg, RX_TIMEOUT_US) < 0) {
+            break;
+        }
+        if (msg.type != CAN_MSG_RX_INDICATION) {
+            continue;
+        }
+
+        uint32_t now = benchmark_clock();
+        can_rx_data_t *rx = msg.content.ptr;
+        struct can_frame *frame = rx->data.iov_base;
+        uint32_t seq;
+        uint32_t sent;
+
+        memcpy(&seq, &frame->data[0], sizeof(seq));
+        memcpy(&sent, &frame->data[sizeof(seq)], sizeof(sent));
+        raw_can_free_frame(rx);
+
+        if (seq / BURST != burst) {
+            /* frames of the last burst were lost */
+            burst = seq / BURST;
+            burst_frames = 0;
+        }
+        if (burst_frames == 0) {
+            burst_start = sent;
+            burst_latency = 0;
+        }
+        burst_frames++;
+        burst_latency += now - sent;
+        received++;
+
+        if ((seq % BURST) == (BURST - 1)) {
+            if (burst >= BENCHMARK_WARMUP_SAMPLES) {
+                benchmark_result_add(&frame_res, now - burst_start);
+                benchmark_result_add(&latency_res,
+                                     burst_latency / burst_frames);
+            }
+            burst++;
+            burst_frames = 0;
+        }
+        if (seq == FRAMES - 1) {
+            break;
+        }
+    }
+
+    benchmark_result_print(&frame_res);
+    benchmark_result_print(&latency_res);
+
+    uint32_t mean = benchmark_result_mean(&frame_res);
+    printf("received %u of %u frames, %" PRIu32 " frames/s\n",
+           received, FRAMES,
+           mean ? (uint32_t)(((uint64_t)BURST * BENCHMARK_CLOCK_HZ) / mean) : 0);
+    if (received != FRAMES) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run, BENCHMARK_REGEXP
+
+
+TIMEOUT = 30
+
+
+def testfunc(child):
+    child.expect_exact("CAN reception benchmark")
+    for func in ("rx frame", "rx latency"):
+        child.expect(BENCHMARK_REGEXP.format(func=func), timeout=TIMEOUT)
+    child.expect(r"received \d+ of \d+ frames, \d+ frames/s")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
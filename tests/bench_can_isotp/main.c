@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure ISO-TP throughput over concurrent channels
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "can/isotp.h"
+#include "msg.h"
+#include "net/gnrc/pktbuf.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
+#endif
+
+#ifndef CHANNELS
+#define CHANNELS            (2U)
+#endif
+
+/* bytes per transfer, 4095 is the maximum of ISO-TP */
+#ifndef PAYLOAD_SIZE
+#define PAYLOAD_SIZE        (4095U)
+#endif
+
+#ifndef BENCH_BS
+#define BENCH_BS            (0)
+#endif
+
+#ifndef BENCH_STMIN
+#define BENCH_STMIN         (0)
+#endif
+
+/* flow control set with isotp_set_fc() after the benchmark */
+#define CHECK_BS            (8U)
+#define CHECK_STMIN         (0xF1U)
+
+#define IFNUM_TX            (0)
+#define IFNUM_RX            (1)
+#define TX_ID_BASE          (0x700)
+#define RX_ID_BASE          (0x780)
+#define TIMEOUT_US          (10U * US_PER_SEC)
+#define QUEUE_SIZE          (16)
+
+typedef struct {
+    uint8_t channel;
+    uint8_t sample;
+} header_t;
+
+static struct isotp _tx[CHANNELS];
+static struct isotp _rx[CHANNELS];
+static header_t _header[CHANNELS];
+static iolist_t _iol[CHANNELS][2];
+static uint8_t _body[PAYLOAD_SIZE - sizeof(header_t)];
+
+static int _bind(struct isotp *isotp, int ifnum, canid_t tx_id, canid_t rx_id,
+                 struct isotp_fc_options *fc)
+{
+    can_reg_entry_t entry = {
+        .ifnum = ifnum,
+        .target.pid = thread_getpid(),
+    };
+#ifdef MODULE_CAN_MBOX
+    entry.type = CAN_TYPE_DEFAULT;
+#endif
+
+    memset(isotp, 0, sizeof(*isotp));
+    isotp->opt.tx_id = tx_id;
+    isotp->opt.rx_id = rx_id;
+    isotp->opt.txpad_content = CAN_ISOTP_DEFAULT_PAD_CONTENT;
+
+    return isotp_bind(isotp, &entry, isotp, fc);
+}
+
+static int _check(can_rx_data_t *rx, unsigned sample)
+{
+    gnrc_pktsnip_t *snip = rx->data.iov_base;
+    struct isotp *isotp = rx->arg;
+    unsigned c = isotp - _rx;
+    header_t *header = snip->data;
+    int res = 0;
+
+    if ((c >= CHANNELS) || (snip->size != PAYLOAD_SIZE) ||
+        (header->channel != c) || (header->sample != (uint8_t)sample) ||
+        memcmp(header + 1, _body, sizeof(_body))) {
+        res = -1;
+    }
+    isotp_free_rx(rx);
+
+    return res;
+}
+
+static int _transfer(unsigned sample)
+{
+    unsigned tx_done = 0;
+    unsigned rx_done = 0;
+
+    for (unsigned c = 0; c < CHANNELS; c++) {
+        _header[c].sample = sample;
+        if (isotp_send_iolist(&_tx[c], _iol[c], 0) != (int)PAYLOAD_SIZE) {
+            puts("isotp_send_iolist() failed");
+            return -1;
+        }
+    }
+
+    while ((tx_done < CHANNELS) || (rx_done < CHANNELS)) {
+        msg_t msg;
+
+        if (xtimer_msg_receive_timeout(&msg, TIMEOUT_US) < 0) {
+            puts("timeout");
+            return -1;
+        }
+        switch (msg.type) {
+        case CAN_MSG_TX_CONFIRMATION:
+            tx_done++;
+            break;
+        case CAN_MSG_RX_INDICATION:
+            if (_check(msg.content.ptr, sample) < 0) {
+                puts("data differs");
+                return -1;
+            }
+            rx_done++;
+            break;
+        default:
+            printf("unexpected msg 0x%x\n", msg.type);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int _sample(void *arg)
+{
+    unsigned *sample = arg;
+
+    return _transfer((*sample)++);
+}
+
+int main(void)
+{
+    msg_t queue[QUEUE_SIZE];
+    struct isotp_fc_options fc = {
+        .bs = BENCH_BS,
+        .stmin = BENCH_STMIN,
+    };
+    benchmark_result_t res;
+    unsigned sample = 0;
+
+    puts("ISO-TP throughput benchmark");
+    printf("%u channels, %u bytes per transfer, BS %u, STmin 0x%02x\n",
+           CHANNELS, PAYLOAD_SIZE, BENCH_BS, BENCH_STMIN);
+
+    msg_init_queue(queue, QUEUE_SIZE);
+
+    for (unsigned i = 0; i < sizeof(_body); i++) {
+        _body[i] = i * 7;
+    }
+
+    for (unsigned c = 0; c < CHANNELS; c++) {
+        if ((_bind(&_tx[c], IFNUM_TX, TX_ID_BASE + c, RX_ID_BASE + c,
+                   NULL) < 0) ||
+            (_bind(&_rx[c], IFNUM_RX, RX_ID_BASE + c, TX_ID_BASE + c,
+                   &fc) < 0)) {
+            puts("isotp_bind() failed");
+            puts("[FAILED]");
+            return 1;
+        }
+        /* the header is sent in place, followed by the shared body */
+        _header[c].channel = c;
+        _iol[c][0].iol_next = &_iol[c][1];
+        _iol[c][0].iol_base = &_header[c];
+        _iol[c][0].iol_len = sizeof(_header[c]);
+        _iol[c][1].iol_next = NULL;
+        _iol[c][1].iol_base = _body;
+        _iol[c][1].iol_len = sizeof(_body);
+    }
+
+    benchmark_result_init(&res, "isotp transfer", 1);
+    if (benchmark_run(&res, BENCH_SAMPLES, _sample, &sample) < 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    uint32_t mean = benchmark_result_mean(&res);
+    printf("%" PRIu32 " bytes/s\n",
+           mean ? (uint32_t)(((uint64_t)CHANNELS * PAYLOAD_SIZE *
+                              BENCHMARK_CLOCK_HZ) / mean) : 0);
+
+    /* the receivers announce a different flow control from now on, which the
+     * senders must follow */
+    fc.bs = CHECK_BS;
+    fc.stmin = CHECK_STMIN;
+    for (unsigned c = 0; c < CHANNELS; c++) {
+        isotp_set_fc(&_rx[c], &fc);
+    }
+    if (_transfer(0) < 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+    for (unsigned c = 0; c < CHANNELS; c++) {
+        if ((_tx[c].txfc.bs != CHECK_BS) || (_tx[c].txfc.stmin != CHECK_STMIN)) {
+            puts("flow control not applied");
+            puts("[FAILED]");
+            return 1;
+        }
+    }
+    printf("flow control changed to BS %u, STmin 0x%02x\n",
+           CHECK_BS, CHECK_STMIN);
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run, BENCHMARK_REGEXP
+
+
+TIMEOUT = 60
+
+
+def testfunc(child):
+    child.expect_exact("ISO-TP throughput benchmark")
+    child.expect(BENCHMARK_REGEXP.format(func="isotp transfer"),
+                 timeout=TIMEOUT)
+    child.expect(r"\d+ bytes/s")
+    child.expect(r"flow control changed to BS \d+, STmin 0x[0-9a-f]+")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the runtime of the CRC implementations
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "checksum/crc8.h"
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#include "checksum/ucrc16.h"
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
+#endif
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100UL)
+#endif
+
+#define BLOCK_SIZE          (512U)
+
+static uint8_t _block[BLOCK_SIZE];
+
+/* keeps the compiler from optimizing the calls away */
+static volatile uint32_t _res;
+
+/* bit-wise CRC-32, as it would be done without sys_checksum_crc32 */
+static uint32_t _crc32_bitwise(const uint8_t *buf, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+
+    while (len--) {
+        crc ^= *buf++;
+        for (unsigned i = 0; i < 8; i++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xedb88320) : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+static int _check(void)
+{
+    if (crc16_ccitt_update(0, _block, sizeof(_block)) !=
+        ucrc16_calc_be(_block, sizeof(_block), UCRC16_CCITT_POLY_BE, 0)) {
+        return -1;
+    }
+    if (crc16_ccitt_le_update(0, _block, sizeof(_block)) !=
+        ucrc16_calc_le(_block, sizeof(_block), UCRC16_CCITT_POLY_LE, 0)) {
+        return -1;
+    }
+    if (crc32_calc(_block, sizeof(_block)) !=
+        _crc32_bitwise(_block, sizeof(_block))) {
+        return -1;
+    }
+    /* unaligned start and odd length, as in the middle of a stream */
+    uint32_t crc = crc32_update(0, _block, 3);
+    crc = crc32_update(crc, _block + 3, sizeof(_block) - 8);
+    if (crc != _crc32_bitwise(_block, sizeof(_block) - 5)) {
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    printf("CRC benchmark, %u byte block, %u CRC-32 slice(s)\n", BLOCK_SIZE,
+           CONFIG_CHECKSUM_CRC32_SLICES);
+
+    for (unsigned i = 0; i < sizeof(_block); i++) {
+        _block[i] = i * 13 + (i >> 8);
+    }
+
+    if (_check() != 0) {
+        puts("results differ");
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("results ok");
+
+    BENCHMARK_SAMPLES("ucrc16_calc_be()", BENCH_SAMPLES, BENCH_RUNS,
+                      _res = ucrc16_calc_be(_block, sizeof(_block),
+                                            UCRC16_CCITT_POLY_BE, 0));
+    BENCHMARK_SAMPLES("crc16_ccitt_update()", BENCH_SAMPLES, BENCH_RUNS,
+                      _res = crc16_ccitt_update(0, _block, sizeof(_block)));
+    BENCHMARK_SAMPLES("ucrc16_calc_le()", BENCH_SAMPLES, BENCH_RUNS,
+                      _res = ucrc16_calc_le(_block, sizeof(_block),
+                                            UCRC16_CCITT_POLY_LE, 0));
+    BENCHMARK_SAMPLES("crc16_ccitt_le_update()", BENCH_SAMPLES, BENCH_RUNS,
+                      _res = crc16_ccitt_le_update(0, _block, sizeof(_block)));
+    BENCHMARK_SAMPLES("crc8()", BENCH_SAMPLES, BENCH_RUNS,
+                      _res = crc8(_block, sizeof(_block), 0x31, 0xff));
+    BENCHMARK_SAMPLES("CRC-32 bit-wise", BENCH_SAMPLES, BENCH_RUNS,
+                      _res = _crc32_bitwise(_block, sizeof(_block)));
+    BENCHMARK_SAMPLES("crc32_calc()", BENCH_SAMPLES, BENCH_RUNS,
+                      _res = crc32_calc(_block, sizeof(_block)));
+    BENCHMARK_SAMPLES("crc32c_calc()", BENCH_SAMPLES, BENCH_RUNS,
+                      _res = crc32c_calc(_block, sizeof(_block)));
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
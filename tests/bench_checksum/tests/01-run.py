@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run, BENCHMARK_REGEXP
+
+
+# The bit-wise implementations take a while on the slower boards
+TIMEOUT = 60
+
+
+def testfunc(child):
+    child.expect(r"CRC benchmark, \d+ byte block, \d+ CRC-32 slice\(s\)")
+    child.expect_exact("results ok")
+    for func in (r"ucrc16_calc_be\(\)", r"crc16_ccitt_update\(\)",
+                 r"ucrc16_calc_le\(\)", r"crc16_ccitt_le_update\(\)",
+                 r"crc8\(\)", r"CRC-32 bit-wise", r"crc32_calc\(\)",
+                 r"crc32c_calc\(\)"):
+        child.expect(BENCHMARK_REGEXP.format(func=func), timeout=TIMEOUT)
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test the lock-free queues and compare their latency to msg and mbox
+ *
+ * @}
+ */
+#include <cassert>
+#include <cstdio>
+#include <utility>
+
+#include "benchmark.h"
+#include "mbox.h"
+#include "msg.h"
+#include "thread.h"
+
+#include "riot/mpsc_queue.hpp"
+#include "riot/spsc_queue.hpp"
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
+#endif
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+#define QUEUE_SIZE          (8U)
+#define PRODUCER_ITEMS      (100U)
+
+using namespace riot;
+
+namespace {
+
+/* a move-only element type */
+class token {
+public:
+  explicit token(unsigned value = 0) : m_value{value} {}
+  token(token&& other) noexcept : m_value{other.m_value} { other.m_value = 0; }
+  token& operator=(token&& other) noexcept {
+    m_value = other.m_value;
+    other.m_value = 0;
+    return *this;
+  }
+  token(const token&) = delete;
+  token& operator=(const token&) = delete;
+
+  unsigned value() const { return m_value; }
+
+private:
+  unsigned m_value;
+};
+
+spsc_queue<token, QUEUE_SIZE> spsc;
+mpsc_queue<token, QUEUE_SIZE> mpsc;
+mpsc_queue<unsigned, QUEUE_SIZE> mpsc_bench;
+msg_t mbox_queue[QUEUE_SIZE];
+mbox_t mbox;
+
+char stacks[6][THREAD_STACKSIZE_DEFAULT];
+kernel_pid_t msg_pid;
+
+void* spsc_consumer(void*) {
+  for (;;) {
+    spsc.pop();
+  }
+  return nullptr;
+}
+
+void* mpsc_consumer(void*) {
+  for (;;) {
+    mpsc_bench.pop();
+  }
+  return nullptr;
+}
+
+void* msg_consumer(void*) {
+  msg_t msg;
+  for (;;) {
+    msg_receive(&msg);
+  }
+  return nullptr;
+}
+
+void* mbox_consumer(void*) {
+  msg_t msg;
+  for (;;) {
+    mbox_get(&mbox, &msg);
+  }
+  return nullptr;
+}
+
+void* mpsc_producer(void* arg) {
+  unsigned base = reinterpret_cast<uintptr_t>(arg);
+  for (unsigned i = 0; i < PRODUCER_ITEMS; ++i) {
+    while (!mpsc.try_push(token{base + i})) {
+      thread_yield();
+    }
+  }
+  return nullptr;
+}
+
+template <class F>
+int sample(void* arg) {
+  F& func = *static_cast<F*>(arg);
+  for (unsigned long i = 0; i < BENCH_RUNS; ++i) {
+    func();
+  }
+  return 0;
+}
+
+template <class F>
+void bench(const char* name, F func) {
+  benchmark_result_t res;
+  benchmark_result_init(&res, name, BENCH_RUNS);
+  benchmark_run(&res, BENCH_SAMPLES, sample<F>, &func);
+}
+
+kernel_pid_t start(unsigned idx, thread_task_func_t func, const char* name,
+                   uint8_t prio = THREAD_PRIORITY_MAIN - 1,
+                   void* arg = nullptr) {
+  return thread_create(stacks[idx], sizeof(stacks[idx]), prio,
+                       THREAD_CREATE_STACKTEST, func, arg, name);
+}
+
+} // namespace
+
+int main() {
+  puts("\n************ C++ lock-free queue test ***********");
+
+  puts("spsc_queue ...");
+  {
+    bool pushed;
+    for (unsigned i = 1; i <= QUEUE_SIZE; ++i) {
+      pushed = spsc.try_push(token{i});
+      assert(pushed);
+    }
+    assert(spsc.full());
+    pushed = spsc.try_push(token{0});
+    assert(!pushed);
+    (void)pushed;
+    for (unsigned i = 1; i <= QUEUE_SIZE; ++i) {
+      token t = spsc.pop();
+      assert(t.value() == i);
+      (void)t;
+    }
+    assert(spsc.empty());
+  }
+  puts("Done\n");
+
+  puts("mpsc_queue ...");
+  {
+    unsigned next[2] = { 0, 0 };
+    start(0, mpsc_producer, "producer 0", THREAD_PRIORITY_MAIN + 1,
+          reinterpret_cast<void*>(0));
+    start(1, mpsc_producer, "producer 1", THREAD_PRIORITY_MAIN + 1,
+          reinterpret_cast<void*>(PRODUCER_ITEMS));
+    for (unsigned i = 0; i < 2 * PRODUCER_ITEMS; ++i) {
+      token t = mpsc.pop();
+      unsigned producer = t.value() / PRODUCER_ITEMS;
+      /* the elements of each producer arrive in order */
+      if (t.value() % PRODUCER_ITEMS != next[producer]++) {
+        printf("unexpected element %u\n", t.value());
+        return 1;
+      }
+    }
+    assert(mpsc.empty());
+  }
+  puts("Done\n");
+
+  puts("Latency of handing an element to a waiting thread");
+  start(2, spsc_consumer, "spsc");
+  bench("riot::spsc_queue", [] { spsc.push(token{1}); });
+  start(3, mpsc_consumer, "mpsc");
+  bench("riot::mpsc_queue", [] { mpsc_bench.try_push(1); });
+  msg_pid = start(4, msg_consumer, "msg");
+  bench("msg_send()", [] {
+    msg_t msg;
+    msg_send(&msg, msg_pid);
+  });
+  mbox_init(&mbox, mbox_queue, QUEUE_SIZE);
+  start(5, mbox_consumer, "mbox");
+  bench("mbox_put()", [] {
+    msg_t msg;
+    mbox_put(&mbox, &msg);
+  });
+
+  puts("\n[SUCCESS]");
+  return 0;
+}
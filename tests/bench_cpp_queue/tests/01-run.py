@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run, BENCHMARK_REGEXP
+
+
+def testfunc(child):
+    child.expect_exact("************ C++ lock-free queue test ***********")
+    child.expect_exact("spsc_queue ...")
+    child.expect_exact("Done")
+    child.expect_exact("mpsc_queue ...")
+    child.expect_exact("Done")
+    child.expect(BENCHMARK_REGEXP.format(func="riot::spsc_queue"))
+    child.expect(BENCHMARK_REGEXP.format(func="riot::mpsc_queue"))
+    child.expect(BENCHMARK_REGEXP.format(func=r"msg_send\(\)"))
+    child.expect(BENCHMARK_REGEXP.format(func=r"mbox_put\(\)"))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
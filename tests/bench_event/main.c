@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the runtime of the event queue
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "event.h"
+#include "kernel_defines.h"
+#include "thread.h"
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
+#endif
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define QUEUES_NUMOF        (4U)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+
+static event_queue_t _queues[QUEUES_NUMOF];
+static event_queue_t _other_queue;
+
+static void _nop_handler(event_t *event)
+{
+    (void)event;
+}
+
+static event_t _events[QUEUES_NUMOF] = {
+    { .handler = _nop_handler },
+    { .handler = _nop_handler },
+    { .handler = _nop_handler },
+    { .handler = _nop_handler },
+};
+
+static void _pong_handler(event_t *event)
+{
+    event_post(&_queues[0], event);
+}
+
+static event_t _ping = { .handler = _pong_handler };
+
+static void *_second_thread(void *arg)
+{
+    (void)arg;
+
+    event_queue_init(&_other_queue);
+    event_loop(&_other_queue);
+
+    return NULL;
+}
+
+static int _check_order(void)
+{
+    /* post in reverse priority order */
+    for (unsigned i = QUEUES_NUMOF; i > 0; i--) {
+        event_post(&_queues[i - 1], &_events[i - 1]);
+    }
+    /* posting again must have no effect */
+    event_post(&_queues[0], &_events[0]);
+
+    for (unsigned i = 0; i < QUEUES_NUMOF; i++) {
+        if (event_get_multi(_queues, QUEUES_NUMOF) != &_events[i]) {
+            return -1;
+        }
+    }
+    if (event_get_multi(_queues, QUEUES_NUMOF) != NULL) {
+        return -1;
+    }
+
+    /* FIFO order within a queue, cancel in the middle */
+    for (unsigned i = 0; i < QUEUES_NUMOF; i++) {
+        event_post(&_queues[0], &_events[i]);
+    }
+    event_cancel(&_queues[0], &_events[1]);
+    for (unsigned i = 0; i < QUEUES_NUMOF; i++) {
+        if (i == 1) {
+            continue;
+        }
+        if (event_wait_multi(_queues, QUEUES_NUMOF) != &_events[i]) {
+            return -1;
+        }
+    }
+    return (event_get(&_queues[0]) == NULL) ? 0 : -1;
+}
+
+static void _post_get(void)
+{
+    event_post(&_queues[0], &_events[0]);
+    event_get(&_queues[0]);
+}
+
+static void _post_get_multi(void)
+{
+    /* worst case: only the queue with the lowest priority has an event */
+    event_post(&_queues[QUEUES_NUMOF - 1], &_events[0]);
+    event_get_multi(_queues, QUEUES_NUMOF);
+}
+
+static void _post_cancel(void)
+{
+    event_post(&_queues[0], &_events[0]);
+    event_cancel(&_queues[0], &_events[0]);
+}
+
+static int _pingpong(void *arg)
+{
+    (void)arg;
+
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        event_post(&_other_queue, &_ping);
+        event_wait(&_queues[0]);
+    }
+    return 0;
+}
+
+int main(void)
+{
+    puts("event queue benchmark");
+
+    event_queues_init(_queues, ARRAY_SIZE(_queues));
+    thread_create(_stack, sizeof(_stack), (THREAD_PRIORITY_MAIN - 1),
+                  THREAD_CREATE_STACKTEST, _second_thread, NULL,
+                  "second_thread");
+
+    if (_check_order() != 0) {
+        puts("event order wrong");
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("event order ok");
+
+    BENCHMARK_SAMPLES("event_post() + event_get()", BENCH_SAMPLES, BENCH_RUNS,
+                      _post_get());
+    BENCHMARK_SAMPLES("event_post() + event_get_multi()", BENCH_SAMPLES,
+                      BENCH_RUNS, _post_get_multi());
+    BENCHMARK_SAMPLES("event_post() + event_cancel()", BENCH_SAMPLES,
+                      BENCH_RUNS, _post_cancel());
+
+    /* interrupts must stay enabled for the context switches */
+    benchmark_result_t res;
+    benchmark_result_init(&res, "event_post() pingpong", BENCH_RUNS);
+    benchmark_run(&res, BENCH_SAMPLES, _pingpong, NULL);
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run, BENCHMARK_REGEXP
+
+
+# The default timeout is not enough for this test on some of the slower boards
+TIMEOUT = 30
+
+
+def testfunc(child):
+    child.expect_exact("event queue benchmark")
+    child.expect_exact("event order ok")
+    child.expect(BENCHMARK_REGEXP.format(func=r"event_post\(\) \+ event_get\(\)"))
+    child.expect(BENCHMARK_REGEXP.format(func=r"event_post\(\) \+ event_get_multi\(\)"))
+    child.expect(BENCHMARK_REGEXP.format(func=r"event_post\(\) \+ event_cancel\(\)"))
+    child.expect(BENCHMARK_REGEXP.format(func=r"event_post\(\) pingpong"), timeout=TIMEOUT)
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -11,32 +11,36 @@
  * @{
  *
  * @file
- * @brief       Measure messages send per second
+ * @brief       Measure the time needed to send a message to another thread
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
  * @}
  */
 
+#include <stdint.h>
 #include <stdio.h>
-#include "thread.h"
 
+#include "benchmark.h"
 #include "msg.h"
-#include "xtimer.h"
+#include "thread.h"
 
-#ifndef TEST_DURATION
-#define TEST_DURATION       (1000000U)
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
 #endif
 
-volatile unsigned _flag = 0;
-static char _stack[THREAD_STACKSIZE_MAIN];
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
 
-static void _timer_callback(void*arg)
-{
-    (void)arg;
+#define QUEUE_SIZE          (16U)
 
-    _flag = 1;
-}
+static char _stack[THREAD_STACKSIZE_MAIN];
+static char _sink_stack[THREAD_STACKSIZE_MAIN];
+
+static kernel_pid_t _other;
+static kernel_pid_t _sink;
+static volatile unsigned long _received;
 
 static void *_second_thread(void *arg)
 {
@@ -50,32 +54,90 @@ static void *_second_thread(void *arg)
     return NULL;
 }
 
-int main(void)
+static void *_sink_thread(void *arg)
 {
-    printf("main starting\n");
+    (void)arg;
+    msg_t queue[QUEUE_SIZE];
+    msg_t msgs[QUEUE_SIZE];
 
-    kernel_pid_t other = thread_create(_stack,
-                                       sizeof(_stack),
-                                       (THREAD_PRIORITY_MAIN - 1),
-                                       THREAD_CREATE_STACKTEST,
-                                       _second_thread,
-                                       NULL,
-                                       "second_thread");
+    msg_init_queue(queue, QUEUE_SIZE);
+    while (1) {
+        _received += msg_receive_bulk(msgs, QUEUE_SIZE);
+    }
 
-    xtimer_t timer;
-    timer.callback = _timer_callback;
+    return NULL;
+}
 
+static int _pingpong(void *arg)
+{
+    (void)arg;
     msg_t test;
 
-    uint32_t n = 0;
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        msg_send(&test, _other);
+    }
+    return 0;
+}
+
+static int _throughput(void *arg)
+{
+    unsigned threshold = (uintptr_t)arg;
+    msg_t test;
 
-    xtimer_set(&timer, TEST_DURATION);
-    while(!_flag) {
-        msg_send(&test, other);
-        n++;
+    _received = 0;
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        if (threshold == 0) {
+            msg_send(&test, _sink);
+        }
+        else {
+            /* the sink was woken up, let it drain the queue */
+            while (msg_send_deferred(&test, _sink, threshold) != 1) {
+                thread_yield();
+            }
+        }
     }
+    while (_received < BENCH_RUNS) {
+        msg_flush(_sink);
+        thread_yield();
+    }
+    return 0;
+}
+
+int main(void)
+{
+    printf("main starting\n");
 
-    printf("{ \"result\" : %"PRIu32" }\n", n);
+    _other = thread_create(_stack,
+                           sizeof(_stack),
+                           (THREAD_PRIORITY_MAIN - 1),
+                           THREAD_CREATE_STACKTEST,
+                           _second_thread,
+                           NULL,
+                           "second_thread");
+
+    benchmark_result_t res;
+
+    /* interrupts must stay enabled for the context switches */
+    benchmark_result_init(&res, "msg_send() pingpong", BENCH_RUNS);
+    benchmark_run(&res, BENCH_SAMPLES, _pingpong, NULL);
+
+    /* the sink has the same priority as this thread, so it only runs when
+     * this thread blocks or yields */
+    _sink = thread_create(_sink_stack,
+                          sizeof(_sink_stack),
+                          THREAD_PRIORITY_MAIN,
+                          THREAD_CREATE_STACKTEST,
+                          _sink_thread,
+                          NULL,
+                          "sink_thread");
+
+    benchmark_result_init(&res, "msg_send() throughput", BENCH_RUNS);
+    benchmark_run(&res, BENCH_SAMPLES, _throughput, (void *)0);
+    benchmark_result_init(&res, "msg_send_deferred() throughput", BENCH_RUNS);
+    benchmark_run(&res, BENCH_SAMPLES, _throughput,
+                  (void *)(uintptr_t)(QUEUE_SIZE / 2));
+
+    puts("SUCCESS");
 
     return 0;
 }
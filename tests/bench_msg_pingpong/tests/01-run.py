@@ -8,11 +8,14 @@
 # directory for more details.
 
 import sys
-from testrunner import run
+from testrunner import run, BENCHMARK_REGEXP
 
 
 def testfunc(child):
-    child.expect(r"{ \"result\" : \d+ }")
+    for func in (r"msg_send\(\) pingpong", r"msg_send\(\) throughput",
+                 r"msg_send_deferred\(\) throughput"):
+        child.expect(BENCHMARK_REGEXP.format(func=func))
+    child.expect_exact("SUCCESS")
 
 
 if __name__ == "__main__":
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the block I/O throughput of a MTD
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "board.h"
+#include "mtd.h"
+
+#ifdef MODULE_MTD_SDCARD
+#include "mtd_sdcard.h"
+#include "sdcard_spi.h"
+#include "sdcard_spi_params.h"
+#endif
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
+#endif
+
+/* bytes per transfer, must be a multiple of the page size */
+#ifndef BENCH_SIZE
+#define BENCH_SIZE          (4096U)
+#endif
+
+#ifdef MODULE_MTD_SDCARD
+extern sdcard_spi_t sdcard_spi_devs[ARRAY_SIZE(sdcard_spi_params)];
+static mtd_sdcard_t _mtd_sdcard = {
+    .base.driver = &mtd_sdcard_driver,
+    .sd_card = &sdcard_spi_devs[0],
+    .params = &sdcard_spi_params[0],
+};
+static mtd_dev_t *_dev = &_mtd_sdcard.base;
+#else
+#define _dev                (MTD_0)
+#endif
+
+static uint8_t _buf[BENCH_SIZE];
+static uint8_t _pattern[BENCH_SIZE];
+static uint32_t _first_page;
+static unsigned _pages;
+
+static int _read_pages(void *arg)
+{
+    (void)arg;
+
+    for (unsigned p = 0; p < _pages; p++) {
+        uint32_t addr = (_first_page + p) * _dev->page_size;
+        if (mtd_read(_dev, &_buf[p * _dev->page_size], addr,
+                     _dev->page_size) != (int)_dev->page_size) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _write_pages(void *arg)
+{
+    (void)arg;
+
+    for (unsigned p = 0; p < _pages; p++) {
+        uint32_t addr = (_first_page + p) * _dev->page_size;
+        if (mtd_write(_dev, &_pattern[p * _dev->page_size], addr,
+                      _dev->page_size) != (int)_dev->page_size) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _read_multi(void *arg)
+{
+    (void)arg;
+
+    return (mtd_read_page(_dev, _buf, _first_page, 0, BENCH_SIZE) ==
+            BENCH_SIZE) ? 0 : -1;
+}
+
+static int _write_multi(void *arg)
+{
+    (void)arg;
+
+    return (mtd_write_page(_dev, _pattern, _first_page, 0, BENCH_SIZE) ==
+            BENCH_SIZE) ? 0 : -1;
+}
+
+static int _bench(const char *name, benchmark_sample_t func)
+{
+    benchmark_result_t res;
+
+    benchmark_result_init(&res, name, 1);
+    if (benchmark_run(&res, BENCH_SAMPLES, func, NULL) < 0) {
+        printf("%s failed\n", name);
+        return -1;
+    }
+
+    uint32_t mean = benchmark_result_mean(&res);
+    printf("%s: %lu KiB/s\n", name,
+           (unsigned long)(((uint64_t)BENCH_SIZE * BENCHMARK_CLOCK_HZ) /
+                           ((mean ? mean : 1) * 1024ULL)));
+    return 0;
+}
+
+static int _setup(void)
+{
+    if (mtd_init(_dev) != 0) {
+        puts("mtd_init() failed");
+        return -1;
+    }
+    if (BENCH_SIZE % _dev->page_size) {
+        puts("BENCH_SIZE must be a multiple of the page size");
+        return -1;
+    }
+    _pages = BENCH_SIZE / _dev->page_size;
+
+    /* use the last sectors, within the range of mtd_read()/mtd_write() */
+    uint32_t pages_total = _dev->sector_count * _dev->pages_per_sector;
+    if (pages_total > UINT32_MAX / _dev->page_size) {
+        pages_total = UINT32_MAX / _dev->page_size;
+    }
+    if (pages_total < _pages) {
+        puts("device too small");
+        return -1;
+    }
+    _first_page = pages_total - _pages;
+    _first_page -= _first_page % _dev->pages_per_sector;
+
+    printf("page size %" PRIu32 ", %u pages per transfer, starting at page %"
+           PRIu32 "\n", _dev->page_size, _pages, _first_page);
+
+    int res = mtd_erase(_dev, _first_page * _dev->page_size,
+                        ((_pages + _dev->pages_per_sector - 1) /
+                         _dev->pages_per_sector) *
+                        _dev->pages_per_sector * _dev->page_size);
+    if ((res != 0) && (res != -ENOTSUP)) {
+        puts("mtd_erase() failed");
+        return -1;
+    }
+
+    for (unsigned i = 0; i < sizeof(_pattern); i++) {
+        _pattern[i] = i * 7 + (i >> 8);
+    }
+
+    /* both variants must yield the same data */
+    if ((_write_multi(NULL) != 0) || (_read_pages(NULL) != 0) ||
+        memcmp(_buf, _pattern, sizeof(_buf))) {
+        puts("mtd_write_page() + mtd_read() failed");
+        return -1;
+    }
+    memset(_buf, 0, sizeof(_buf));
+    if ((_write_pages(NULL) != 0) || (_read_multi(NULL) != 0) ||
+        memcmp(_buf, _pattern, sizeof(_buf))) {
+        puts("mtd_write() + mtd_read_page() failed");
+        return -1;
+    }
+    puts("data ok");
+    return 0;
+}
+
+int main(void)
+{
+    puts("MTD block I/O benchmark");
+
+    if (_setup() != 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    /* interrupts must stay enabled for the transfers */
+    if ((_bench("mtd_read() page by page", _read_pages) != 0) ||
+        (_bench("mtd_read_page()", _read_multi) != 0) ||
+        (_bench("mtd_write() page by page", _write_pages) != 0) ||
+        (_bench("mtd_write_page()", _write_multi) != 0)) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
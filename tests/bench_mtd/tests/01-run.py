@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run, BENCHMARK_REGEXP
+
+
+# SD cards can be slow to write
+TIMEOUT = 60
+
+
+def testfunc(child):
+    child.expect_exact("MTD block I/O benchmark")
+    child.expect_exact("data ok")
+    for func in (r"mtd_read\(\) page by page", r"mtd_read_page\(\)",
+                 r"mtd_write\(\) page by page", r"mtd_write_page\(\)"):
+        child.expect(BENCHMARK_REGEXP.format(func=func), timeout=TIMEOUT)
+        child.expect(r"{}: \d+ KiB/s".format(func))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
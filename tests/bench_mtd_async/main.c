@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure how much flash latency the asynchronous MTD API hides
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "board.h"
+#include "mtd.h"
+#include "xtimer.h"
+
+#ifndef MTD_0
+#error "the board has no MTD_0"
+#endif
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
+#endif
+
+/* CPU time needed for other work per flash operation */
+#ifndef WORK_US
+#define WORK_US             (400U)
+#endif
+
+#define _dev                (MTD_0)
+
+static uint8_t _page[256];
+static uint32_t _sector_addr;
+static uint32_t _sector_size;
+
+static void _work(void)
+{
+    xtimer_spin(xtimer_ticks_from_usec(WORK_US));
+}
+
+static int _sync(void *arg)
+{
+    (void)arg;
+
+    if (mtd_erase(_dev, _sector_addr, _sector_size) != 0) {
+        return -1;
+    }
+    _work();
+    for (uint32_t off = 0; off < _sector_size; off += _dev->page_size) {
+        if (mtd_write(_dev, _page, _sector_addr + off, _dev->page_size) !=
+            (int)_dev->page_size) {
+            return -1;
+        }
+        _work();
+    }
+    return 0;
+}
+
+static int _async(void *arg)
+{
+    mtd_async_t req;
+
+    (void)arg;
+
+    if ((mtd_erase_async(_dev, &req, _sector_addr, _sector_size,
+                         NULL, NULL) != 0)) {
+        return -1;
+    }
+    _work();
+    if (mtd_async_wait(&req) != 0) {
+        return -1;
+    }
+    for (uint32_t off = 0; off < _sector_size; off += _dev->page_size) {
+        if (mtd_write_async(_dev, &req, _page, _sector_addr + off,
+                            _dev->page_size, NULL, NULL) != 0) {
+            return -1;
+        }
+        _work();
+        if (mtd_async_wait(&req) != (int)_dev->page_size) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _bench(const char *name, benchmark_sample_t func, uint32_t *mean_us)
+{
+    benchmark_result_t res;
+
+    benchmark_result_init(&res, name, 1);
+    if (benchmark_run(&res, BENCH_SAMPLES, func, NULL) < 0) {
+        printf("%s failed\n", name);
+        return -1;
+    }
+
+    *mean_us = ((uint64_t)benchmark_result_mean(&res) * 1000000UL) /
+               BENCHMARK_CLOCK_HZ;
+    return 0;
+}
+
+static int _setup(void)
+{
+    if (mtd_init(_dev) != 0) {
+        puts("mtd_init() failed");
+        return -1;
+    }
+    if (_dev->page_size > sizeof(_page)) {
+        puts("page size too large");
+        return -1;
+    }
+
+    _sector_size = _dev->pages_per_sector * _dev->page_size;
+    _sector_addr = (_dev->sector_count - 1) * _sector_size;
+    printf("%" PRIu32 " pages of %" PRIu32 " bytes per sector, %u us work "
+           "per operation\n", _dev->pages_per_sector, _dev->page_size,
+           WORK_US);
+
+    for (unsigned i = 0; i < sizeof(_page); i++) {
+        _page[i] = i * 7;
+    }
+
+    /* the asynchronous variant must yield the same data */
+    if (_async(NULL) != 0) {
+        puts("asynchronous erase and write failed");
+        return -1;
+    }
+    for (uint32_t off = 0; off < _sector_size; off += _dev->page_size) {
+        uint8_t buf[sizeof(_page)];
+
+        if ((mtd_read(_dev, buf, _sector_addr + off, _dev->page_size) !=
+             (int)_dev->page_size) || memcmp(buf, _page, _dev->page_size)) {
+            puts("data differs");
+            return -1;
+        }
+    }
+    puts("data ok");
+    return 0;
+}
+
+int main(void)
+{
+    uint32_t sync_us;
+    uint32_t async_us;
+
+    puts("MTD asynchronous access benchmark");
+
+    /* interrupts must stay enabled for the flash operations to complete */
+    if ((_setup() != 0) ||
+        (_bench("synchronous", _sync, &sync_us) != 0) ||
+        (_bench("asynchronous", _async, &async_us) != 0)) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    printf("asynchronous saves %" PRIu32 " us per sector\n",
+           (sync_us > async_us) ? sync_us - async_us : 0);
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run, BENCHMARK_REGEXP
+
+
+TIMEOUT = 30
+
+
+def testfunc(child):
+    child.expect_exact("MTD asynchronous access benchmark")
+    child.expect_exact("data ok")
+    for func in ("synchronous", "asynchronous"):
+        child.expect(BENCHMARK_REGEXP.format(func=func), timeout=TIMEOUT)
+    child.expect(r"asynchronous saves \d+ us per sector")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -25,8 +25,12 @@
 #include "thread.h"
 #include "thread_flags.h"
 
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (10U)
+#endif
+
 #ifndef BENCH_RUNS
-#define BENCH_RUNS          (1000UL * 1000UL)
+#define BENCH_RUNS          (100UL * 1000UL)
 #endif
 
 static mutex_t _lock;
@@ -64,19 +68,19 @@ int main(void)
 
     t = (thread_t *)sched_active_thread;
 
-    BENCHMARK_FUNC("nop loop", BENCH_RUNS, __asm__ volatile ("nop"));
+    BENCHMARK_SAMPLES("nop loop", BENCH_SAMPLES, BENCH_RUNS, __asm__ volatile ("nop"));
     puts("");
-    BENCHMARK_FUNC("mutex_init()", BENCH_RUNS, mutex_init(&_lock));
-    BENCHMARK_FUNC("mutex lock/unlock", BENCH_RUNS, _mutex_lockunlock());
+    BENCHMARK_SAMPLES("mutex_init()", BENCH_SAMPLES, BENCH_RUNS, mutex_init(&_lock));
+    BENCHMARK_SAMPLES("mutex lock/unlock", BENCH_SAMPLES, BENCH_RUNS, _mutex_lockunlock());
     puts("");
-    BENCHMARK_FUNC("thread_flags_set()", BENCH_RUNS, thread_flags_set(t, _flag));
-    BENCHMARK_FUNC("thread_flags_clear()", BENCH_RUNS, thread_flags_clear(_flag));
-    BENCHMARK_FUNC("thread flags set/wait any", BENCH_RUNS, _flag_waitany());
-    BENCHMARK_FUNC("thread flags set/wait all", BENCH_RUNS, _flag_waitall());
-    BENCHMARK_FUNC("thread flags set/wait one", BENCH_RUNS, _flag_waitone());
+    BENCHMARK_SAMPLES("thread_flags_set()", BENCH_SAMPLES, BENCH_RUNS, thread_flags_set(t, _flag));
+    BENCHMARK_SAMPLES("thread_flags_clear()", BENCH_SAMPLES, BENCH_RUNS, thread_flags_clear(_flag));
+    BENCHMARK_SAMPLES("thread flags set/wait any", BENCH_SAMPLES, BENCH_RUNS, _flag_waitany());
+    BENCHMARK_SAMPLES("thread flags set/wait all", BENCH_SAMPLES, BENCH_RUNS, _flag_waitall());
+    BENCHMARK_SAMPLES("thread flags set/wait one", BENCH_SAMPLES, BENCH_RUNS, _flag_waitone());
     puts("");
-    BENCHMARK_FUNC("msg_try_receive()", BENCH_RUNS, msg_try_receive(&_msg));
-    BENCHMARK_FUNC("msg_avail()", BENCH_RUNS, msg_avail());
+    BENCHMARK_SAMPLES("msg_try_receive()", BENCH_SAMPLES, BENCH_RUNS, msg_try_receive(&_msg));
+    BENCHMARK_SAMPLES("msg_avail()", BENCH_SAMPLES, BENCH_RUNS, msg_avail());
 
     puts("\n[SUCCESS]");
     return 0;
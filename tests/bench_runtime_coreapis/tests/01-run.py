@@ -7,12 +7,11 @@
 # directory for more details.
 
 import sys
-from testrunner import run
+from testrunner import run, BENCHMARK_REGEXP
 
 
 # The default timeout is not enough for this test on some of the slower boards
 TIMEOUT = 30
-BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
 
 
 def testfunc(child):
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test thread pool, future and promise replacement headers
+ *
+ * @}
+ */
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+
+#include "riot/future.hpp"
+#include "riot/thread.hpp"
+#include "riot/thread_pool.hpp"
+
+using namespace std;
+using namespace riot;
+
+namespace {
+
+/* static storage, the workers are started in main() */
+thread_pool<2, 4> pool;
+
+int square(int x) {
+  return x * x;
+}
+
+} // namespace
+
+int main() {
+  puts("\n************ C++ thread pool test ***********");
+
+  pool.start();
+
+  puts("Promise and future ...");
+  {
+    promise<int> p;
+    future<int> f = p.get_future();
+    assert(f.valid());
+    assert(!f.is_ready());
+    thread t([&p] {
+      this_thread::sleep_for(chrono::milliseconds(10));
+      p.set_value(42);
+    });
+    int res = f.get();
+    assert(res == 42);
+    (void)res;
+    assert(!f.valid());
+    t.join();
+  }
+  {
+    future<void> f;
+    {
+      promise<void> p;
+      f = p.get_future();
+    }
+    bool caught = false;
+    try {
+      f.get();
+    }
+    catch (const runtime_error&) {
+      caught = true;
+    }
+    assert(caught);
+    (void)caught;
+  }
+  puts("Done\n");
+
+  puts("async ...");
+  {
+    future<int> results[8];
+    for (int i = 0; i < 8; ++i) {
+      /* the queue holds only 4 jobs, the others run right here */
+      results[i] = async(pool, square, i);
+    }
+    for (int i = 0; i < 8; ++i) {
+      int res = results[i].get();
+      assert(res == i * i);
+      (void)res;
+    }
+    future<void> f = async(pool, [] { throw logic_error("test"); });
+    bool caught = false;
+    try {
+      f.get();
+    }
+    catch (const logic_error&) {
+      caught = true;
+    }
+    assert(caught);
+    (void)caught;
+  }
+  puts("Done\n");
+
+  puts("submit ...");
+  {
+    unsigned counter = 0;
+    promise<void> done;
+    future<void> f = done.get_future();
+    for (unsigned i = 0; i < 3; ++i) {
+      while (!pool.submit([&counter] { ++counter; })) {
+        this_thread::yield();
+      }
+    }
+    while (!pool.submit([&done] { done.set_value(); })) {
+      this_thread::yield();
+    }
+    f.get();
+    assert(counter == 3);
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+  return 0;
+}
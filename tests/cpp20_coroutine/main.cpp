@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test coroutines running on an event queue
+ *
+ * @}
+ */
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+
+#include "event.h"
+
+#include "riot/coroutine.hpp"
+
+using namespace std;
+using namespace riot;
+
+namespace {
+
+event_queue_t queue;
+async_mutex mtx;
+
+unsigned finished = 0;
+char order[8];
+unsigned order_len = 0;
+
+task<int> square(int x) {
+  co_await resume_on(queue);
+  co_return x * x;
+}
+
+task<int> fail() {
+  co_await sleep_for(queue, 1000);
+  throw logic_error("test");
+}
+
+task<> nested() {
+  int sum = 0;
+  for (int i = 0; i < 4; ++i) {
+    sum += co_await square(i);
+  }
+  assert(sum == 14);
+  bool caught = false;
+  try {
+    co_await fail();
+  }
+  catch (const logic_error&) {
+    caught = true;
+  }
+  assert(caught);
+  (void)caught;
+  ++finished;
+}
+
+task<> sleeper(uint32_t usec, char id) {
+  co_await sleep_for(queue, chrono::microseconds(usec));
+  order[order_len++] = id;
+  ++finished;
+}
+
+task<> locker(char id) {
+  co_await mtx.lock(queue);
+  order[order_len++] = id;
+  /* the others have to wait while the lock is held across a suspension */
+  co_await sleep_for(queue, 5000);
+  order[order_len++] = id;
+  mtx.unlock();
+  ++finished;
+}
+
+void run_until(unsigned num) {
+  while (finished < num) {
+    event_t* ev = event_wait(&queue);
+    ev->handler(ev);
+  }
+}
+
+} // namespace
+
+int main() {
+  puts("\n************ C++ coroutine test ***********");
+  event_queue_init(&queue);
+
+  puts("Nested tasks ...");
+  finished = 0;
+  spawn(queue, nested());
+  run_until(1);
+  puts("Done\n");
+
+  puts("Sleep ...");
+  finished = 0;
+  order_len = 0;
+  spawn(queue, sleeper(30000, 'c'));
+  spawn(queue, sleeper(10000, 'a'));
+  spawn(queue, sleeper(20000, 'b'));
+  run_until(3);
+  assert(order[0] == 'a' && order[1] == 'b' && order[2] == 'c');
+  puts("Done\n");
+
+  puts("Mutex ...");
+  finished = 0;
+  order_len = 0;
+  spawn(queue, locker('a'));
+  spawn(queue, locker('b'));
+  spawn(queue, locker('c'));
+  run_until(3);
+  assert(order_len == 6);
+  for (unsigned i = 0; i < order_len; i += 2) {
+    /* lock and unlock of one coroutine are never interleaved */
+    assert(order[i] == order[i + 1]);
+  }
+  bool locked = mtx.try_lock();
+  assert(locked);
+  (void)locked;
+  mtx.unlock();
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+  return 0;
+}
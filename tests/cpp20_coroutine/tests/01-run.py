@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("************ C++ coroutine test ***********")
+    child.expect_exact("Nested tasks ...")
+    child.expect_exact("Done")
+    child.expect_exact("Sleep ...")
+    child.expect_exact("Done")
+    child.expect_exact("Mutex ...")
+    child.expect_exact("Done")
+    child.expect_exact("Bye, bye.")
+    child.expect_exact("******************************************")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
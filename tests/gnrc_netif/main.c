@@ -1161,6 +1161,46 @@ static void test_netif_get_opt(void)
     TEST_ASSERT_EQUAL_INT(0, memcmp(exp_ethernet, value, sizeof(exp_ethernet)));
 }
 
+static void test_netif_opt_cache_get(void)
+{
+    static const uint8_t exp_ethernet[] = ETHERNET_SRC;
+    uint8_t value[GNRC_NETIF_L2ADDR_MAXLEN];
+    uint8_t orig_hl = ethernet_netif->cur_hl;
+    uint8_t hl = 73;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(exp_ethernet),
+                          gnrc_netif_opt_cache_get(ethernet_netif,
+                                                   NETOPT_ADDRESS, 0,
+                                                   &value, sizeof(value)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp_ethernet, value, sizeof(exp_ethernet)));
+    /* interface does not use long addresses */
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP,
+                          gnrc_netif_opt_cache_get(ethernet_netif,
+                                                   NETOPT_ADDRESS_LONG, 0,
+                                                   &value, sizeof(value)));
+    /* not cached */
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP,
+                          gnrc_netif_opt_cache_get(ethernet_netif,
+                                                   NETOPT_IPV6_ADDR, 0,
+                                                   &value, sizeof(value)));
+    /* cache is updated with a set */
+    TEST_ASSERT_EQUAL_INT(sizeof(hl),
+                          gnrc_netapi_set(ethernet_netif->pid,
+                                          NETOPT_HOP_LIMIT, 0,
+                                          &hl, sizeof(hl)));
+    TEST_ASSERT_EQUAL_INT(sizeof(uint8_t),
+                          gnrc_netif_opt_cache_get(ethernet_netif,
+                                                   NETOPT_HOP_LIMIT, 0,
+                                                   &value, sizeof(uint8_t)));
+    TEST_ASSERT_EQUAL_INT(hl, value[0]);
+    TEST_ASSERT_EQUAL_INT(ethernet_netif->cur_hl, value[0]);
+    /* return hop limit to previous state for further testing */
+    TEST_ASSERT_EQUAL_INT(sizeof(orig_hl),
+                          gnrc_netapi_set(ethernet_netif->pid,
+                                          NETOPT_HOP_LIMIT, 0,
+                                          &orig_hl, sizeof(orig_hl)));
+}
+
 static void test_netif_set_opt(void)
 {
     /* just repeat one of the gnrc_netapi_set tests, just with netif_set_opt */
@@ -1594,6 +1634,7 @@ static Test *embunit_tests_gnrc_netif(void)
         new_TestFixture(test_netif_get_name),
         new_TestFixture(test_netif_get_by_name),
         new_TestFixture(test_netif_get_opt),
+        new_TestFixture(test_netif_opt_cache_get),
         new_TestFixture(test_netif_set_opt),
         /* only add tests not involving output here */
     };
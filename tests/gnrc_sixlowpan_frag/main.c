@@ -212,7 +212,7 @@ static const gnrc_sixlowpan_frag_rb_t *_first_non_empty_rbuf(void)
 
     for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if (!gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
-            return rbuf;
+            return &rbuf[i];
         }
     }
     return NULL;
@@ -317,6 +317,37 @@ static void test_rbuf_add__success_duplicate_fragments(void)
     _check_pktbuf(entry);
 }
 
+static void test_rbuf_add__success_out_of_order(void)
+{
+    gnrc_pktsnip_t *pkt3 = gnrc_pktbuf_add(NULL, _fragment3, sizeof(_fragment3),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt2 = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    const gnrc_sixlowpan_frag_rb_t *entry;
+
+    TEST_ASSERT_NOT_NULL(pkt3);
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt3, TEST_FRAGMENT3_OFFSET, TEST_PAGE
+        ));
+    TEST_ASSERT_NOT_NULL(pkt2);
+    TEST_ASSERT_NOT_NULL((entry = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt2, TEST_FRAGMENT2_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT4_OFFSET - TEST_FRAGMENT2_OFFSET,
+                          entry->super.current_size);
+    /* intervals are sorted by their start */
+    TEST_ASSERT_NOT_NULL(entry->super.ints);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT2_OFFSET, entry->super.ints->start);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT3_OFFSET - 1, entry->super.ints->end);
+    TEST_ASSERT_NOT_NULL(entry->super.ints->next);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT3_OFFSET,
+                          entry->super.ints->next->start);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT4_OFFSET - 1,
+                          entry->super.ints->next->end);
+    TEST_ASSERT_NULL(entry->super.ints->next->next);
+    _check_pktbuf(entry);
+}
+
 static void test_rbuf_add__success_complete(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
@@ -628,6 +659,7 @@ static void run_unittests(void)
         new_TestFixture(test_rbuf_add__success_first_fragment),
         new_TestFixture(test_rbuf_add__success_subsequent_fragment),
         new_TestFixture(test_rbuf_add__success_duplicate_fragments),
+        new_TestFixture(test_rbuf_add__success_out_of_order),
         new_TestFixture(test_rbuf_add__success_complete),
         new_TestFixture(test_rbuf_add__full_rbuf),
         new_TestFixture(test_rbuf_add__too_big_fragment),
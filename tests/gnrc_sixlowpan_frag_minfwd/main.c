@@ -0,0 +1,492 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests 6LoWPAN minimal fragment forwarding
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/frag/minfwd.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/gnrc/sixlowpan/frag/stats.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_DST        { 0x5a, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 }
+#define TEST_SRC        { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_6LO_PAYLOAD { \
+        /* 6LoWPAN, Src: 2001:db8::1, Dest: 2001:db8::2
+         *    Fragmentation Header
+         *        1100 0... = Pattern: First fragment (0x18)
+         *        Datagram size: 188
+         *        Datagram tag: 0x000f
+         *    IPHC Header
+         *        011. .... = Pattern: IP header compression (0x03)
+         *        ...1 1... .... .... = Version, traffic class, and flow label compressed (0x3)
+         *        .... .0.. .... .... = Next header: Inline
+         *        .... ..10 .... .... = Hop limit: 64 (0x2)
+         *        .... .... 0... .... = Context identifier extension: False
+         *        .... .... .0.. .... = Source address compression: Stateless
+         *        .... .... ..00 .... = Source address mode: Inline (0x0000)
+         *        .... .... .... 0... = Multicast address compression: False
+         *        .... .... .... .0.. = Destination address compression: Stateless
+         *        .... .... .... ..00 = Destination address mode: Inline (0x0000)
+         *    Next header: ICMPv6 (0x3a)
+         *    Source: 2001:db8::1
+         *    Destination: 2001:db8::2 */ \
+        0xc0, 0xbc, 0x00, 0x0f, \
+        /*    IPHC Header
+         *        011. .... = Pattern: IP header compression (0x03)
+         *        ...1 1... .... .... = Version, traffic class, and flow label compressed (0x3)
+         *        .... .0.. .... .... = Next header: Inline
+         *        .... ..10 .... .... = Hop limit: 64 (0x2)
+         *        .... .... 0... .... = Context identifier extension: False
+         *        .... .... .0.. .... = Source address compression: Stateless
+         *        .... .... ..00 .... = Source address mode: Inline (0x0000)
+         *        .... .... .... 0... = Multicast address compression: False
+         *        .... .... .... .0.. = Destination address compression: Stateless
+         *        .... .... .... ..00 = Destination address mode: Inline (0x0000)
+         *    Next header: ICMPv6 (0x3a) */ \
+        0x7a, 0x00, 0x3a, \
+        /*    Source: 2001:db8::1 */ \
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, \
+        /*    Destination: 2001:db8::2 */ \
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, \
+        /* Internet Control Message Protocol v6
+         *    Type: Echo (ping) request (128)
+         *    Code: 0
+         *    Checksum: 0x8ea0
+         *    Identifier: 0x238f
+         *    Sequence: 2
+         *    [No response seen]
+         *    Data (140 bytes)
+         *        Data: 9d4bb21c5353535353535353535353535353535353535353…
+         */ \
+        0x80, 0x00, 0x8e, 0xa0, 0x23, 0x8f, 0x00, 0x02, \
+        0x9d, 0x4b, 0xb2, 0x1c, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+    }
+#define TEST_FRAGN_PAYLOAD { \
+        /* 6LoWPAN, Src: 2001:db8::1, Dest: 2001:db8::2
+         *    Fragmentation Header
+         *        1110 0... = Pattern: Subsequent fragment (0x1c)
+         *        Datagram size: 188
+         *        Datagram tag: 0x000f
+         *        Datagram offset: 104 */ \
+        0xe0, 0xbc, 0x00, 0x0f, 0x0d, \
+        /* Rest of ICMPv6 data (84 bytes) */ \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x53, \
+        0x53, 0x53, 0x53, 0x53, \
+    }
+#define TEST_TAG        (0x000f)
+#define TEST_DATAGRAM_SIZE  (188U)
+#define TEST_FRAGN_OFFSET   (104U)
+#define TEST_TGT_IPV6   { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                          0x48, 0x3d, 0x1d, 0x0c, 0x98, 0x31, 0x58, 0xae }
+#define TEST_SENT_NUMOF (2U)
+
+typedef struct {
+    uint8_t data[IEEE802154_FRAME_LEN_MAX];
+    size_t len;
+} _sent_frame_t;
+
+const uint8_t _test_src[] = TEST_SRC;
+const uint8_t _test_dst[] = TEST_DST;
+const uint8_t _test_6lo_payload[] = TEST_6LO_PAYLOAD;
+const uint8_t _test_fragn_payload[] = TEST_FRAGN_PAYLOAD;
+const ipv6_addr_t _test_tgt_ipv6 = { .u8 = TEST_TGT_IPV6 };
+
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _mock_dev;
+static gnrc_netif_t *_mock_netif;
+static _sent_frame_t _sent[TEST_SENT_NUMOF];
+static unsigned _sent_numof;
+static gnrc_sixlowpan_frag_stats_t _stats_before;
+
+static void _set_up(void)
+{
+    /* Add default route for the VRB entry created from */
+    gnrc_ipv6_nib_ft_add(NULL, 0, &_test_tgt_ipv6, _mock_netif->pid, 0);
+    memset(_sent, 0, sizeof(_sent));
+    _sent_numof = 0;
+    _stats_before = *gnrc_sixlowpan_frag_stats_get();
+}
+
+static void _tear_down(void)
+{
+    gnrc_ipv6_nib_ft_del(NULL, 0);
+    gnrc_sixlowpan_frag_rb_reset();
+    gnrc_sixlowpan_frag_vrb_reset();
+}
+
+static gnrc_pktsnip_t *_create_fragment(const uint8_t *data, size_t len)
+{
+    gnrc_pktsnip_t *res = gnrc_netif_hdr_build(_test_src, sizeof(_test_src),
+                                               _test_dst, sizeof(_test_dst));
+    if (res == NULL) {
+        return NULL;
+    }
+    gnrc_netif_hdr_set_netif(res->data, _mock_netif);
+    res = gnrc_pktbuf_add(res, data, len, GNRC_NETTYPE_SIXLOWPAN);
+    return res;
+}
+
+static unsigned _dispatch_to_6lowpan(gnrc_pktsnip_t *pkt)
+{
+    unsigned res = gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                                GNRC_NETREG_DEMUX_CTX_ALL,
+                                                pkt);
+    thread_yield_higher();
+    return res;
+}
+
+static bool _rb_is_empty(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *rb = gnrc_sixlowpan_frag_rb_array();
+
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rb[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_minfwd__frag1(void)
+{
+    gnrc_pktsnip_t *pkt = _create_fragment(_test_6lo_payload,
+                                           sizeof(_test_6lo_payload));
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    sixlowpan_frag_t *frag;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(1, _dispatch_to_6lowpan(pkt));
+    vrbe = gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src), TEST_TAG);
+    TEST_ASSERT_NOT_NULL(vrbe);
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    frag = (sixlowpan_frag_t *)_sent[0].data;
+    TEST_ASSERT(sixlowpan_frag_1_is(frag));
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE,
+                          sixlowpan_frag_datagram_size(frag));
+    TEST_ASSERT_EQUAL_INT(vrbe->out_tag, sixlowpan_frag_datagram_tag(frag));
+    /* re-compressed header follows fragmentation header */
+    TEST_ASSERT(sixlowpan_iphc_is(_sent[0].data + sizeof(sixlowpan_frag_t)));
+    TEST_ASSERT(_rb_is_empty());
+    TEST_ASSERT_EQUAL_INT(_stats_before.fwd_datagrams + 1,
+                          gnrc_sixlowpan_frag_stats_get()->fwd_datagrams);
+    TEST_ASSERT_EQUAL_INT(_stats_before.fwd_frags + 1,
+                          gnrc_sixlowpan_frag_stats_get()->fwd_frags);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_minfwd__fragn(void)
+{
+    gnrc_pktsnip_t *pkt;
+    sixlowpan_frag_n_t *frag;
+    uint16_t out_tag;
+
+    test_minfwd__frag1();
+    out_tag = gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                          TEST_TAG)->out_tag;
+    pkt = _create_fragment(_test_fragn_payload, sizeof(_test_fragn_payload));
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(1, _dispatch_to_6lowpan(pkt));
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(sizeof(_test_fragn_payload), _sent[1].len);
+    frag = (sixlowpan_frag_n_t *)_sent[1].data;
+    TEST_ASSERT(sixlowpan_frag_n_is((sixlowpan_frag_t *)frag));
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE,
+                          sixlowpan_frag_datagram_size((sixlowpan_frag_t *)frag));
+    TEST_ASSERT_EQUAL_INT(out_tag,
+                          sixlowpan_frag_datagram_tag((sixlowpan_frag_t *)frag));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGN_OFFSET, sixlowpan_frag_offset(frag));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_test_fragn_payload[sizeof(*frag)],
+                                    &_sent[1].data[sizeof(*frag)],
+                                    sizeof(_test_fragn_payload) -
+                                    sizeof(*frag)));
+    /* datagram is complete, so the VRB entry is removed */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                                 TEST_TAG));
+    TEST_ASSERT(_rb_is_empty());
+    TEST_ASSERT_EQUAL_INT(_stats_before.fwd_frags + 2,
+                          gnrc_sixlowpan_frag_stats_get()->fwd_frags);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_minfwd__fragn_no_vrbe(void)
+{
+    gnrc_pktsnip_t *pkt = _create_fragment(_test_fragn_payload,
+                                           sizeof(_test_fragn_payload));
+    const gnrc_sixlowpan_frag_rb_t *rb = gnrc_sixlowpan_frag_rb_array();
+    unsigned rbs = 0;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(1, _dispatch_to_6lowpan(pkt));
+    /* fragment is not forwarded, but ends up in reassembly buffer */
+    TEST_ASSERT_EQUAL_INT(0, _sent_numof);
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rb[i])) {
+            rbs++;
+            TEST_ASSERT_EQUAL_INT(TEST_TAG, rb[i].super.tag);
+            /* release packet for packet buffer check */
+            gnrc_pktbuf_release(rb[i].pkt);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(1, rbs);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_minfwd_forward__partial(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = {
+        .src = TEST_SRC,
+        .src_len = sizeof(_test_src),
+        .tag = TEST_TAG,
+        .datagram_size = TEST_DATAGRAM_SIZE,
+    };
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt = _create_fragment(_test_fragn_payload,
+                                           sizeof(_test_fragn_payload));
+
+    base.arrival = xtimer_now_usec();
+    vrbe = gnrc_sixlowpan_frag_vrb_add(&base, _mock_netif, _test_dst,
+                                       sizeof(_test_dst));
+    TEST_ASSERT_NOT_NULL(vrbe);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* pass fragment without link-layer header */
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_sixlowpan_frag_minfwd_forward(pkt, vrbe, 0));
+    thread_yield_higher();
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    /* first fragment is still missing, so VRB entry is kept */
+    TEST_ASSERT(vrbe == gnrc_sixlowpan_frag_vrb_get(_test_src,
+                                                    sizeof(_test_src),
+                                                    TEST_TAG));
+    TEST_ASSERT_EQUAL_INT(sizeof(_test_fragn_payload) -
+                          sizeof(sixlowpan_frag_n_t),
+                          vrbe->super.current_size);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_minfwd_forward__duplicate(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt = _create_fragment(_test_fragn_payload,
+                                           sizeof(_test_fragn_payload));
+
+    test_minfwd_forward__partial();
+    vrbe = gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src), TEST_TAG);
+    TEST_ASSERT_NOT_NULL(vrbe);
+    TEST_ASSERT_NOT_NULL(pkt);
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_sixlowpan_frag_minfwd_forward(pkt, vrbe, 0));
+    thread_yield_higher();
+    /* duplicate is neither forwarded nor counted */
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    TEST_ASSERT(vrbe == gnrc_sixlowpan_frag_vrb_get(_test_src,
+                                                    sizeof(_test_src),
+                                                    TEST_TAG));
+    TEST_ASSERT_EQUAL_INT(sizeof(_test_fragn_payload) -
+                          sizeof(sixlowpan_frag_n_t),
+                          vrbe->super.current_size);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_minfwd_forward__overlap(void)
+{
+    uint8_t overlap[sizeof(_test_fragn_payload)];
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt;
+
+    /* fragment starting 8 bytes earlier, overlapping the first one */
+    memcpy(overlap, _test_fragn_payload, sizeof(overlap));
+    ((sixlowpan_frag_n_t *)overlap)->offset = (TEST_FRAGN_OFFSET / 8) - 1;
+    pkt = _create_fragment(overlap, sizeof(overlap));
+    test_minfwd_forward__partial();
+    vrbe = gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src), TEST_TAG);
+    TEST_ASSERT_NOT_NULL(vrbe);
+    TEST_ASSERT_NOT_NULL(pkt);
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          gnrc_sixlowpan_frag_minfwd_forward(pkt, vrbe, 0));
+    thread_yield_higher();
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    /* datagram is discarded */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                                 TEST_TAG));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_minfwd_frag_iphc__too_large(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = {
+        .src = TEST_SRC,
+        .src_len = sizeof(_test_src),
+        .tag = TEST_TAG,
+        .datagram_size = TEST_DATAGRAM_SIZE,
+    };
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    /* just skip the fragmentation header to get something IPHC-like */
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, &_test_6lo_payload[1],
+                                          sizeof(_test_6lo_payload) - 1,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+
+    base.arrival = xtimer_now_usec();
+    vrbe = gnrc_sixlowpan_frag_vrb_add(&base, _mock_netif, _test_dst,
+                                       sizeof(_test_dst));
+    TEST_ASSERT_NOT_NULL(vrbe);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          gnrc_sixlowpan_frag_minfwd_frag_iphc(pkt, vrbe, 0));
+    thread_yield_higher();
+    TEST_ASSERT_EQUAL_INT(0, _sent_numof);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_minfwd__frag1),
+        new_TestFixture(test_minfwd__fragn),
+        new_TestFixture(test_minfwd__fragn_no_vrbe),
+        new_TestFixture(test_minfwd_forward__partial),
+        new_TestFixture(test_minfwd_forward__duplicate),
+        new_TestFixture(test_minfwd_forward__overlap),
+        new_TestFixture(test_minfwd_frag_iphc__too_large),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlo_minfwd_tests, _set_up, _tear_down, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&sixlo_minfwd_tests);
+    TESTS_END();
+}
+
+static int _send_netdev(netdev_t *netdev, const iolist_t *iolist)
+{
+    int res = 0;
+
+    (void)netdev;
+    if (_sent_numof >= TEST_SENT_NUMOF) {
+        return -ENOBUFS;
+    }
+    /* skip MAC header */
+    for (const iolist_t *ptr = iolist->iol_next; ptr != NULL;
+         ptr = ptr->iol_next) {
+        _sent_frame_t *frame = &_sent[_sent_numof];
+
+        if ((frame->len + ptr->iol_len) > sizeof(frame->data)) {
+            return -ENOBUFS;
+        }
+        memcpy(&frame->data[frame->len], ptr->iol_base, ptr->iol_len);
+        frame->len += ptr->iol_len;
+        res += ptr->iol_len;
+    }
+    _sent_numof++;
+    return res + iolist->iol_len;
+}
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_netdev_max_pdu_size(netdev_t *netdev, void *value,
+                                    size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = sizeof(_test_6lo_payload);
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_test_dst);
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    assert(max_len >= sizeof(_test_dst));
+    memcpy(value, _test_dst, sizeof(_test_dst));
+    return sizeof(_test_dst);
+}
+
+static void _init_mock_netif(void)
+{
+    netdev_test_setup(&_mock_dev, NULL);
+    netdev_test_set_send_cb(&_mock_dev, _send_netdev);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_DEVICE_TYPE,
+                           _get_netdev_device_type);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_PROTO,
+                           _get_netdev_proto);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_MAX_PDU_SIZE,
+                           _get_netdev_max_pdu_size);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_SRC_LEN,
+                           _get_netdev_src_len);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_ADDRESS_LONG,
+                           _get_netdev_addr_long);
+    _mock_netif = gnrc_netif_ieee802154_create(
+            _mock_netif_stack, THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+            "mock_netif", (netdev_t *)&_mock_dev);
+    thread_yield_higher();
+}
+
+int main(void)
+{
+    _init_mock_netif();
+    run_unittests();
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the deferred binary log module
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "log.h"
+
+static uint8_t _records[LOG_BINARY_BUFFER_SIZE];
+
+static void _print_records(void)
+{
+    size_t len = log_binary_read(_records, sizeof(_records));
+
+    for (size_t pos = 0; pos < len;) {
+        pos += log_binary_print(&_records[pos]);
+    }
+}
+
+int main(void)
+{
+    char str[] = "test";
+    /* not terminated, only read up to the precision */
+    const char chars[] = { 'a', 'b', 'c' };
+    unsigned logged = 0;
+
+    LOG_ERROR("Logging value '%d' and string '%s'\n", 42, str);
+    LOG_WARNING("Logging long '%ld', hex '0x%04x' and char '%c'\n",
+                -1234567L, 0xbeefU, 'R');
+    LOG_INFO("Logging padded '%*u' and unsigned long long '%llu'\n",
+             6, 17U, 12345678901ULL);
+    LOG_DEBUG("Logging size '%zu' and percent '%%'\n", sizeof(str));
+    LOG_INFO("Logging precision '%.3s', '%.*s' and '%.2s'\n",
+             chars, 2, str, str);
+    LOG_INFO("Logging long double '%.2Lf'\n", 2.5L);
+    /* the string must have been copied */
+    strcpy(str, "gone");
+    _print_records();
+
+    while (log_binary_dropped() == 0) {
+        LOG_INFO("Filling buffer %u\n", logged++);
+    }
+    _print_records();
+    printf("logged %u, dropped %u\n", logged, log_binary_dropped());
+    puts("SUCCESS");
+    return 0;
+}
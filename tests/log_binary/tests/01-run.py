@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Logging value '42' and string 'test'")
+    child.expect_exact("Logging long '-1234567', hex '0xbeef' and char 'R'")
+    child.expect_exact("Logging padded '    17' and unsigned long long "
+                       "'12345678901'")
+    child.expect_exact("Logging size '5' and percent '%'")
+    child.expect_exact("Logging precision 'abc', 'te' and 'te'")
+    child.expect_exact("Logging long double '2.50'")
+    child.expect(r"Filling buffer (\d+)\r\nlogged (\d+), dropped 1")
+    # the last message was dropped
+    assert int(child.match.group(1)) == int(child.match.group(2)) - 2
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
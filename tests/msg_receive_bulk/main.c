@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief Test application for msg_receive_bulk() with blocked senders
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+
+#define QUEUE_SIZE          (2U)
+#define MSG_NUMOF           (8U)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static msg_t _queue[QUEUE_SIZE];
+
+static kernel_pid_t _main_pid;
+static volatile unsigned _sent;
+
+static void *_sender(void *arg)
+{
+    (void)arg;
+
+    for (unsigned i = 0; i < MSG_NUMOF; i++) {
+        msg_t msg = { .content.value = i };
+
+        /* blocks while the queue of the main thread is full */
+        msg_send(&msg, _main_pid);
+        _sent++;
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t msgs[QUEUE_SIZE];
+    unsigned received = 0;
+
+    _main_pid = thread_getpid();
+    msg_init_queue(_queue, QUEUE_SIZE);
+
+    /* fills the queue and blocks on the next message */
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _sender, NULL, "sender");
+    printf("sent %u messages before the first receive\n", _sent);
+
+    while (received < MSG_NUMOF) {
+        unsigned sent = _sent;
+        int n = msg_receive_bulk(msgs, QUEUE_SIZE);
+
+        for (int i = 0; i < n; i++) {
+            if (msgs[i].content.value != received) {
+                printf("got message %" PRIu32 ", expected %u\n",
+                       msgs[i].content.value, received);
+                puts("[FAILED]");
+                return 1;
+            }
+            received++;
+        }
+        /* the blocked sender got space in the queue and ran again */
+        if ((_sent < MSG_NUMOF) && (_sent != sent + n)) {
+            printf("sender still blocked after receiving %u messages\n",
+                   received);
+            puts("[FAILED]");
+            return 1;
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test the SPI NOR flash driver against a mocked bus
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "mtd.h"
+#include "mtd_spi_nor.h"
+
+#include "spi_mock.h"
+
+#define PAGE_SIZE           (SPI_MOCK_PAGE_SIZE)
+#define PAGES_PER_SECTOR    (16U)
+#define SECTOR_SIZE         (PAGE_SIZE * PAGES_PER_SECTOR)
+
+#define OP_READ             (0x03)
+#define OP_READ_FAST        (0x0b)
+#define OP_PP               (0x02)
+#define OP_SE_4K            (0x20)
+#define OP_BE_32K           (0x52)
+#define OP_BE               (0xd8)
+#define OP_CE               (0xc7)
+
+static uint8_t _wbuf[PAGE_SIZE];
+static uint8_t _buf[2 * PAGE_SIZE];
+static uint8_t _data[2 * PAGE_SIZE];
+
+static mtd_spi_nor_t _dev = {
+    .base = {
+        .driver = &mtd_spi_nor_driver,
+        .page_size = PAGE_SIZE,
+        .pages_per_sector = PAGES_PER_SECTOR,
+        .sector_count = SPI_MOCK_SIZE / SECTOR_SIZE,
+    },
+    .opcode = &mtd_spi_nor_opcode_default,
+    .spi = SPI_DEV(0),
+    .cs = SPI_CS_UNDEF,
+    .mode = SPI_MODE_0,
+    .clk = SPI_CLK_10MHZ,
+    .addr_width = 3,
+};
+
+static mtd_dev_t *_mtd = &_dev.base;
+
+static void _assert_cmd(unsigned idx, uint8_t opcode, uint32_t addr,
+                        uint32_t len)
+{
+    TEST_ASSERT_EQUAL_INT(0, spi_mock_errors);
+    TEST_ASSERT(idx < spi_mock_log_len);
+    TEST_ASSERT_EQUAL_INT(opcode, spi_mock_log[idx].opcode);
+    TEST_ASSERT_EQUAL_INT(addr, spi_mock_log[idx].addr);
+    TEST_ASSERT_EQUAL_INT(len, spi_mock_log[idx].len);
+}
+
+static void _setup(uint16_t flag, uint8_t *wbuf)
+{
+    spi_mock_reset();
+    _dev.flag = flag;
+    _dev.wbuf = wbuf;
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(_mtd));
+    spi_mock_log_len = 0;
+
+    for (unsigned i = 0; i < sizeof(_data); i++) {
+        _data[i] = i * 7 + 1;
+    }
+}
+
+static void setUp(void)
+{
+    _setup(SPI_NOR_F_SECT_4K | SPI_NOR_F_SECT_32K | SPI_NOR_F_SECT_64K |
+           SPI_NOR_F_FAST_READ, _wbuf);
+}
+
+static void test_mtd_spi_nor_read_across_pages(void)
+{
+    memcpy(&spi_mock_flash[PAGE_SIZE - 10], _data, 20);
+
+    TEST_ASSERT_EQUAL_INT(20, mtd_read(_mtd, _buf, PAGE_SIZE - 10, 20));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, _data, 20));
+    /* a single command, with the dummy byte of the fast read */
+    TEST_ASSERT_EQUAL_INT(1, spi_mock_log_len);
+    _assert_cmd(0, OP_READ_FAST, PAGE_SIZE - 10, 20);
+    TEST_ASSERT_EQUAL_INT(1, spi_mock_log[0].dummy);
+}
+
+static void test_mtd_spi_nor_read_slow(void)
+{
+    _setup(SPI_NOR_F_SECT_4K, _wbuf);
+    memcpy(&spi_mock_flash[PAGE_SIZE], _data, 20);
+
+    TEST_ASSERT_EQUAL_INT(20, mtd_read(_mtd, _buf, PAGE_SIZE, 20));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, _data, 20));
+    _assert_cmd(0, OP_READ, PAGE_SIZE, 20);
+    TEST_ASSERT_EQUAL_INT(0, spi_mock_log[0].dummy);
+}
+
+static void test_mtd_spi_nor_write_partial(void)
+{
+    const uint32_t addr = PAGE_SIZE + 5;
+
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(_mtd, _data, addr, 10));
+    /* collected in the buffer */
+    TEST_ASSERT_EQUAL_INT(0, spi_mock_log_len);
+
+    /* a read of the buffered range programs the buffer first */
+    TEST_ASSERT_EQUAL_INT(10, mtd_read(_mtd, _buf, addr, 10));
+    TEST_ASSERT_EQUAL_INT(2, spi_mock_log_len);
+    _assert_cmd(0, OP_PP, addr, 10);
+    _assert_cmd(1, OP_READ_FAST, addr, 10);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, _data, 10));
+}
+
+static void test_mtd_spi_nor_write_consecutive(void)
+{
+    const uint32_t addr = 2 * PAGE_SIZE;
+
+    for (unsigned i = 0; i < PAGE_SIZE; i += 64) {
+        TEST_ASSERT_EQUAL_INT(64, mtd_write(_mtd, &_data[i], addr + i, 64));
+    }
+    /* programmed at once when the page is complete */
+    TEST_ASSERT_EQUAL_INT(1, spi_mock_log_len);
+    _assert_cmd(0, OP_PP, addr, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&spi_mock_flash[addr], _data, PAGE_SIZE));
+}
+
+static void test_mtd_spi_nor_write_non_consecutive(void)
+{
+    const uint32_t addr = 3 * PAGE_SIZE;
+
+    TEST_ASSERT_EQUAL_INT(16, mtd_write(_mtd, _data, addr, 16));
+    TEST_ASSERT_EQUAL_INT(16, mtd_write(_mtd, &_data[32], addr + 32, 16));
+    /* the gap programs the first part */
+    TEST_ASSERT_EQUAL_INT(1, spi_mock_log_len);
+    _assert_cmd(0, OP_PP, addr, 16);
+
+    /* a write to another page programs the second part */
+    TEST_ASSERT_EQUAL_INT(16, mtd_write(_mtd, _data, 5 * PAGE_SIZE, 16));
+    TEST_ASSERT_EQUAL_INT(2, spi_mock_log_len);
+    _assert_cmd(1, OP_PP, addr + 32, 16);
+
+    mtd_spi_nor_flush(&_dev);
+    TEST_ASSERT_EQUAL_INT(3, spi_mock_log_len);
+    _assert_cmd(2, OP_PP, 5 * PAGE_SIZE, 16);
+
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&spi_mock_flash[addr], _data, 16));
+    TEST_ASSERT_EQUAL_INT(0xff, spi_mock_flash[addr + 16]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&spi_mock_flash[addr + 32], &_data[32], 16));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&spi_mock_flash[5 * PAGE_SIZE], _data, 16));
+
+    /* nothing left to flush */
+    mtd_spi_nor_flush(&_dev);
+    TEST_ASSERT_EQUAL_INT(3, spi_mock_log_len);
+}
+
+static void test_mtd_spi_nor_write_page_boundary(void)
+{
+    const uint32_t addr = 4 * PAGE_SIZE + 100;
+
+    TEST_ASSERT_EQUAL_INT(100, mtd_write(_mtd, _data, addr, 100));
+    /* would run past the buffered page */
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW,
+                          mtd_write(_mtd, &_data[100], addr + 100, 100));
+    /* ends exactly at the end of the page */
+    TEST_ASSERT_EQUAL_INT(56, mtd_write(_mtd, &_data[100], addr + 100, 56));
+    TEST_ASSERT_EQUAL_INT(1, spi_mock_log_len);
+    _assert_cmd(0, OP_PP, addr, 156);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&spi_mock_flash[addr], _data, 156));
+    TEST_ASSERT_EQUAL_INT(0xff, spi_mock_flash[5 * PAGE_SIZE]);
+}
+
+static void test_mtd_spi_nor_write_full_page(void)
+{
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, mtd_write(_mtd, _data, 0, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, spi_mock_log_len);
+    _assert_cmd(0, OP_PP, 0, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(spi_mock_flash, _data, PAGE_SIZE));
+}
+
+static void test_mtd_spi_nor_write_unbuffered(void)
+{
+    _setup(SPI_NOR_F_SECT_4K, NULL);
+
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(_mtd, _data, 0, 10));
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(_mtd, &_data[10], 10, 10));
+    TEST_ASSERT_EQUAL_INT(2, spi_mock_log_len);
+    _assert_cmd(0, OP_PP, 0, 10);
+    _assert_cmd(1, OP_PP, 10, 10);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(spi_mock_flash, _data, 20));
+}
+
+static void test_mtd_spi_nor_erase_largest(void)
+{
+    /* 7 sectors up to the first 32 KiB boundary, one 32 KiB block up to the
+     * first 64 KiB boundary, then a 64 KiB block */
+    memset(spi_mock_flash, 0, SPI_MOCK_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(_mtd, SECTOR_SIZE,
+                                       SPI_MOCK_SIZE - SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(9, spi_mock_log_len);
+    for (unsigned i = 0; i < 7; i++) {
+        _assert_cmd(i, OP_SE_4K, (i + 1) * SECTOR_SIZE, 0);
+    }
+    _assert_cmd(7, OP_BE_32K, 0x8000, 0);
+    _assert_cmd(8, OP_BE, 0x10000, 0);
+
+    TEST_ASSERT_EQUAL_INT(0, spi_mock_flash[SECTOR_SIZE - 1]);
+    for (unsigned i = SECTOR_SIZE; i < SPI_MOCK_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0xff, spi_mock_flash[i]);
+    }
+}
+
+static void test_mtd_spi_nor_erase_chip(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(_mtd, 0, SPI_MOCK_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, spi_mock_log_len);
+    _assert_cmd(0, OP_CE, 0, 0);
+}
+
+static void test_mtd_spi_nor_erase_sectors_only(void)
+{
+    /* without SPI_NOR_F_SECT_64K the block erase erases one MTD sector */
+    _setup(SPI_NOR_F_SECT_4K, _wbuf);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(_mtd, 0x10000, 2 * SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(2, spi_mock_log_len);
+    _assert_cmd(0, OP_SE_4K, 0x10000, 0);
+    _assert_cmd(1, OP_SE_4K, 0x10000 + SECTOR_SIZE, 0);
+}
+
+static void test_mtd_spi_nor_erase_flushes(void)
+{
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(_mtd, _data, 0, 10));
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(_mtd, SECTOR_SIZE, SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(2, spi_mock_log_len);
+    _assert_cmd(0, OP_PP, 0, 10);
+    _assert_cmd(1, OP_SE_4K, SECTOR_SIZE, 0);
+}
+
+static void test_mtd_spi_nor_erase_unaligned(void)
+{
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(_mtd, PAGE_SIZE, SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(_mtd, 0, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, spi_mock_log_len);
+    TEST_ASSERT_EQUAL_INT(0, spi_mock_errors);
+}
+
+static void test_mtd_spi_nor_power_down_flushes(void)
+{
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(_mtd, _data, 0, 10));
+    TEST_ASSERT_EQUAL_INT(0, mtd_power(_mtd, MTD_POWER_DOWN));
+    TEST_ASSERT_EQUAL_INT(2, spi_mock_log_len);
+    _assert_cmd(0, OP_PP, 0, 10);
+    TEST_ASSERT_EQUAL_INT(_dev.opcode->sleep, spi_mock_log[1].opcode);
+    TEST_ASSERT_EQUAL_INT(0, mtd_power(_mtd, MTD_POWER_UP));
+    TEST_ASSERT_EQUAL_INT(0, spi_mock_errors);
+}
+
+static Test *tests_mtd_spi_nor(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_spi_nor_read_across_pages),
+        new_TestFixture(test_mtd_spi_nor_read_slow),
+        new_TestFixture(test_mtd_spi_nor_write_partial),
+        new_TestFixture(test_mtd_spi_nor_write_consecutive),
+        new_TestFixture(test_mtd_spi_nor_write_non_consecutive),
+        new_TestFixture(test_mtd_spi_nor_write_page_boundary),
+        new_TestFixture(test_mtd_spi_nor_write_full_page),
+        new_TestFixture(test_mtd_spi_nor_write_unbuffered),
+        new_TestFixture(test_mtd_spi_nor_erase_largest),
+        new_TestFixture(test_mtd_spi_nor_erase_chip),
+        new_TestFixture(test_mtd_spi_nor_erase_sectors_only),
+        new_TestFixture(test_mtd_spi_nor_erase_flushes),
+        new_TestFixture(test_mtd_spi_nor_erase_unaligned),
+        new_TestFixture(test_mtd_spi_nor_power_down_flushes),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_spi_nor_tests, setUp, NULL, fixtures);
+
+    return (Test *)&mtd_spi_nor_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_mtd_spi_nor());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       The driver under test, built against the SPI mock
+ *
+ * @}
+ */
+
+#include "../../drivers/mtd_spi_nor/mtd_spi_nor.c"
+#include "../../drivers/mtd_spi_nor/mtd_spi_nor_configs.c"
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI mock emulating a SPI NOR flash with 3 byte addresses
+ *
+ * Uses the opcodes of mtd_spi_nor_opcode_default.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "periph/spi.h"
+#include "spi_mock.h"
+
+#define ADDR_WIDTH      (3U)
+
+#define OP_RDID         (0x9f)
+#define OP_WREN         (0x06)
+#define OP_RDSR         (0x05)
+#define OP_READ         (0x03)
+#define OP_READ_FAST    (0x0b)
+#define OP_PP           (0x02)
+#define OP_SE_4K        (0x20)
+#define OP_BE_32K       (0x52)
+#define OP_BE_64K       (0xd8)
+#define OP_CE           (0xc7)
+
+uint8_t spi_mock_flash[SPI_MOCK_SIZE];
+spi_mock_cmd_t spi_mock_log[SPI_MOCK_LOG_SIZE];
+unsigned spi_mock_log_len;
+unsigned spi_mock_errors;
+
+static const uint8_t _jedec_id[] = { 0xef, 0x40, 0x17 };
+
+static struct {
+    bool acquired;
+    bool active;                /* chip select asserted */
+    bool wel;                   /* write enable latch */
+    unsigned pos;               /* bytes after the opcode */
+    spi_mock_cmd_t cmd;
+} _state;
+
+void spi_mock_reset(void)
+{
+    memset(spi_mock_flash, 0xff, sizeof(spi_mock_flash));
+    memset(&_state, 0, sizeof(_state));
+    spi_mock_log_len = 0;
+    spi_mock_errors = 0;
+}
+
+static bool _has_addr(uint8_t opcode)
+{
+    switch (opcode) {
+    case OP_READ:
+    case OP_READ_FAST:
+    case OP_PP:
+    case OP_SE_4K:
+    case OP_BE_32K:
+    case OP_BE_64K:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void _erase(uint32_t size)
+{
+    uint32_t addr = _state.cmd.addr & ~(size - 1);
+
+    if (!_state.wel || (_state.cmd.len != 0)) {
+        spi_mock_errors++;
+        return;
+    }
+    memset(&spi_mock_flash[addr % SPI_MOCK_SIZE], 0xff, size);
+}
+
+static uint8_t _xfer(uint8_t out)
+{
+    spi_mock_cmd_t *cmd = &_state.cmd;
+    uint8_t in = 0xff;
+
+    if (!_state.active) {
+        _state.active = true;
+        _state.pos = 0;
+        memset(cmd, 0, sizeof(*cmd));
+        cmd->opcode = out;
+        return in;
+    }
+    _state.pos++;
+    if (_has_addr(cmd->opcode) && (_state.pos <= ADDR_WIDTH)) {
+        cmd->addr = (cmd->addr << 8) | out;
+        return in;
+    }
+
+    switch (cmd->opcode) {
+    case OP_RDID:
+        in = _jedec_id[(_state.pos - 1) % sizeof(_jedec_id)];
+        break;
+    case OP_RDSR:
+        /* never busy */
+        in = 0;
+        break;
+    case OP_READ_FAST:
+        if (_state.pos == ADDR_WIDTH + 1) {
+            cmd->dummy++;
+            break;
+        }
+        /* fall through */
+    case OP_READ:
+        in = spi_mock_flash[(cmd->addr + cmd->len++) % SPI_MOCK_SIZE];
+        break;
+    case OP_PP: {
+        /* the address wraps around within the page, as on a real chip */
+        uint32_t page = cmd->addr & ~(SPI_MOCK_PAGE_SIZE - 1);
+        uint32_t off = (cmd->addr + cmd->len++) % SPI_MOCK_PAGE_SIZE;
+        spi_mock_flash[(page + off) % SPI_MOCK_SIZE] &= out;
+        break;
+    }
+    default:
+        cmd->len++;
+        break;
+    }
+
+    return in;
+}
+
+static void _end(void)
+{
+    _state.active = false;
+
+    switch (_state.cmd.opcode) {
+    case OP_WREN:
+        _state.wel = true;
+        return;
+    case OP_RDSR:
+    case OP_RDID:
+        return;
+    case OP_PP:
+        if (!_state.wel || (_state.cmd.len == 0) ||
+            (_state.cmd.len > SPI_MOCK_PAGE_SIZE)) {
+            spi_mock_errors++;
+        }
+        break;
+    case OP_SE_4K:
+        _erase(4096);
+        break;
+    case OP_BE_32K:
+        _erase(32768);
+        break;
+    case OP_BE_64K:
+        _erase(65536);
+        break;
+    case OP_CE:
+        _erase(SPI_MOCK_SIZE);
+        break;
+    default:
+        break;
+    }
+    _state.wel = false;
+
+    if (spi_mock_log_len < SPI_MOCK_LOG_SIZE) {
+        spi_mock_log[spi_mock_log_len++] = _state.cmd;
+    }
+    else {
+        spi_mock_errors++;
+    }
+}
+
+int spi_init_cs(spi_t bus, spi_cs_t cs)
+{
+    (void)bus;
+    (void)cs;
+    return SPI_OK;
+}
+
+int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
+{
+    (void)bus;
+    (void)cs;
+    (void)mode;
+    (void)clk;
+    if (_state.acquired) {
+        spi_mock_errors++;
+    }
+    _state.acquired = true;
+    return SPI_OK;
+}
+
+void spi_release(spi_t bus)
+{
+    (void)bus;
+    if (!_state.acquired || _state.active) {
+        spi_mock_errors++;
+    }
+    _state.acquired = false;
+}
+
+uint8_t spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont, uint8_t out)
+{
+    uint8_t in;
+
+    spi_transfer_bytes(bus, cs, cont, &out, &in, 1);
+    return in;
+}
+
+void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
+                        const void *out, void *in, size_t len)
+{
+    const uint8_t *out_buf = out;
+    uint8_t *in_buf = in;
+
+    (void)bus;
+    (void)cs;
+    /* most implementations assert this */
+    if (!_state.acquired || (!out && !in)) {
+        spi_mock_errors++;
+    }
+    for (size_t i = 0; i < len; i++) {
+        uint8_t tmp = _xfer(out_buf ? out_buf[i] : 0);
+        if (in_buf) {
+            in_buf[i] = tmp;
+        }
+    }
+    if (!cont) {
+        _end();
+    }
+}
+
+uint8_t spi_transfer_reg(spi_t bus, spi_cs_t cs, uint8_t reg, uint8_t out)
+{
+    spi_transfer_bytes(bus, cs, true, &reg, NULL, 1);
+    return spi_transfer_byte(bus, cs, false, out);
+}
+
+void spi_transfer_regs(spi_t bus, spi_cs_t cs, uint8_t reg,
+                       const void *out, void *in, size_t len)
+{
+    spi_transfer_bytes(bus, cs, true, &reg, NULL, 1);
+    spi_transfer_bytes(bus, cs, false, out, in, len);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI mock emulating a SPI NOR flash with 3 byte addresses
+ */
+
+#ifndef SPI_MOCK_H
+#define SPI_MOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPI_MOCK_PAGE_SIZE      (256U)              /**< page size */
+#define SPI_MOCK_SIZE           (128U * 1024U)      /**< size of the flash */
+#define SPI_MOCK_LOG_SIZE       (64U)               /**< logged commands */
+
+/**
+ * @brief   A logged command
+ *
+ * All commands but read status and write enable are logged.
+ */
+typedef struct {
+    uint8_t opcode;             /**< opcode of the command */
+    uint32_t addr;              /**< address sent with the command */
+    uint32_t len;               /**< number of data bytes */
+    uint8_t dummy;              /**< number of dummy bytes of a fast read */
+} spi_mock_cmd_t;
+
+extern uint8_t spi_mock_flash[SPI_MOCK_SIZE];           /**< flash content */
+extern spi_mock_cmd_t spi_mock_log[SPI_MOCK_LOG_SIZE];  /**< command log */
+extern unsigned spi_mock_log_len;                       /**< logged commands */
+/**
+ * @brief   Number of protocol errors, e.g. a program without write enable
+ *          or a transfer without any buffer
+ */
+extern unsigned spi_mock_errors;
+
+/**
+ * @brief   Erase the flash and clear the log and the errors
+ */
+void spi_mock_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_MOCK_H */
+/** @} */
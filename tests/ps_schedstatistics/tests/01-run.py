@@ -11,24 +11,26 @@ from testrunner import run
 
 PS_EXPECTED = (
     (r'\tpid | name                 | state    Q | pri | stack  \( used\) | '
-     r'base addr  | current     | runtime  | switches'),
+     r'base addr  | current     | runtime  | switches  | window'),
     (r'\t  - | isr_stack            | -        - |   - | \d+  \( -?\d+\) | '
      r'0x\d+ | 0x\d+'),
     (r'\t  1 | idle                 | pending  Q |  15 | \d+  \( -?\d+\) | '
-     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+\.\d%'),
     (r'\t  2 | main                 | running  Q |   7 | \d+  \( -?\d+\) | '
-     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+\.\d%'),
     (r'\t  3 | thread               | bl rx    _ |   6 | \d+  \( -?\d+\) | '
-     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+\.\d%'),
     (r'\t  4 | thread               | bl rx    _ |   6 | \d+  \( -?\d+\) | '
-     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+\.\d%'),
     (r'\t  5 | thread               | bl rx    _ |   6 | \d+  \( -?\d+\) | '
-     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+\.\d%'),
     (r'\t  6 | thread               | bl mutex _ |   6 | \d+  \( -?\d+\) | '
-     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+\.\d%'),
     (r'\t  7 | thread               | bl rx    _ |   6 | \d+  \( -?\d+\) | '
-     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
-    (r'\t    | SUM                  |            |     | \d+  \(\d+\)')
+     r'0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+\.\d%'),
+    (r'\t    | SUM                  |            |     | \d+  \(\d+\)'),
+    (r'\tISR: \d+ calls, \d+ ticks, last window \d+\.\d% of \d+ ticks'),
+    (r'\tlatency pri  6: \d+ wakeups, mean \d+ max \d+ ticks'),
 )
 
 
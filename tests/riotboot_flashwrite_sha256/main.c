@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup    tests
+ * @{
+ *
+ * @file
+ * @brief      Tests for the digest computed by riotboot_flashwrite while
+ *             writing an image
+ *
+ * The image is written to the slot that is not running, so the image
+ * stored there is overwritten.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "hashes/sha256.h"
+#include "riotboot/flashwrite.h"
+#include "riotboot/slot.h"
+
+/* spans more than two pages and ends in a partially filled one */
+#define IMG_SIZE        ((2 * FLASHPAGE_SIZE) + 100)
+#define CHUNK_SIZE      (64U)
+
+static riotboot_flashwrite_t _writer;
+static uint8_t _digest[SHA256_DIGEST_LENGTH];
+
+static uint8_t _img_byte(size_t pos)
+{
+    return (uint8_t)((pos * 7) + (pos >> 8));
+}
+
+static void _fill(uint8_t *buf, size_t pos, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = _img_byte(pos + i);
+    }
+}
+
+static void set_up(void)
+{
+    sha256_context_t sha256;
+    uint8_t chunk[CHUNK_SIZE];
+
+    sha256_init(&sha256);
+    sha256_update(&sha256, "RIOT", RIOTBOOT_FLASHWRITE_SKIPLEN);
+    for (size_t pos = RIOTBOOT_FLASHWRITE_SKIPLEN; pos < IMG_SIZE;
+         pos += CHUNK_SIZE) {
+        size_t len = ((IMG_SIZE - pos) < CHUNK_SIZE) ? (IMG_SIZE - pos)
+                                                     : CHUNK_SIZE;
+
+        _fill(chunk, pos, len);
+        sha256_update(&sha256, chunk, len);
+    }
+    sha256_final(&sha256, _digest);
+}
+
+/* writes the image without its magic number, like SUIT does */
+static void _write_image(size_t size)
+{
+    uint8_t chunk[CHUNK_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, riotboot_flashwrite_init(&_writer,
+                                                      riotboot_slot_other()));
+    for (size_t pos = RIOTBOOT_FLASHWRITE_SKIPLEN; pos < size;
+         pos += CHUNK_SIZE) {
+        size_t len = ((size - pos) < CHUNK_SIZE) ? (size - pos) : CHUNK_SIZE;
+        bool more = (pos + len) < size;
+
+        _fill(chunk, pos, len);
+        TEST_ASSERT_EQUAL_INT(0, riotboot_flashwrite_putbytes(&_writer, chunk,
+                                                              len, more));
+    }
+}
+
+static void test_riotboot_flashwrite_sha256__stream(void)
+{
+    _write_image(IMG_SIZE);
+    TEST_ASSERT_EQUAL_INT(IMG_SIZE, _writer.offset);
+    TEST_ASSERT_EQUAL_INT(0, riotboot_flashwrite_verify_sha256_stream(
+                              &_writer, _digest, IMG_SIZE));
+}
+
+static void test_riotboot_flashwrite_sha256__stream_matches_flash(void)
+{
+    _write_image(IMG_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, riotboot_flashwrite_verify_sha256(
+                              _digest, IMG_SIZE, riotboot_slot_other()));
+    TEST_ASSERT_EQUAL_INT(0, riotboot_flashwrite_verify_sha256_stream(
+                              &_writer, _digest, IMG_SIZE));
+}
+
+static void test_riotboot_flashwrite_sha256__stream_bad_digest(void)
+{
+    _write_image(IMG_SIZE);
+    _digest[SHA256_DIGEST_LENGTH - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(1, riotboot_flashwrite_verify_sha256_stream(
+                              &_writer, _digest, IMG_SIZE));
+}
+
+static void test_riotboot_flashwrite_sha256__stream_bad_size(void)
+{
+    /* the digest would match, but the download ended early */
+    _write_image(IMG_SIZE - 1);
+    TEST_ASSERT_EQUAL_INT(1, riotboot_flashwrite_verify_sha256_stream(
+                              &_writer, _digest, IMG_SIZE));
+    TEST_ASSERT_EQUAL_INT(-1, riotboot_flashwrite_verify_sha256_stream(
+                              &_writer, _digest, 3));
+}
+
+static void test_riotboot_flashwrite_sha256__readback(void)
+{
+    const uint8_t *slot = (const uint8_t *)riotboot_slot_get_hdr(
+        riotboot_slot_other());
+
+    TEST_ASSERT_EQUAL_INT(1, CONFIG_RIOTBOOT_FLASHWRITE_READBACK);
+    /* every page written passed the read back, check the flash anyway */
+    _write_image(IMG_SIZE);
+    for (size_t pos = RIOTBOOT_FLASHWRITE_SKIPLEN; pos < IMG_SIZE; pos++) {
+        TEST_ASSERT_EQUAL_INT(_img_byte(pos), slot[pos]);
+    }
+}
+
+Test *tests_riotboot_flashwrite_sha256(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_riotboot_flashwrite_sha256__stream),
+        new_TestFixture(test_riotboot_flashwrite_sha256__stream_matches_flash),
+        new_TestFixture(test_riotboot_flashwrite_sha256__stream_bad_digest),
+        new_TestFixture(test_riotboot_flashwrite_sha256__stream_bad_size),
+        new_TestFixture(test_riotboot_flashwrite_sha256__readback),
+    };
+
+    EMB_UNIT_TESTCALLER(riotboot_flashwrite_sha256_tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&riotboot_flashwrite_sha256_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_riotboot_flashwrite_sha256());
+    TESTS_END();
+    return 0;
+}
+/** @} */
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the SUIT CoAP block-wise download
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "msg.h"
+#include "net/nanocoap.h"
+#include "net/sock/udp.h"
+#include "shell.h"
+#include "suit/coap.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE (4)
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+/* the self test fetches a resource from a server on the loopback address
+ * that drops the first request for one block */
+#define SELFTEST_URL        "coap://[::1]/selftest"
+#define SELFTEST_SZX        (COAP_BLOCKSIZE_64)
+#define SELFTEST_BLOCKS     (16U)
+#define SELFTEST_SIZE       (SELFTEST_BLOCKS * 64U)
+/* a block that is requested once the window is fully open */
+#define SELFTEST_DROP       (SUIT_COAP_WINDOW_SIZE)
+#define SELFTEST_REQS_MAX   (4 * SELFTEST_BLOCKS)
+/* space for the header and options of a request or response */
+#define HDR_BUF_SIZE        (64U)
+
+typedef struct {
+    uint16_t id;
+    uint16_t num;
+} _request_t;
+
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static _request_t _requests[SELFTEST_REQS_MAX];
+static unsigned _requests_numof;
+
+typedef struct {
+    size_t offset;
+    uint32_t checksum;
+    bool verify;        /* compare with the resource of the self test */
+} _download_t;
+
+static uint8_t _selftest_byte(size_t offset)
+{
+    return (uint8_t)((offset * 7) + (offset >> 8));
+}
+
+static void _server_reply(sock_udp_t *sock, const sock_udp_ep_t *remote,
+                          uint16_t id, const coap_block1_t *block2)
+{
+    uint8_t buf[HDR_BUF_SIZE + 64U];
+    uint8_t *pos = buf;
+    size_t offset = block2->offset;
+    size_t len = (offset < SELFTEST_SIZE) ? SELFTEST_SIZE - offset : 0;
+    unsigned more;
+
+    if (len > coap_szx2size(block2->szx)) {
+        len = coap_szx2size(block2->szx);
+    }
+    more = ((offset + len) < SELFTEST_SIZE);
+    pos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_ACK, NULL, 0,
+                          COAP_CODE_205, id);
+    pos += coap_opt_put_uint(pos, 0, COAP_OPT_BLOCK2,
+                             ((offset >> (block2->szx + 4)) << 4) |
+                             (more << 3) | block2->szx);
+    if (len > 0) {
+        *pos++ = 0xff;
+        for (size_t i = 0; i < len; i++) {
+            *pos++ = _selftest_byte(offset + i);
+        }
+    }
+    sock_udp_send(sock, buf, pos - buf, remote);
+}
+
+static void *_server(void *arg)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = COAP_PORT };
+    sock_udp_t sock;
+    uint8_t buf[HDR_BUF_SIZE];
+    bool dropped = false;
+
+    (void)arg;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("selftest: unable to create server sock");
+        return NULL;
+    }
+    while (1) {
+        sock_udp_ep_t remote;
+        coap_pkt_t pkt;
+        coap_block1_t block2;
+        ssize_t len = sock_udp_recv(&sock, buf, sizeof(buf), SOCK_NO_TIMEOUT,
+                                    &remote);
+
+        if ((len < 0) || (coap_parse(&pkt, buf, len) < 0)) {
+            continue;
+        }
+        coap_get_block2(&pkt, &block2);
+        if (block2.more == -1) {
+            block2.offset = 0;
+            block2.szx = SELFTEST_SZX;
+        }
+        unsigned num = block2.offset / 64U;
+        if (_requests_numof < SELFTEST_REQS_MAX) {
+            _requests[_requests_numof].id = coap_get_id(&pkt);
+            _requests[_requests_numof].num = num;
+            _requests_numof++;
+        }
+        if ((num == SELFTEST_DROP) && !dropped) {
+            dropped = true;
+            continue;
+        }
+        _server_reply(&sock, &remote, coap_get_id(&pkt), &block2);
+    }
+    return NULL;
+}
+
+static int _download_cb(void *arg, size_t offset, uint8_t *buf, size_t len,
+                        int more)
+{
+    (void)more;
+    _download_t *download = arg;
+
+    if (offset != download->offset) {
+        printf("blocks out of order: got offset %u, expected %u\n",
+               (unsigned)offset, (unsigned)download->offset);
+        return -1;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (download->verify && (buf[i] != _selftest_byte(offset + i))) {
+            printf("wrong data at offset %u\n", (unsigned)(offset + i));
+            return -1;
+        }
+        download->checksum += buf[i];
+    }
+    download->offset += len;
+    return 0;
+}
+
+static int _fetch_cmd(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("usage: %s <url> [szx]\n", argv[0]);
+        return 1;
+    }
+
+    coap_blksize_t szx = (argc > 2) ? atoi(argv[2]) : COAP_BLOCKSIZE_64;
+    _download_t download = { 0 };
+
+    uint32_t start = xtimer_now_usec();
+    int res = suit_coap_get_blockwise_url(argv[1], szx, _download_cb,
+                                          &download);
+    uint32_t duration = xtimer_now_usec() - start;
+
+    if (res < 0) {
+        printf("download failed: %d\n", res);
+        return 1;
+    }
+    printf("fetched %u bytes in %" PRIu32 " ms (window %u), checksum 0x%08"
+           PRIx32 "\n", (unsigned)download.offset, duration / US_PER_MS,
+           SUIT_COAP_WINDOW_SIZE, download.checksum);
+    return 0;
+}
+
+static int _selftest(void)
+{
+    _download_t download = { .verify = true };
+    unsigned first = _requests_numof;
+    unsigned later = 0;
+
+    if (suit_coap_get_blockwise_url(SELFTEST_URL, SELFTEST_SZX, _download_cb,
+                                    &download) < 0) {
+        puts("selftest: download failed");
+        return -1;
+    }
+    if (download.offset != SELFTEST_SIZE) {
+        printf("selftest: fetched %u of %u bytes\n",
+               (unsigned)download.offset, SELFTEST_SIZE);
+        return -1;
+    }
+    printf("selftest: fetched %u bytes in order\n", (unsigned)download.offset);
+
+    /* find the dropped request and its retransmission */
+    for (; first < _requests_numof; first++) {
+        if (_requests[first].num == SELFTEST_DROP) {
+            break;
+        }
+    }
+    for (unsigned i = first + 1; i < _requests_numof; i++) {
+        if (_requests[i].num > SELFTEST_DROP) {
+            later++;
+        }
+        else if (_requests[i].num == SELFTEST_DROP) {
+            if (_requests[i].id != _requests[first].id) {
+                puts("selftest: retransmission with a new message ID");
+                return -1;
+            }
+            printf("selftest: block %u retransmitted with the same message ID "
+                   "after %u requests for later blocks\n", SELFTEST_DROP,
+                   later);
+            return (later > 0) ? 0 : -1;
+        }
+    }
+    puts("selftest: dropped block was not retransmitted");
+    return -1;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "fetch", "download a resource block-wise", _fetch_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+
+    puts("SUIT CoAP block-wise download test");
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST, _server,
+                  NULL, "coap server");
+    puts((_selftest() == 0) ? "selftest: SUCCESS" : "selftest: FAILURE");
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
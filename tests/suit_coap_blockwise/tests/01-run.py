@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    # blocks are passed to the callback in order, although the dropped block
+    # arrives after the later blocks of the window
+    child.expect_exact("selftest: fetched 1024 bytes in order")
+    # the window keeps going while the dropped block is retransmitted
+    child.expect(r"selftest: block \d+ retransmitted with the same message ID "
+                 r"after (\d+) requests for later blocks")
+    assert int(child.match.group(1)) > 0
+    child.expect_exact("selftest: SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
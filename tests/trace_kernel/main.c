@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the kernel event tracer
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "trace_kernel.h"
+
+#define MSG_NUMOF           (4U)
+#define TEST_MSG_TYPE       (0x4242)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _mutex = MUTEX_INIT;
+static trace_kernel_event_t _events[TRACE_KERNEL_BUFFER_SIZE];
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+    for (unsigned i = 0; i < MSG_NUMOF; i++) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        /* blocks until main releases the mutex */
+        mutex_lock(&_mutex);
+        mutex_unlock(&_mutex);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    static const char *names[] = {
+        [TRACE_KERNEL_SCHED] = "sched",
+        [TRACE_KERNEL_ISR_ENTER] = "isr_enter",
+        [TRACE_KERNEL_ISR_EXIT] = "isr_exit",
+        [TRACE_KERNEL_MSG_SEND] = "msg_send",
+        [TRACE_KERNEL_MSG_RECV] = "msg_receive",
+        [TRACE_KERNEL_MUTEX_WAIT] = "mutex_wait",
+        [TRACE_KERNEL_MUTEX_LOCK] = "mutex_lock",
+        [TRACE_KERNEL_MUTEX_UNLOCK] = "mutex_unlock",
+    };
+    unsigned counts[TRACE_KERNEL_NUMOF] = { 0 };
+    kernel_pid_t pid, running = thread_getpid();
+    size_t num;
+
+    trace_kernel_stop();
+    trace_kernel_clear();
+    pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                        THREAD_CREATE_STACKTEST, _thread, NULL, "receiver");
+    trace_kernel_start();
+    for (unsigned i = 0; i < MSG_NUMOF; i++) {
+        msg_t msg = { .type = TEST_MSG_TYPE };
+
+        mutex_lock(&_mutex);
+        msg_send(&msg, pid);
+        mutex_unlock(&_mutex);
+    }
+    trace_kernel_stop();
+
+    num = trace_kernel_read(_events, TRACE_KERNEL_BUFFER_SIZE);
+    for (size_t i = 0; i < num; i++) {
+        if (_events[i].type < TRACE_KERNEL_NUMOF) {
+            counts[_events[i].type]++;
+        }
+        if (((_events[i].type == TRACE_KERNEL_MSG_SEND) ||
+             (_events[i].type == TRACE_KERNEL_MSG_RECV)) &&
+            (_events[i].arg16 != TEST_MSG_TYPE)) {
+            printf("unexpected message type 0x%04x\n", _events[i].arg16);
+            return 1;
+        }
+        if (_events[i].type == TRACE_KERNEL_SCHED) {
+            /* a context switch is recorded for the thread switched away from,
+             * even though the scheduler may run in interrupt context */
+            if (_events[i].pid != running) {
+                printf("context switch recorded for %u instead of %u\n",
+                       (unsigned)_events[i].pid, (unsigned)running);
+                return 1;
+            }
+            running = _events[i].arg;
+        }
+    }
+    printf("recorded %u events, %u lost\n", (unsigned)num,
+           (unsigned)trace_kernel_lost());
+    for (unsigned i = 0; i < TRACE_KERNEL_NUMOF; i++) {
+        printf("%s: %u\n", names[i], counts[i]);
+    }
+#ifdef CPU_NATIVE
+    int res = trace_kernel_dump_json(TRACE_JSON_PATH);
+
+    if (res < 0) {
+        printf("trace_kernel_dump_json() failed: %d\n", res);
+        return 1;
+    }
+    printf("wrote %d events to %s\n", res, TRACE_JSON_PATH);
+#endif
+    puts("SUCCESS");
+    return 0;
+}
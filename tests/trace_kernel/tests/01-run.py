@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for event in ("sched", "msg_send", "msg_receive", "mutex_wait",
+                  "mutex_lock", "mutex_unlock"):
+        child.expect(r"{}: (\d+)\r\n".format(event))
+        assert int(child.match.group(1)) > 0
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdbool.h>
+
+#include "embUnit.h"
+
+#include "can/can.h"
+#include "can/common.h"
+#include "can/pkt.h"
+#include "can/router.h"
+#include "msg.h"
+#include "thread.h"
+
+#include "tests-can_router.h"
+
+#define EXACT_SFF_NUMOF     (24U)
+#define EXACT_EFF_NUMOF     (8U)
+#define EXACT_EFF_BASE      (0x1000000U)
+#define EXACT_EFF_MASK      (CAN_EFF_FLAG | CAN_EFF_MASK)
+#define FILTERS_MAX         (EXACT_SFF_NUMOF + EXACT_EFF_NUMOF + 16U)
+#define BATCH_NUMOF         (2U)
+#define TRIGGER_ID          (0x120U)
+
+typedef struct {
+    canid_t can_id;
+    canid_t mask;
+    bool registered;
+} filter_t;
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static can_reg_entry_t _entry;
+
+static filter_t _filters[FILTERS_MAX];
+static unsigned _filters_numof;
+static unsigned _counts[FILTERS_MAX];
+static unsigned _bad_frames;
+static unsigned _keep[2];
+
+/* filter whose frame makes the receiver unregister the filters matching
+ * TRIGGER_ID while the frame is still dispatched */
+static unsigned _trigger;
+static int _unreg_res;
+
+static unsigned _add(canid_t can_id, canid_t mask)
+{
+    unsigned i = _filters_numof++;
+
+    _filters[i].can_id = can_id;
+    _filters[i].mask = mask;
+    _filters[i].registered = false;
+    return i;
+}
+
+static int _register(unsigned i)
+{
+    int res = can_router_register(&_entry, _filters[i].can_id,
+                                  _filters[i].mask, &_filters[i]);
+
+    if (res >= 0) {
+        _filters[i].registered = true;
+    }
+    return res;
+}
+
+static int _unregister(unsigned i)
+{
+    int res = can_router_unregister(&_entry, _filters[i].can_id,
+                                    _filters[i].mask, &_filters[i]);
+
+    if (res >= 0) {
+        _filters[i].registered = false;
+    }
+    return res;
+}
+
+static bool _matches(unsigned i, canid_t can_id)
+{
+    return (can_id & _filters[i].mask) == _filters[i].can_id;
+}
+
+static void _unregister_trigger_matches(void)
+{
+    unsigned numof = 0;
+
+    _unreg_res = 0;
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        if (!_filters[i].registered || !_matches(i, TRIGGER_ID) ||
+            (i == _keep[0]) || (i == _keep[1])) {
+            continue;
+        }
+        if (_unregister(i) < 0) {
+            _unreg_res = -1;
+        }
+        numof++;
+    }
+    /* reuses the memory of the unregistered filters, if it was freed while
+     * the dispatch still walks them */
+    for (canid_t can_id = TRIGGER_ID + 1; numof > 0; can_id++, numof--) {
+        if (_register(_add(can_id, CAN_SFF_MASK)) < 0) {
+            _unreg_res = -1;
+        }
+    }
+}
+
+static void *_receiver(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type != CAN_MSG_RX_INDICATION) {
+            continue;
+        }
+        can_rx_data_t *rx = msg.content.ptr;
+        struct can_frame *frame = rx->data.iov_base;
+        filter_t *filter = rx->arg;
+        unsigned i = filter - _filters;
+
+        if ((i >= _filters_numof) || !_matches(i, frame->can_id)) {
+            _bad_frames++;
+        }
+        else {
+            _counts[i]++;
+        }
+        can_router_free_frame(frame);
+        can_pkt_free_rx_data(rx);
+        if (i == _trigger) {
+            _trigger = FILTERS_MAX;
+            _unregister_trigger_matches();
+        }
+    }
+
+    return NULL;
+}
+
+static void _reset_counts(void)
+{
+    for (unsigned i = 0; i < FILTERS_MAX; i++) {
+        _counts[i] = 0;
+    }
+    _bad_frames = 0;
+}
+
+static void _dispatch(canid_t can_id)
+{
+    struct can_frame frame = { .can_id = can_id, .can_dlc = 0 };
+    can_pkt_t *pkt = can_pkt_alloc_rx(0, &frame);
+
+    /* packets that are not freed by the router exhaust the pool */
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(0, can_router_dispatch_rx_indic(pkt));
+}
+
+/* every registered subscriber matching @p can_id gets the frame once */
+static void _check_frame(canid_t can_id)
+{
+    _reset_counts();
+    _dispatch(can_id);
+    TEST_ASSERT_EQUAL_INT(0, _bad_frames);
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        unsigned exp = (_filters[i].registered && _matches(i, can_id)) ? 1 : 0;
+
+        TEST_ASSERT_EQUAL_INT(exp, _counts[i]);
+    }
+}
+
+static void _check_all_frames(void)
+{
+    for (canid_t can_id = 0; can_id <= 0x2ff; can_id++) {
+        _check_frame(can_id);
+    }
+    for (unsigned i = 0; i < EXACT_EFF_NUMOF + 2; i++) {
+        _check_frame(CAN_EFF_FLAG | (EXACT_EFF_BASE + (i * 0x101U)));
+    }
+}
+
+static void set_up(void)
+{
+    can_pkt_init();
+    can_router_init();
+    _entry.ifnum = 0;
+    _entry.target.pid = _pid;
+    _filters_numof = 0;
+    _keep[0] = FILTERS_MAX;
+    _keep[1] = FILTERS_MAX;
+    _trigger = FILTERS_MAX;
+
+    /* exact IDs fill two mask groups, the first masks fill the remaining
+     * groups, the others end up in the masked list */
+    for (unsigned i = 0; i < EXACT_SFF_NUMOF; i++) {
+        _add(0x100 + (i * 4), CAN_SFF_MASK);
+    }
+    for (unsigned i = 0; i < EXACT_EFF_NUMOF; i++) {
+        _add(CAN_EFF_FLAG | (EXACT_EFF_BASE + (i * 0x101U)), EXACT_EFF_MASK);
+    }
+    _add(0x100, 0x700);
+    _add(0x120, 0x7f0);
+    _add(0x128, 0x7f8);
+    _add(0x12c, 0x7fc);
+    _add(0x100, 0x780);
+    _add(0x120, 0x7e0);
+    _add(0x200, 0x700);
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        if (_filters[i].registered) {
+            _unregister(i);
+        }
+    }
+}
+
+static void test_can_router__exact_and_masked(void)
+{
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _register(i));
+    }
+    /* a second subscriber of an exact ID and of a masked filter */
+    TEST_ASSERT_EQUAL_INT(1, _register(_add(TRIGGER_ID, CAN_SFF_MASK)));
+    TEST_ASSERT_EQUAL_INT(1, _register(_add(0x128, 0x7f8)));
+    _check_all_frames();
+}
+
+static void test_can_router__mask_group_reuse(void)
+{
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _register(i));
+    }
+    /* the filters of 0x700 and 0x7f0 are hashed, free the group of 0x7f0 */
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        if (_filters[i].mask == 0x7f0) {
+            TEST_ASSERT_EQUAL_INT(0, _unregister(i));
+        }
+    }
+    _check_all_frames();
+
+    /* 0x7f8 gets the free group while its first filter stays in the
+     * masked list */
+    unsigned hashed = _add(0x138, 0x7f8);
+    TEST_ASSERT_EQUAL_INT(0, _register(hashed));
+    TEST_ASSERT_EQUAL_INT(1, _register(_add(0x128, 0x7f8)));
+    _check_all_frames();
+
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        if ((_filters[i].mask == 0x7f8) && (i != hashed)) {
+            _unregister(i);
+        }
+    }
+    _check_all_frames();
+
+    /* free the group again and let a new mask reuse it */
+    TEST_ASSERT_EQUAL_INT(0, _unregister(hashed));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, _unregister(hashed));
+    TEST_ASSERT_EQUAL_INT(0, _register(_add(0x130, 0x7fe)));
+    TEST_ASSERT_EQUAL_INT(0, _register(_add(0x120, 0x7f0)));
+    _check_all_frames();
+}
+
+static void test_can_router__unregister_during_dispatch(void)
+{
+    can_pkt_t *pkts[BATCH_NUMOF];
+    struct can_frame frame = { .can_id = TRIGGER_ID, .can_dlc = 0 };
+
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _register(i));
+    }
+    _keep[0] = _add(TRIGGER_ID, CAN_SFF_MASK);
+    TEST_ASSERT_EQUAL_INT(1, _register(_keep[0]));
+    /* the masked list is sorted by CAN ID, so the trigger is walked right
+     * before the second filter to keep */
+    for (unsigned i = 0; i < _filters_numof; i++) {
+        if (_filters[i].mask == 0x780) {
+            _trigger = i;
+        }
+        else if (_filters[i].mask == 0x7e0) {
+            _keep[1] = i;
+        }
+    }
+    TEST_ASSERT(_trigger < FILTERS_MAX);
+    TEST_ASSERT(_keep[1] < FILTERS_MAX);
+    unsigned trigger = _trigger;
+
+    unsigned numof = _filters_numof;
+    for (unsigned i = 0; i < BATCH_NUMOF; i++) {
+        pkts[i] = can_pkt_alloc_rx(0, &frame);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    _reset_counts();
+    TEST_ASSERT_EQUAL_INT(0, can_router_dispatch_rx_batch(pkts, BATCH_NUMOF));
+    TEST_ASSERT_EQUAL_INT(FILTERS_MAX, _trigger);
+    TEST_ASSERT_EQUAL_INT(0, _unreg_res);
+    TEST_ASSERT_EQUAL_INT(0, _bad_frames);
+
+    /* the remaining subscribers get both frames, the unregistered ones at
+     * most the frame that was dispatched while they were unregistered */
+    TEST_ASSERT_EQUAL_INT(1, _counts[trigger]);
+    for (unsigned i = 0; i < numof; i++) {
+        if (!_matches(i, TRIGGER_ID)) {
+            TEST_ASSERT_EQUAL_INT(0, _counts[i]);
+        }
+        else if (_filters[i].registered) {
+            TEST_ASSERT_EQUAL_INT(BATCH_NUMOF, _counts[i]);
+        }
+        else {
+            TEST_ASSERT(_counts[i] <= 1);
+        }
+    }
+    TEST_ASSERT(_filters[_keep[0]].registered);
+    TEST_ASSERT(_filters[_keep[1]].registered);
+    for (unsigned i = numof; i < _filters_numof; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _counts[i]);
+    }
+    _check_all_frames();
+}
+
+Test *tests_can_router_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_can_router__exact_and_masked),
+        new_TestFixture(test_can_router__mask_group_reuse),
+        new_TestFixture(test_can_router__unregister_during_dispatch),
+    };
+
+    EMB_UNIT_TESTCALLER(can_router_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&can_router_tests;
+}
+
+void tests_can_router(void)
+{
+    if (_pid == KERNEL_PID_UNDEF) {
+        /* preempts the dispatching thread with every frame it receives */
+        _pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                             THREAD_CREATE_STACKTEST, _receiver, NULL,
+                             "can_router_rx");
+    }
+    TESTS_RUN(tests_can_router_tests());
+}
+/** @} */
@@ -88,6 +88,35 @@ static void test_checksum_crc16_ccitt_sequence_4bytes(void)
                 sizeof(buf) / 2, expect));
 }
 
+static void test_checksum_crc16_ccitt_le_sequence_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+
+    /* CRC-16/KERMIT */
+    TEST_ASSERT_EQUAL_INT(0x2189, crc16_ccitt_le_update(0, buf,
+                                                        sizeof(buf) - 1));
+}
+
+static void test_checksum_crc16_ccitt_le_ieee802154_frame(void)
+{
+    /* same frame as in test_checksum_ucrc16_le_ieee802164_frame() */
+    unsigned char buf[] = { 0x41, 0xcc, 0xa4, 0xff, 0xff, 0x8a, 0x18, 0x00,
+                            0xff, 0xff, 0xda, 0x1c, 0x00, 0x88, 0x18, 0x00,
+                            0xff, 0xff, 0xda, 0x1c, 0x00, 0x41, 0x60, 0x00,
+                            0x00, 0x00, 0x00, 0x19, 0x11, 0x40, 0xfe, 0x80,
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c,
+                            0xda, 0xff, 0xff, 0x00, 0x18, 0x88, 0xfe, 0x80,
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c,
+                            0xda, 0xff, 0xff, 0x00, 0x18, 0x8a, 0x04, 0x01,
+                            0xf0, 0xb1, 0x00, 0x19, 0xea, 0x8a, 0x48, 0x65,
+                            0x6c, 0x6c, 0x6f, 0x20, 0x30, 0x30, 0x33, 0x20,
+                            0x30, 0x78, 0x43, 0x35, 0x39, 0x41, 0x0a };
+    uint16_t result = crc16_ccitt_le_update(0, buf, 13);
+
+    result = crc16_ccitt_le_update(result, buf + 13, sizeof(buf) - 13);
+    TEST_ASSERT_EQUAL_INT(0x31f9, result);
+}
+
 Test *tests_checksum_crc16_ccitt_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -98,6 +127,8 @@ Test *tests_checksum_crc16_ccitt_tests(void)
         new_TestFixture(test_checksum_crc16_ccitt_sequence_256a),
         new_TestFixture(test_checksum_crc16_ccitt_sequence_1to9),
         new_TestFixture(test_checksum_crc16_ccitt_sequence_4bytes),
+        new_TestFixture(test_checksum_crc16_ccitt_le_sequence_1to9),
+        new_TestFixture(test_checksum_crc16_ccitt_le_ieee802154_frame),
     };
 
     EMB_UNIT_TESTCALLER(checksum_crc16_ccitt_tests, NULL, NULL, fixtures);
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdint.h>
+
+#include "embUnit/embUnit.h"
+
+#include "checksum/crc32.h"
+
+#include "tests-checksum.h"
+
+#define CRC32_POLY_LE       (0xedb88320)
+#define CRC32C_POLY_LE      (0x82f63b78)
+
+/* bit-wise reference implementation */
+static uint32_t _crc32_ref(uint32_t poly, const uint8_t *buf, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+
+    while (len--) {
+        crc ^= *buf++;
+        for (unsigned i = 0; i < 8; i++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ poly) : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+static void _fill(uint8_t *buf, size_t len)
+{
+    uint32_t x = 0x12345678;
+
+    for (size_t i = 0; i < len; i++) {
+        x = x * 1103515245 + 12345;
+        buf[i] = x >> 24;
+    }
+}
+
+static void test_checksum_crc32_sequence_empty(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, crc32_calc("", 0));
+    TEST_ASSERT_EQUAL_INT(0, crc32c_calc("", 0));
+    TEST_ASSERT_EQUAL_INT(0x12345678, crc32_update(0x12345678, "", 0));
+}
+
+static void test_checksum_crc32_sequence_1to9(void)
+{
+    static const char buf[] = "123456789";
+
+    TEST_ASSERT(crc32_calc(buf, sizeof(buf) - 1) == 0xcbf43926);
+    TEST_ASSERT(crc32c_calc(buf, sizeof(buf) - 1) == 0xe3069283);
+}
+
+static void test_checksum_crc32_sequence_32zeros(void)
+{
+    /* iSCSI test vectors, RFC 3720 B.4 */
+    static const uint8_t zeros[32] = { 0 };
+
+    TEST_ASSERT(crc32c_calc(zeros, sizeof(zeros)) == 0x8a9136aa);
+    TEST_ASSERT(crc32_calc(zeros, sizeof(zeros)) == 0x190a55ad);
+}
+
+static void test_checksum_crc32_unaligned_with_update(void)
+{
+    uint8_t buf[80];
+
+    _fill(buf, sizeof(buf));
+    /* cover all alignments, splits and tails of the slice-by-N loops */
+    for (unsigned offset = 0; offset < 8; offset++) {
+        size_t len = sizeof(buf) - offset;
+        uint32_t expect = _crc32_ref(CRC32_POLY_LE, buf + offset, len);
+        uint32_t expect_c = _crc32_ref(CRC32C_POLY_LE, buf + offset, len);
+
+        for (size_t split = 0; split <= len; split += 3) {
+            uint32_t res = crc32_calc(buf + offset, split);
+            uint32_t res_c = crc32c_calc(buf + offset, split);
+
+            res = crc32_update(res, buf + offset + split, len - split);
+            res_c = crc32c_update(res_c, buf + offset + split, len - split);
+            TEST_ASSERT(res == expect);
+            TEST_ASSERT(res_c == expect_c);
+        }
+    }
+}
+
+Test *tests_checksum_crc32_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_checksum_crc32_sequence_empty),
+        new_TestFixture(test_checksum_crc32_sequence_1to9),
+        new_TestFixture(test_checksum_crc32_sequence_32zeros),
+        new_TestFixture(test_checksum_crc32_unaligned_with_update),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc32_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc32_tests;
+}
+
+/** @} */
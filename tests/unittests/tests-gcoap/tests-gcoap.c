@@ -12,12 +12,14 @@
  * @file
  */
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
 #include "embUnit.h"
 
 #include "net/gcoap.h"
+#include "net/sock/util.h"
 
 #include "unittests-constants.h"
 #include "tests-gcoap.h"
@@ -51,6 +53,28 @@ static gcoap_listener_t listener_second = {
 
 static const char *resource_list_str = "</act/switch>,</sensor/temp>,</test/info/all>,</second/part>";
 
+static ssize_t _obs_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+/*
+ * Observable resources, registered after the resource list test
+ */
+static const coap_resource_t resources_obs[] = {
+    { .path = "/obs/a", .methods = COAP_GET, .handler = _obs_handler },
+    { .path = "/obs/b", .methods = COAP_GET, .handler = _obs_handler },
+};
+
+static gcoap_listener_t listener_obs = {
+    .resources     = &resources_obs[0],
+    .resources_len = ARRAY_SIZE(resources_obs),
+    .link_encoder  = NULL,
+    .next          = NULL
+};
+
 /*
  * Client GET request success case. Test request generation.
  * Request /time resource from libcoap example
@@ -392,6 +416,197 @@ static void test_gcoap__server_get_resource_list(void)
     TEST_ASSERT_EQUAL_STRING(resource_list_str, (char *)res);
 }
 
+/*
+ * Helpers for the server_obs_* tests below.
+ */
+#define OBS_PORT_A      (5001U)
+#define OBS_PORT_B      (5002U)
+
+static sock_udp_ep_t _obs_remote_a;
+static sock_udp_ep_t _obs_remote_b;
+
+static void _obs_set_up(void)
+{
+    static bool registered;
+    const sock_udp_ep_t remote = {
+        .family = AF_INET6,
+        .addr = { .ipv6 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                            0, 0, 0, 0, 0, 0, 0, 0x01 } },
+    };
+
+    if (!registered) {
+        gcoap_register_listener(&listener_obs);
+        registered = true;
+    }
+    gcoap_obs_reset();
+    _obs_remote_a = remote;
+    _obs_remote_a.port = OBS_PORT_A;
+    _obs_remote_b = remote;
+    _obs_remote_b.port = OBS_PORT_B;
+}
+
+/*
+ * Sends a GET request with Observe option to the server, returns true if the
+ * response confirms the registration.
+ */
+static bool _obs_req(sock_udp_ep_t *remote, const char *path, uint8_t token,
+                     uint32_t observe)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t *pos = buf;
+    coap_pkt_t pdu;
+    ssize_t res;
+
+    pos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, &token, 1,
+                          COAP_METHOD_GET, token);
+    pos += coap_opt_put_uint(pos, 0, COAP_OPT_OBSERVE, observe);
+    pos += coap_opt_put_uri_path(pos, COAP_OPT_OBSERVE, path);
+    if (coap_parse(&pdu, buf, pos - buf) < 0) {
+        return false;
+    }
+    res = gcoap_handle_req(&pdu, buf, sizeof(buf), remote);
+    if ((res <= 0) || (coap_parse(&pdu, buf, res) < 0)) {
+        return false;
+    }
+    return coap_has_observe(&pdu);
+}
+
+static const gcoap_observe_memo_t *_obs_memo(const coap_resource_t *resource,
+                                             const sock_udp_ep_t *remote)
+{
+    const gcoap_observe_memo_t *memos = gcoap_obs_memo_array();
+
+    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        if ((memos[i].observer != NULL) && (memos[i].resource == resource) &&
+            sock_udp_ep_equal(memos[i].observer, remote)) {
+            return &memos[i];
+        }
+    }
+    return NULL;
+}
+
+static unsigned _obs_numof(const coap_resource_t *resource)
+{
+    const gcoap_observe_memo_t *memos = gcoap_obs_memo_array();
+    unsigned res = 0;
+
+    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        if ((memos[i].observer != NULL) && (memos[i].resource == resource)) {
+            res++;
+        }
+    }
+    return res;
+}
+
+/*
+ * Observe registration by several clients for the same resource.
+ */
+static void test_gcoap__server_obs_register(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    const gcoap_observe_memo_t *memo;
+    coap_pkt_t pdu;
+
+    _obs_set_up();
+    TEST_ASSERT(_obs_req(&_obs_remote_a, "/obs/a", 0x11, COAP_OBS_REGISTER));
+    memo = _obs_memo(&resources_obs[0], &_obs_remote_a);
+    TEST_ASSERT_NOT_NULL(memo);
+    TEST_ASSERT_EQUAL_INT(1, memo->token_len);
+    TEST_ASSERT_EQUAL_INT(0x11, memo->token[0]);
+
+    /* only accepted if several observers per resource are allowed */
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_MULTI_OBSERVERS,
+                          _obs_req(&_obs_remote_b, "/obs/a", 0x22,
+                                   COAP_OBS_REGISTER));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_MULTI_OBSERVERS ? 2 : 1,
+                          _obs_numof(&resources_obs[0]));
+#if GCOAP_OBS_MULTI_OBSERVERS
+    memo = _obs_memo(&resources_obs[0], &_obs_remote_b);
+    TEST_ASSERT_NOT_NULL(memo);
+    TEST_ASSERT_EQUAL_INT(0x22, memo->token[0]);
+#endif
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_INIT_OK,
+                          gcoap_obs_init(&pdu, buf, sizeof(buf),
+                                         &resources_obs[0]));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_INIT_UNUSED,
+                          gcoap_obs_init(&pdu, buf, sizeof(buf),
+                                         &resources_obs[1]));
+}
+
+/*
+ * Re-registration finds the existing registration of the client.
+ */
+static void test_gcoap__server_obs_reregister(void)
+{
+    const gcoap_observe_memo_t *memo;
+
+    _obs_set_up();
+    TEST_ASSERT(_obs_req(&_obs_remote_a, "/obs/a", 0x11, COAP_OBS_REGISTER));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_MULTI_OBSERVERS,
+                          _obs_req(&_obs_remote_b, "/obs/a", 0x22,
+                                   COAP_OBS_REGISTER));
+    memo = _obs_memo(&resources_obs[0], &_obs_remote_a);
+
+    /* same token */
+    TEST_ASSERT(_obs_req(&_obs_remote_a, "/obs/a", 0x11, COAP_OBS_REGISTER));
+    TEST_ASSERT(memo == _obs_memo(&resources_obs[0], &_obs_remote_a));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_MULTI_OBSERVERS ? 2 : 1,
+                          _obs_numof(&resources_obs[0]));
+
+    /* new token */
+    TEST_ASSERT(_obs_req(&_obs_remote_a, "/obs/a", 0x33, COAP_OBS_REGISTER));
+    TEST_ASSERT(memo == _obs_memo(&resources_obs[0], &_obs_remote_a));
+    TEST_ASSERT_EQUAL_INT(0x33, memo->token[0]);
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_MULTI_OBSERVERS ? 2 : 1,
+                          _obs_numof(&resources_obs[0]));
+#if GCOAP_OBS_MULTI_OBSERVERS
+    TEST_ASSERT_EQUAL_INT(0x22,
+                          _obs_memo(&resources_obs[0], &_obs_remote_b)->token[0]);
+#endif
+}
+
+/*
+ * Deregistration removes the client once it has no registrations left.
+ */
+static void test_gcoap__server_obs_deregister(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    const gcoap_observe_memo_t *memo;
+    sock_udp_ep_t *observer;
+    coap_pkt_t pdu;
+
+    _obs_set_up();
+    TEST_ASSERT(_obs_req(&_obs_remote_a, "/obs/a", 0x11, COAP_OBS_REGISTER));
+    TEST_ASSERT(_obs_req(&_obs_remote_a, "/obs/b", 0x12, COAP_OBS_REGISTER));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_MULTI_OBSERVERS,
+                          _obs_req(&_obs_remote_b, "/obs/a", 0x22,
+                                   COAP_OBS_REGISTER));
+    observer = _obs_memo(&resources_obs[0], &_obs_remote_a)->observer;
+
+    TEST_ASSERT(!_obs_req(&_obs_remote_a, "/obs/a", 0x11,
+                          COAP_OBS_DEREGISTER));
+    TEST_ASSERT_NULL(_obs_memo(&resources_obs[0], &_obs_remote_a));
+    /* client still observes the other resource */
+    memo = _obs_memo(&resources_obs[1], &_obs_remote_a);
+    TEST_ASSERT_NOT_NULL(memo);
+    TEST_ASSERT(memo->observer == observer);
+    TEST_ASSERT_EQUAL_INT(AF_INET6, observer->family);
+
+    TEST_ASSERT(!_obs_req(&_obs_remote_a, "/obs/b", 0x12,
+                          COAP_OBS_DEREGISTER));
+    TEST_ASSERT_NULL(_obs_memo(&resources_obs[1], &_obs_remote_a));
+    TEST_ASSERT_EQUAL_INT(AF_UNSPEC, observer->family);
+
+    /* registration of the other client is untouched */
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_MULTI_OBSERVERS ? 1 : 0,
+                          _obs_numof(&resources_obs[0]));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_MULTI_OBSERVERS ? GCOAP_OBS_INIT_OK
+                                                    : GCOAP_OBS_INIT_UNUSED,
+                          gcoap_obs_init(&pdu, buf, sizeof(buf),
+                                         &resources_obs[0]));
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -405,7 +620,10 @@ Test *tests_gcoap_tests(void)
         new_TestFixture(test_gcoap__server_get_resp),
         new_TestFixture(test_gcoap__server_con_req),
         new_TestFixture(test_gcoap__server_con_resp),
-        new_TestFixture(test_gcoap__server_get_resource_list)
+        new_TestFixture(test_gcoap__server_get_resource_list),
+        new_TestFixture(test_gcoap__server_obs_register),
+        new_TestFixture(test_gcoap__server_obs_reregister),
+        new_TestFixture(test_gcoap__server_obs_deregister)
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
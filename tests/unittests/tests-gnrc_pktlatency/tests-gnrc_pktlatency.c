@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include "embUnit.h"
+
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktlatency.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "tests-gnrc_pktlatency.h"
+
+#define PID_A               (KERNEL_PID_LAST)
+#define PID_B               (KERNEL_PID_LAST - 1)
+/* falls into the histogram bucket [256, 512) even if the test is slow */
+#define LATENCY             (384U)
+#define LATENCY_BUCKET      (5U)
+
+static gnrc_pktsnip_t *_pkt;
+
+static uint32_t _count(kernel_pid_t pid, gnrc_pktlatency_dir_t dir)
+{
+    const gnrc_pktlatency_stats_t *stats = gnrc_pktlatency_stats_get(pid, dir);
+
+    return stats->stat.count;
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_pktlatency_stats_reset();
+    _pkt = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_UNDEF);
+}
+
+static void tear_down(void)
+{
+    gnrc_pktbuf_release(_pkt);
+}
+
+static void test_gnrc_pktlatency__handover(void)
+{
+    const gnrc_pktlatency_stats_t *stats;
+
+    TEST_ASSERT_NOT_NULL(_pkt);
+    gnrc_pktlatency_start(_pkt, xtimer_now_usec() - LATENCY, PID_A,
+                          GNRC_PKTLATENCY_DIR_RCV);
+    /* the time until the hand-over is accounted to the thread holding it */
+    gnrc_pktlatency_handover(_pkt, PID_B, GNRC_NETAPI_MSG_TYPE_RCV);
+    stats = gnrc_pktlatency_stats_get(PID_A, GNRC_PKTLATENCY_DIR_RCV);
+    TEST_ASSERT_EQUAL_INT(1, stats->stat.count);
+    TEST_ASSERT(stats->stat.min >= (int32_t)LATENCY);
+    TEST_ASSERT_EQUAL_INT(1, stats->hist[LATENCY_BUCKET]);
+    TEST_ASSERT_EQUAL_INT(0, _count(PID_A, GNRC_PKTLATENCY_DIR_SND));
+    TEST_ASSERT_EQUAL_INT(0, _count(PID_B, GNRC_PKTLATENCY_DIR_RCV));
+
+    gnrc_pktlatency_done(_pkt);
+    TEST_ASSERT_EQUAL_INT(1, _count(PID_B, GNRC_PKTLATENCY_DIR_RCV));
+    TEST_ASSERT_EQUAL_INT(0, _pkt->latency_flags);
+    /* the packet is not tracked anymore */
+    gnrc_pktlatency_done(_pkt);
+    TEST_ASSERT_EQUAL_INT(1, _count(PID_B, GNRC_PKTLATENCY_DIR_RCV));
+}
+
+static void test_gnrc_pktlatency__handover_untracked(void)
+{
+    TEST_ASSERT_NOT_NULL(_pkt);
+    /* starts tracking, but there is nothing to account yet */
+    gnrc_pktlatency_handover(_pkt, PID_A, GNRC_NETAPI_MSG_TYPE_SND);
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTLATENCY_TRACKED | GNRC_PKTLATENCY_SND,
+                          _pkt->latency_flags);
+    TEST_ASSERT_EQUAL_INT(0, _count(PID_A, GNRC_PKTLATENCY_DIR_SND));
+    gnrc_pktlatency_done(_pkt);
+    TEST_ASSERT_EQUAL_INT(1, _count(PID_A, GNRC_PKTLATENCY_DIR_SND));
+}
+
+static void test_gnrc_pktlatency__header_added(void)
+{
+    gnrc_pktsnip_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(_pkt);
+    gnrc_pktlatency_start(_pkt, xtimer_now_usec(), PID_A,
+                          GNRC_PKTLATENCY_DIR_SND);
+    hdr = gnrc_pktbuf_add(_pkt, NULL, 4, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    /* the hold keeps _pkt for tear_down() */
+    gnrc_pktbuf_hold(_pkt, 1);
+    gnrc_pktlatency_handover(hdr, PID_B, GNRC_NETAPI_MSG_TYPE_SND);
+    TEST_ASSERT_EQUAL_INT(1, _count(PID_A, GNRC_PKTLATENCY_DIR_SND));
+    /* the time stamp stays in the snip handed over first */
+    TEST_ASSERT_EQUAL_INT(0, hdr->latency_flags);
+    TEST_ASSERT_EQUAL_INT(PID_B, _pkt->latency_pid);
+    gnrc_pktlatency_done(hdr);
+    TEST_ASSERT_EQUAL_INT(1, _count(PID_B, GNRC_PKTLATENCY_DIR_SND));
+    gnrc_pktbuf_release(hdr);
+}
+
+static void test_gnrc_pktlatency__pid_undef(void)
+{
+    TEST_ASSERT_NOT_NULL(_pkt);
+    /* e.g. mailboxes, accounted to the thread that takes the packet */
+    gnrc_pktlatency_start(_pkt, xtimer_now_usec(), KERNEL_PID_UNDEF,
+                          GNRC_PKTLATENCY_DIR_RCV);
+    gnrc_pktlatency_done(_pkt);
+    TEST_ASSERT_EQUAL_INT(1, _count(thread_getpid(), GNRC_PKTLATENCY_DIR_RCV));
+}
+
+static void test_gnrc_pktlatency__start_write(void)
+{
+    gnrc_pktsnip_t *copy;
+
+    TEST_ASSERT_NOT_NULL(_pkt);
+    gnrc_pktlatency_start(_pkt, xtimer_now_usec(), PID_A,
+                          GNRC_PKTLATENCY_DIR_RCV);
+    gnrc_pktbuf_hold(_pkt, 1);
+    copy = gnrc_pktbuf_start_write(_pkt);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT(copy != _pkt);
+    gnrc_pktlatency_done(copy);
+    TEST_ASSERT_EQUAL_INT(1, _count(PID_A, GNRC_PKTLATENCY_DIR_RCV));
+    gnrc_pktbuf_release(copy);
+}
+
+static void test_gnrc_pktlatency__stats(void)
+{
+    const gnrc_pktlatency_stats_t *stats;
+
+    TEST_ASSERT_NULL(gnrc_pktlatency_stats_get(KERNEL_PID_UNDEF,
+                                               GNRC_PKTLATENCY_DIR_RCV));
+    TEST_ASSERT_NULL(gnrc_pktlatency_stats_get(PID_A,
+                                               GNRC_PKTLATENCY_DIR_NUMOF));
+    TEST_ASSERT_NOT_NULL(_pkt);
+    gnrc_pktlatency_start(_pkt, xtimer_now_usec() - LATENCY, PID_A,
+                          GNRC_PKTLATENCY_DIR_RCV);
+    gnrc_pktlatency_done(_pkt);
+    gnrc_pktlatency_stats_reset();
+    stats = gnrc_pktlatency_stats_get(PID_A, GNRC_PKTLATENCY_DIR_RCV);
+    TEST_ASSERT_EQUAL_INT(0, stats->stat.count);
+    TEST_ASSERT_EQUAL_INT(0, stats->hist[LATENCY_BUCKET]);
+}
+
+Test *tests_gnrc_pktlatency_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_pktlatency__handover),
+        new_TestFixture(test_gnrc_pktlatency__handover_untracked),
+        new_TestFixture(test_gnrc_pktlatency__header_added),
+        new_TestFixture(test_gnrc_pktlatency__pid_undef),
+        new_TestFixture(test_gnrc_pktlatency__start_write),
+        new_TestFixture(test_gnrc_pktlatency__stats),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_pktlatency_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_pktlatency_tests;
+}
+
+void tests_gnrc_pktlatency(void)
+{
+    TESTS_RUN(tests_gnrc_pktlatency_tests());
+}
+/** @} */
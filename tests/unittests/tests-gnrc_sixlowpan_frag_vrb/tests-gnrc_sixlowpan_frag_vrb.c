@@ -19,6 +19,7 @@
 #include "embUnit/embUnit.h"
 
 #include "net/gnrc/sixlowpan/frag/fb.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
 #include "net/gnrc/sixlowpan/frag/vrb.h"
 #include "xtimer.h"
 
@@ -36,13 +37,11 @@
  * reference for forwarding) so an uninitialized one is enough */
 static gnrc_netif_t _dummy_netif;
 
-static const gnrc_sixlowpan_frag_rb_int_t _interval = {
-    .next = NULL,
-    .start = 0,
-    .end = 116U,
-};
+/* removing a VRB entry releases its intervals to the interval pool of the
+ * reassembly buffer, so this one is re-initialized for every test */
+static gnrc_sixlowpan_frag_rb_int_t _interval;
 static const gnrc_sixlowpan_frag_rb_base_t _base = {
-    .ints = (gnrc_sixlowpan_frag_rb_int_t *)&_interval,
+    .ints = &_interval,
     .src = TEST_SRC,
     .dst = TEST_DST,
     .src_len = TEST_SRC_LEN,
@@ -56,8 +55,12 @@ static uint8_t _out_dst[] = TEST_OUT_DST;
 
 static void set_up(void)
 {
+    gnrc_sixlowpan_frag_rb_reset();
     gnrc_sixlowpan_frag_vrb_reset();
     gnrc_sixlowpan_frag_fb_reset();
+    _interval.next = NULL;
+    _interval.start = 0;
+    _interval.end = 116U;
 }
 
 static void test_vrb_add__success(void)
@@ -226,6 +226,36 @@ static void test_mtd_write_read(void)
     TEST_ASSERT_EQUAL_INT(-EOVERFLOW, ret);
 }
 
+static void test_mtd_write_read_page(void)
+{
+    const char buf[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    char buf_read[sizeof(buf)];
+    const uint32_t offset = dev->page_size - 5;
+    memset(buf_read, 0, sizeof(buf_read));
+
+    /* write / read across a page boundary */
+    int ret = mtd_write_page(dev, buf, 0, offset, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+
+    ret = mtd_read_page(dev, buf_read, 0, offset, sizeof(buf_read));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read), ret);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read, sizeof(buf)));
+
+    /* the part in the second page */
+    ret = mtd_read_page(dev, buf_read, 1, 0, sizeof(buf) - 5);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf) - 5, ret);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf + 5, buf_read, sizeof(buf) - 5));
+
+    /* offset outside of the page */
+    ret = mtd_write_page(dev, buf, 0, dev->page_size, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ret);
+
+    /* out of bounds read (page) */
+    ret = mtd_read_page(dev, buf_read, dev->pages_per_sector * dev->sector_count,
+                        0, sizeof(buf_read));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, ret);
+}
+
 #ifdef MTD_0
 static void test_mtd_write_read_flash(void)
 {
@@ -251,6 +281,55 @@ static void test_mtd_write_read_flash(void)
 }
 #endif
 
+#if MODULE_MTD_ASYNC
+static unsigned _async_calls;
+
+static void _async_cb(mtd_async_t *req)
+{
+    TEST_ASSERT(!mtd_async_pending(req));
+    *(unsigned *)req->arg += 1;
+}
+
+static void test_mtd_async(void)
+{
+    const char buf[] = "ABCDEFGH";
+    char buf_read[sizeof(buf)];
+    mtd_async_t req;
+    memset(buf_read, 0, sizeof(buf_read));
+    /* the submitting functions must not rely on anything in the request */
+    memset(&req, 0xff, sizeof(req));
+    _async_calls = 0;
+
+    int ret = mtd_write_async(dev, &req, buf, dev->page_size, sizeof(buf),
+                              _async_cb, &_async_calls);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_async_wait(&req));
+    TEST_ASSERT_EQUAL_INT(1, _async_calls);
+    /* waiting again returns the same result */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_async_wait(&req));
+
+    ret = mtd_read_async(dev, &req, buf_read, dev->page_size, sizeof(buf_read),
+                         NULL, NULL);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read), mtd_async_wait(&req));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read, sizeof(buf)));
+
+    ret = mtd_erase_async(dev, &req, 0, dev->pages_per_sector * dev->page_size,
+                          _async_cb, &_async_calls);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_wait(&req));
+    TEST_ASSERT_EQUAL_INT(2, _async_calls);
+
+    /* errors are reported on completion */
+    ret = mtd_erase_async(dev, &req, 0, dev->page_size, NULL, NULL);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_async_wait(&req));
+
+    ret = mtd_erase_async(NULL, &req, 0, dev->page_size, NULL, NULL);
+    TEST_ASSERT_EQUAL_INT(-ENODEV, ret);
+}
+#endif
+
 #if MODULE_VFS
 static void test_mtd_vfs(void)
 {
@@ -287,9 +366,13 @@ Test *tests_mtd_tests(void)
         new_TestFixture(test_mtd_erase),
         new_TestFixture(test_mtd_write_erase),
         new_TestFixture(test_mtd_write_read),
+        new_TestFixture(test_mtd_write_read_page),
 #ifdef MTD_0
         new_TestFixture(test_mtd_write_read_flash),
 #endif
+#if MODULE_MTD_ASYNC
+        new_TestFixture(test_mtd_async),
+#endif
 #if MODULE_VFS
         new_TestFixture(test_mtd_vfs),
 #endif
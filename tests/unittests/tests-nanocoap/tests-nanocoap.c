@@ -18,6 +18,7 @@
 #include <stdio.h>
 
 #include "embUnit.h"
+#include "kernel_defines.h"
 
 #include "net/nanocoap.h"
 
@@ -645,6 +646,70 @@ static void test_nanocoap__options_get_opaque(void)
     TEST_ASSERT_EQUAL_INT(-ENOENT, optlen);
 }
 
+/*
+ * Tests lookup of resources with coap_find_resource(), including subtree
+ * matching and method filtering.
+ */
+static void test_nanocoap__find_resource(void)
+{
+    /* sorted by path, handlers are not called */
+    static const coap_resource_t resources[] = {
+        { "/a", COAP_GET, NULL, NULL },
+        { "/a/", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/a/b", COAP_GET, NULL, NULL },
+        { "/a/b", COAP_PUT, NULL, NULL },
+        { "/a/c", COAP_GET, NULL, NULL },
+        { "/b", COAP_POST, NULL, NULL },
+        { "/c", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/d/e", COAP_GET, NULL, NULL },
+    };
+    static const struct {
+        const char *uri;
+        coap_method_flags_t method;
+        int exp_res;
+        int exp_idx;
+    } cases[] = {
+        { "/a", COAP_GET, 0, 0 },
+        /* subtree resource comes first */
+        { "/a/b", COAP_GET, 0, 1 },
+        { "/a/b", COAP_PUT, 0, 3 },
+        { "/a/zzz", COAP_GET, 0, 1 },
+        { "/a/", COAP_GET, 0, 1 },
+        { "/b", COAP_GET, -ENOTSUP, -1 },
+        { "/b", COAP_POST, 0, 5 },
+        { "/c", COAP_GET, 0, 6 },
+        { "/c/x/y", COAP_GET, 0, 6 },
+        { "/cx", COAP_GET, 0, 6 },
+        { "/c/x/y", COAP_PUT, -ENOTSUP, -1 },
+        { "/ab", COAP_GET, -ENOENT, -1 },
+        { "/d", COAP_GET, -ENOENT, -1 },
+        { "/d/e/f", COAP_GET, -ENOENT, -1 },
+        { "/", COAP_GET, -ENOENT, -1 },
+        { "/z", COAP_GET, -ENOENT, -1 },
+    };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(cases); i++) {
+        const coap_resource_t *resource = NULL;
+        int res = coap_find_resource(resources, ARRAY_SIZE(resources),
+                                     (const uint8_t *)cases[i].uri,
+                                     cases[i].method, &resource);
+
+        TEST_ASSERT_EQUAL_INT(cases[i].exp_res, res);
+        if (cases[i].exp_idx < 0) {
+            TEST_ASSERT_NULL(resource);
+        }
+        else {
+            TEST_ASSERT(&resources[cases[i].exp_idx] == resource);
+        }
+    }
+    /* empty resource array */
+    const coap_resource_t *resource = NULL;
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(NULL, 0,
+                                                      (const uint8_t *)"/a",
+                                                      COAP_GET, &resource));
+    TEST_ASSERT_NULL(resource);
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -667,6 +732,7 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__server_reply_simple_con),
         new_TestFixture(test_nanocoap__server_option_count_overflow_check),
         new_TestFixture(test_nanocoap__server_option_count_overflow),
+        new_TestFixture(test_nanocoap__find_resource),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "kernel_defines.h"
+#include "suit/unpack.h"
+
+#include "tests-suit_unpack.h"
+
+static const uint8_t _src[] = {
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b,
+    0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
+    0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62, 0x63,
+    0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f,
+};
+
+/* _src[0:20] with two bytes changed, "RIOT" and _src[30:42] with the last
+ * byte cleared */
+static const uint8_t _new[] = {
+    0x40, 0x41, 0x42, 0x52, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b,
+    0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x53, 0x52, 0x53, 0x52, 0x49, 0x4f, 0x54,
+    0x5e, 0x5f, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x00,
+};
+
+/* two blocks: diff 20 + extra 4 + seek 10, diff 12 + seek -50 */
+static const uint8_t _patch[] = {
+    0x45, 0x4e, 0x44, 0x53, 0x4c, 0x45, 0x59, 0x2f, 0x42, 0x53, 0x44, 0x49,
+    0x46, 0x46, 0x34, 0x33, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x52, 0x49, 0x4f, 0x54,
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x97,
+};
+
+/* "abcabcabc": three literals and a back-reference of 6 bytes at distance 3 */
+static const uint8_t _compressed[] = { 0xb0, 0xd8, 0xac, 0x60, 0x25 };
+
+static suit_unpack_t _unpack;
+static uint8_t _out[128];
+static size_t _out_len;
+static unsigned _last_calls;
+
+static int _sink(void *arg, size_t offset, const uint8_t *buf, size_t len,
+                 bool more)
+{
+    (void)arg;
+    if ((offset != _out_len) || (_out_len + len > sizeof(_out))) {
+        return -EINVAL;
+    }
+    memcpy(_out + _out_len, buf, len);
+    _out_len += len;
+    if (!more) {
+        _last_calls++;
+    }
+    return 0;
+}
+
+/* feeds buf in chunks of chunk bytes */
+static int _feed(const uint8_t *buf, size_t len, size_t chunk)
+{
+    size_t offset = 0;
+
+    while (offset < len) {
+        size_t n = (len - offset < chunk) ? len - offset : chunk;
+        int res = suit_unpack_putbytes(&_unpack, offset, buf + offset, n,
+                                       offset + n < len);
+        if (res < 0) {
+            return res;
+        }
+        offset += n;
+    }
+    return 0;
+}
+
+static void set_up(void)
+{
+    memset(_out, 0, sizeof(_out));
+    _out_len = 0;
+    _last_calls = 0;
+}
+
+static void test_suit_unpack_passthrough(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, suit_unpack_init(&_unpack, SUIT_COMPRESSION_NONE,
+                                              SUIT_UNPACK_NONE, NULL, 0,
+                                              _sink, NULL));
+    TEST_ASSERT_EQUAL_INT(0, _feed(_src, sizeof(_src), 7));
+    TEST_ASSERT_EQUAL_INT(sizeof(_src), _out_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_src, _out, sizeof(_src)));
+    TEST_ASSERT_EQUAL_INT(1, _last_calls);
+}
+
+static void test_suit_unpack_wrong_offset(void)
+{
+    suit_unpack_init(&_unpack, SUIT_COMPRESSION_NONE, SUIT_UNPACK_NONE,
+                     NULL, 0, _sink, NULL);
+    TEST_ASSERT_EQUAL_INT(0, suit_unpack_putbytes(&_unpack, 0, _src, 8, true));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, suit_unpack_putbytes(&_unpack, 16, _src, 8,
+                                                        true));
+}
+
+static void test_suit_unpack_unsupported(void)
+{
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, suit_unpack_init(&_unpack, 1,
+                                                     SUIT_UNPACK_NONE,
+                                                     NULL, 0, _sink, NULL));
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, suit_unpack_init(&_unpack,
+                                                     SUIT_COMPRESSION_NONE, 2,
+                                                     NULL, 0, _sink, NULL));
+}
+
+static void test_suit_unpack_delta(void)
+{
+    /* feed in chunks that split the header, control blocks and data */
+    static const size_t chunks[] = { 1, 5, 23, sizeof(_patch) };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(chunks); i++) {
+        set_up();
+        TEST_ASSERT_EQUAL_INT(0, suit_unpack_init(&_unpack,
+                                                  SUIT_COMPRESSION_NONE,
+                                                  SUIT_UNPACK_DELTA,
+                                                  _src, sizeof(_src),
+                                                  _sink, NULL));
+        TEST_ASSERT_EQUAL_INT(0, _feed(_patch, sizeof(_patch), chunks[i]));
+        TEST_ASSERT_EQUAL_INT(sizeof(_new), _out_len);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(_new, _out, sizeof(_new)));
+        TEST_ASSERT_EQUAL_INT(1, _last_calls);
+    }
+}
+
+static void test_suit_unpack_delta_truncated(void)
+{
+    suit_unpack_init(&_unpack, SUIT_COMPRESSION_NONE, SUIT_UNPACK_DELTA,
+                     _src, sizeof(_src), _sink, NULL);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, _feed(_patch, sizeof(_patch) - 1, 16));
+    TEST_ASSERT_EQUAL_INT(0, _last_calls);
+}
+
+static void test_suit_unpack_delta_corrupt(void)
+{
+    uint8_t patch[sizeof(_patch)];
+
+    /* the first block is longer than the new image */
+    memcpy(patch, _patch, sizeof(patch));
+    patch[24] = 0x30;
+    suit_unpack_init(&_unpack, SUIT_COMPRESSION_NONE, SUIT_UNPACK_DELTA,
+                     _src, sizeof(_src), _sink, NULL);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, _feed(patch, sizeof(patch), 16));
+
+    /* wrong magic */
+    memcpy(patch, _patch, sizeof(patch));
+    patch[0] = 'X';
+    suit_unpack_init(&_unpack, SUIT_COMPRESSION_NONE, SUIT_UNPACK_DELTA,
+                     _src, sizeof(_src), _sink, NULL);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, _feed(patch, sizeof(patch), 16));
+}
+
+static void test_suit_unpack_heatshrink(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, suit_unpack_init(&_unpack,
+                                              SUIT_COMPRESSION_HEATSHRINK,
+                                              SUIT_UNPACK_NONE, NULL, 0,
+                                              _sink, NULL));
+    TEST_ASSERT_EQUAL_INT(0, _feed(_compressed, sizeof(_compressed), 2));
+    TEST_ASSERT_EQUAL_INT(9, _out_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp("abcabcabc", _out, 9));
+    TEST_ASSERT_EQUAL_INT(1, _last_calls);
+}
+
+Test *tests_suit_unpack_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_suit_unpack_passthrough),
+        new_TestFixture(test_suit_unpack_wrong_offset),
+        new_TestFixture(test_suit_unpack_unsupported),
+        new_TestFixture(test_suit_unpack_delta),
+        new_TestFixture(test_suit_unpack_delta_truncated),
+        new_TestFixture(test_suit_unpack_delta_corrupt),
+        new_TestFixture(test_suit_unpack_heatshrink),
+    };
+
+    EMB_UNIT_TESTCALLER(suit_unpack_tests, set_up, NULL, fixtures);
+
+    return (Test *)&suit_unpack_tests;
+}
+
+void tests_suit_unpack(void)
+{
+    TESTS_RUN(tests_suit_unpack_tests());
+}
+/** @} */